@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include "feature_selection/binary_dataset.h"
+#include "feature_selection/data_loader.h"
+#include "synthetic_data.h"
+#include <filesystem>
+#include <map>
+
+using namespace feature_selection;
+using namespace feature_selection::bench;
+
+namespace {
+
+// Args: rows, features
+const std::vector<std::vector<int64_t>> kLoadShapes = {{1000, 10000, 100000}, {10, 100}};
+
+void reportShape(benchmark::State& state, const std::string& path) {
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path))
+    );
+    state.counters["rows"] = static_cast<double>(state.range(0));
+    state.counters["features"] = static_cast<double>(state.range(1));
+}
+
+// makeDataset(rows, cols) as a BinaryDataset file, once per shape
+const std::string& binaryDataset(std::size_t rows, std::size_t cols) {
+    static std::map<std::pair<std::size_t, std::size_t>, std::string> paths;
+    auto it = paths.find({rows, cols});
+    if (it == paths.end()) {
+        const std::string path = TempFiles::instance().add(
+            "fs_bench_" + std::to_string(rows) + "x" + std::to_string(cols) + ".fsbin"
+        );
+        const SyntheticDataset& dataset = cachedDataset(rows, cols);
+        BinaryDataset::write(path, dataset.data, dataset.labels);
+        it = paths.emplace(std::make_pair(rows, cols), path).first;
+    }
+    return it->second;
+}
+
+} // namespace
+
+// Parse the text format (no binary cache)
+static void BM_LoadText(benchmark::State& state) {
+    const std::string& path = textDataset(state.range(0), state.range(1));
+    for (auto _ : state) {
+        auto [data, labels] = DataLoader::loadDataset(path);
+        benchmark::DoNotOptimize(data.rowData(0));
+    }
+    reportShape(state, path);
+}
+BENCHMARK(BM_LoadText)
+    ->ArgsProduct(kLoadShapes)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Map and copy a BinaryDataset file, checksum included
+static void BM_LoadBinary(benchmark::State& state) {
+    const std::string& path = binaryDataset(state.range(0), state.range(1));
+    for (auto _ : state) {
+        auto [data, labels] = DataLoader::loadDataset(path);
+        benchmark::DoNotOptimize(data.rowData(0));
+    }
+    reportShape(state, path);
+}
+BENCHMARK(BM_LoadBinary)
+    ->ArgsProduct(kLoadShapes)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,24 @@
+#include <benchmark/benchmark.h>
+#include "feature_selection/distance_kernels.h"
+#include "feature_selection/metrics.h"
+#include <string>
+#include <omp.h>
+
+using namespace feature_selection;
+
+// Like BENCHMARK_MAIN, plus the build and machine settings that decide
+// whether two result files can be compared
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    
+    benchmark::AddCustomContext("simd_level", DistanceKernels::levelName(DistanceKernels::activeLevel()));
+    benchmark::AddCustomContext("omp_max_threads", std::to_string(omp_get_max_threads()));
+    benchmark::AddCustomContext("metrics", Metrics::enabled() ? "on" : "off");
+    
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include "feature_selection/nearest_neighbor.h"
+#include "synthetic_data.h"
+
+using namespace feature_selection;
+using namespace feature_selection::bench;
+
+namespace {
+
+// Rows cycled through as queries so no result is loop invariant
+constexpr std::size_t kQueryRows = 64;
+
+// The first `count` features, or the empty set (all features) for 0
+FeatureSet firstFeatures(std::size_t count) {
+    FeatureSet features;
+    for (FeatureIndex f = 0; f < count; ++f) {
+        features.insert(f);
+    }
+    return features;
+}
+
+} // namespace
+
+// Args: features, features compared (0 = all)
+static void BM_CalculateDistance(benchmark::State& state) {
+    const SyntheticDataset& dataset = cachedDataset(kQueryRows + 1, state.range(0));
+    const FeatureSet subset = firstFeatures(state.range(1));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NearestNeighbor::calculateDistance(dataset.data[i], dataset.data[i + 1], subset));
+        i = (i + 1) % kQueryRows;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CalculateDistance)->ArgsProduct({{8, 64, 512}, {0, 4}});
+
+// Args: rows, features, features compared (0 = all); items are distances
+static void BM_FindNearestNeighbor(benchmark::State& state) {
+    const SyntheticDataset& dataset = cachedDataset(state.range(0), state.range(1));
+    const FeatureSet subset = firstFeatures(state.range(2));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NearestNeighbor::findNearestNeighbor(dataset.data, dataset.data[i], i, subset));
+        i = (i + 1) % kQueryRows;
+    }
+    state.SetItemsProcessed(state.iterations() * (state.range(0) - 1));
+}
+BENCHMARK(BM_FindNearestNeighbor)
+    ->ArgsProduct({{1000, 10000}, {10, 100}, {0, 4}})
+    ->Unit(benchmark::kMicrosecond);
+
+// One full leave-one-out evaluation of a subset. Args: rows, subset size of
+// 50 features; items are query-reference pairs
+static void BM_LeaveOneOut(benchmark::State& state) {
+    const SyntheticDataset& dataset = cachedDataset(state.range(0), 50);
+    const FeatureSet subset = firstFeatures(state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(NearestNeighbor::leaveOneOutCrossValidation(dataset.data, dataset.labels, subset));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * (state.range(0) - 1));
+}
+BENCHMARK(BM_LeaveOneOut)
+    ->ArgsProduct({{500, 2000, 8000}, {1, 3, 10, 50}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include "feature_selection/feature_selection.h"
+#include "feature_selection/metrics.h"
+#include "synthetic_data.h"
+#include <map>
+#include <tuple>
+
+using namespace feature_selection;
+using namespace feature_selection::bench;
+
+namespace {
+
+// Features already selected when a forward level is measured; the first
+// level is the sorted sweep, not the general engine
+constexpr std::size_t kForwardDepth = 2;
+
+// A forward search stopped after kForwardDepth levels, saved once per shape
+const std::string& forwardCheckpoint(std::size_t rows, std::size_t cols) {
+    static std::map<std::pair<std::size_t, std::size_t>, std::string> paths;
+    auto it = paths.find({rows, cols});
+    if (it == paths.end()) {
+        const std::string path = TempFiles::instance().add(
+            "fs_bench_" + std::to_string(rows) + "x" + std::to_string(cols) + ".ckpt"
+        );
+        const SyntheticDataset& dataset = cachedDataset(rows, cols);
+        SearchOptions options;
+        options.distanceCacheBudget = 0;
+        options.maxLevels = kForwardDepth;
+        options.checkpointPath = path;
+        QuietOutput quiet;
+        FeatureSelection::forwardSelection(dataset.data, dataset.labels, false, options);
+        it = paths.emplace(std::make_pair(rows, cols), path).first;
+    }
+    return it->second;
+}
+
+} // namespace
+
+// One forward level (level kForwardDepth + 1) scored by the block-parallel
+// engine, resumed from a checkpoint. Resuming reads the checkpoint and
+// hashes the dataset before the level starts, so each iteration is timed by
+// the search's own level timer. Args: rows, features
+static void BM_ForwardLevel(benchmark::State& state) {
+    if (!Metrics::enabled()) {
+        state.SkipWithError("needs FEATURE_SELECTION_METRICS for the level timer");
+        return;
+    }
+    const std::size_t rows = state.range(0);
+    const std::size_t cols = state.range(1);
+    const SyntheticDataset& dataset = cachedDataset(rows, cols);
+    
+    // The interval is longer than the search, so the checkpoint is only read
+    SearchOptions options;
+    options.distanceCacheBudget = 0;
+    options.checkpointPath = forwardCheckpoint(rows, cols);
+    options.checkpointInterval = cols + 1;
+    options.resume = true;
+    options.maxLevels = 1;
+    
+    QuietOutput quiet;
+    for (auto _ : state) {
+        Metrics::reset();
+        SearchResult result = FeatureSelection::forwardSelection(dataset.data, dataset.labels, false, options);
+        benchmark::DoNotOptimize(result.bestAccuracy);
+        state.SetIterationTime(Metrics::snapshot().levels.back().seconds);
+    }
+    state.counters["candidates"] = static_cast<double>(cols - kForwardDepth);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(cols - kForwardDepth));
+}
+BENCHMARK(BM_ForwardLevel)
+    ->ArgsProduct({{500, 2000}, {20, 100}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+// The first backward level, every feature removed in turn. Args: rows,
+// features, distance cache (0 = block-parallel engine, 1 = cached distances)
+static void BM_BackwardLevel(benchmark::State& state) {
+    const std::size_t rows = state.range(0);
+    const std::size_t cols = state.range(1);
+    const SyntheticDataset& dataset = cachedDataset(rows, cols);
+    
+    SearchOptions options;
+    if (state.range(2) == 0) {
+        options.distanceCacheBudget = 0;
+    }
+    options.maxLevels = 1;
+    
+    QuietOutput quiet;
+    for (auto _ : state) {
+        SearchResult result = FeatureSelection::backwardElimination(dataset.data, dataset.labels, false, options);
+        benchmark::DoNotOptimize(result.bestAccuracy);
+    }
+    state.counters["candidates"] = static_cast<double>(cols);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(cols));
+}
+BENCHMARK(BM_BackwardLevel)
+    ->ArgsProduct({{500, 2000}, {20, 100}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
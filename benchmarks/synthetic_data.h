@@ -0,0 +1,142 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace feature_selection {
+namespace bench {
+
+/**
+ * @brief A generated dataset held in memory
+ */
+struct SyntheticDataset {
+    DataMatrix data;
+    LabelVector labels;
+};
+
+/**
+ * @brief Generate a two-class dataset
+ *
+ * Classes 1 and 2 alternate by row. The first `informative` features are
+ * offset by class, so searches have something to find; the rest are noise.
+ * The same shape and seed always give the same values.
+ */
+inline SyntheticDataset makeDataset(
+    std::size_t rows,
+    std::size_t cols,
+    std::uint64_t seed = 1,
+    std::size_t informative = 2
+) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    
+    SyntheticDataset dataset;
+    dataset.data = DataMatrix(rows, cols);
+    dataset.labels.resize(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        const Label label = (i % 2 == 0) ? 1 : 2;
+        dataset.labels[i] = label;
+        double* values = dataset.data.mutableRowData(i);
+        for (std::size_t j = 0; j < cols; ++j) {
+            const double offset = j < informative ? (label == 1 ? -1.5 : 1.5) : 0.0;
+            values[j] = offset + 2.0 * noise(rng);
+        }
+    }
+    dataset.data.syncColumnsFromRows();
+    return dataset;
+}
+
+/**
+ * @brief Generated datasets of one process, built once per shape
+ */
+inline const SyntheticDataset& cachedDataset(std::size_t rows, std::size_t cols) {
+    static std::map<std::pair<std::size_t, std::size_t>, SyntheticDataset> datasets;
+    auto it = datasets.find({rows, cols});
+    if (it == datasets.end()) {
+        it = datasets.emplace(std::make_pair(rows, cols), makeDataset(rows, cols)).first;
+    }
+    return it->second;
+}
+
+/**
+ * @brief Temporary files of one process, removed when it exits
+ */
+class TempFiles {
+public:
+    ~TempFiles() {
+        for (const auto& path : paths_) {
+            std::remove(path.c_str());
+        }
+    }
+    
+    std::string add(const std::string& name) {
+        paths_.push_back((std::filesystem::temp_directory_path() / name).string());
+        return paths_.back();
+    }
+    
+    static TempFiles& instance() {
+        static TempFiles files;
+        return files;
+    }
+    
+private:
+    std::vector<std::string> paths_;
+};
+
+/**
+ * @brief makeDataset(rows, cols) written in the text format, once per shape
+ * @return Path of the file
+ */
+inline const std::string& textDataset(std::size_t rows, std::size_t cols) {
+    static std::map<std::pair<std::size_t, std::size_t>, std::string> paths;
+    auto it = paths.find({rows, cols});
+    if (it != paths.end()) {
+        return it->second;
+    }
+    
+    const std::string path = TempFiles::instance().add(
+        "fs_bench_" + std::to_string(rows) + "x" + std::to_string(cols) + ".txt"
+    );
+    const SyntheticDataset& dataset = cachedDataset(rows, cols);
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not create benchmark dataset: " + path);
+    }
+    file.precision(17);
+    for (std::size_t i = 0; i < rows; ++i) {
+        file << dataset.labels[i];
+        for (std::size_t j = 0; j < cols; ++j) {
+            file << ' ' << dataset.data.at(i, j);
+        }
+        file << '\n';
+    }
+    return paths.emplace(std::make_pair(rows, cols), path).first->second;
+}
+
+/**
+ * @brief Silences std::cout for its lifetime (the searches always print their Timer)
+ */
+class QuietOutput {
+public:
+    QuietOutput() : saved_(std::cout.rdbuf(nullptr)) {}
+    ~QuietOutput() { std::cout.rdbuf(saved_); }
+    
+    QuietOutput(const QuietOutput&) = delete;
+    QuietOutput& operator=(const QuietOutput&) = delete;
+    
+private:
+    std::streambuf* saved_;
+};
+
+} // namespace bench
+} // namespace feature_selection
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "feature_selection/mapped_file.h"
+#include "feature_selection/normalization.h"
+#include "feature_selection/utils.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace feature_selection {
+
+/**
+ * @brief Versioned binary dataset file, read through a memory mapping
+ *
+ * Layout (native little-endian, every section 64-byte aligned):
+ *   - BinaryDatasetHeader
+ *   - label table: labelCount distinct labels as int32
+ *   - row labels: one uint32 index into the label table per row
+ *   - normalization (if any): cols centers, then cols scales, as float64
+ *   - column blocks: cols blocks of columnStride float64 values, zero padded
+ *
+ * The header records the source text file's size and modification time so
+ * a stale cache can be detected, and a checksum of everything after the
+ * header so a truncated or corrupted file is rejected. Normalized datasets
+ * store the normalized values together with the parameters that produced
+ * them, so loading them needs no statistics pass.
+ */
+class BinaryDataset {
+public:
+    static constexpr std::uint32_t kVersion = 2;
+    static constexpr std::uint32_t kDTypeFloat64 = 0;
+    static constexpr std::size_t kSectionAlignment = 64;
+
+    /**
+     * @brief Fixed-size file header
+     */
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianMarker;
+        std::uint32_t dtype;
+        std::uint32_t normalization;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t columnStride;
+        std::uint64_t labelCount;
+        std::uint64_t labelTableOffset;
+        std::uint64_t rowLabelOffset;
+        std::uint64_t normalizationOffset;
+        std::uint64_t dataOffset;
+        std::uint64_t fileSize;
+        std::uint64_t sourceSize;
+        std::int64_t sourceModified;
+        std::uint64_t payloadChecksum;
+        std::uint64_t headerChecksum;
+    };
+
+    /**
+     * @brief Map and validate a binary dataset file
+     * @param path File to open
+     * @param verifyChecksum Also verify the payload checksum (reads the whole file)
+     * @throws std::runtime_error if the file is not a valid dataset of this version
+     */
+    explicit BinaryDataset(const std::string& path, bool verifyChecksum = true);
+
+    /**
+     * @brief Write a dataset in binary form (via a temporary file and rename)
+     * @param path Destination file
+     * @param data Feature matrix
+     * @param labels Class label of each row
+     * @param sourceSize Size of the text file the data came from (0 if none)
+     * @param sourceModified Modification time of that text file (0 if none)
+     * @param normalization Parameters already applied to data, if any
+     */
+    static void write(
+        const std::string& path,
+        const DataMatrix& data,
+        const LabelVector& labels,
+        std::uint64_t sourceSize = 0,
+        std::int64_t sourceModified = 0,
+        const NormalizationParams& normalization = NormalizationParams()
+    );
+
+    /**
+     * @brief The 64-bit hash used for the file checksums
+     */
+    static std::uint64_t checksum(const char* data, std::size_t size);
+
+    /**
+     * @brief Temporary file a writer fills before renaming it over `path`
+     *
+     * Unique per process and call (".tmp.<pid>.<n>"), so concurrent writers
+     * of the same file never share a temporary; the last rename wins.
+     */
+    static std::string temporaryPath(const std::string& path);
+
+    /**
+     * @brief Check whether a file starts with the binary dataset magic
+     */
+    static bool isBinaryDataset(const std::string& path);
+
+    /**
+     * @brief Format version a binary dataset was written with
+     *
+     * Lets a cache written by an older format be treated as a miss instead
+     * of an error.
+     * @return The header's version, or 0 if the file is not a binary dataset
+     */
+    static std::uint32_t fileVersion(const std::string& path);
+
+    std::size_t rows() const { return static_cast<std::size_t>(header_.rows); }
+    std::size_t cols() const { return static_cast<std::size_t>(header_.cols); }
+    std::size_t columnStride() const { return static_cast<std::size_t>(header_.columnStride); }
+    std::uint64_t sourceSize() const { return header_.sourceSize; }
+    std::int64_t sourceModified() const { return header_.sourceModified; }
+    std::uint64_t payloadChecksum() const { return header_.payloadChecksum; }
+
+    /**
+     * @brief Column j of the features, read straight from the mapping
+     */
+    const double* columnData(std::size_t j) const {
+        return reinterpret_cast<const double*>(file_.data() + header_.dataOffset) + j * header_.columnStride;
+    }
+
+    NormalizationMethod normalizationMethod() const {
+        return static_cast<NormalizationMethod>(header_.normalization);
+    }
+
+    /**
+     * @brief Parameters the stored values were normalized with
+     */
+    NormalizationParams normalization() const;
+
+    /**
+     * @brief Decode the per-row labels
+     */
+    LabelVector labels() const;
+
+    /**
+     * @brief Copy the mapped columns into an in-memory FeatureMatrix
+     *
+     * FeatureMatrix owns both of its views, so this reads every mapped
+     * column once, copies it (one column per thread) and transposes the
+     * copy into the row view: O(rows * cols) work and twice the payload in
+     * memory, on top of the mapping. Out-of-core callers should read
+     * columnData() directly instead, as StreamingEvaluator and
+     * DataLoader::loadCompactDataset do.
+     */
+    DataMatrix toMatrix() const;
+
+private:
+    MappedFile file_;
+    Header header_;
+};
+
+/**
+ * @brief Writes a BinaryDataset file one block of rows at a time
+ *
+ * The labels are needed up front to lay out the file. Feature rows then
+ * arrive as consecutive blocks, and each block is written as one segment
+ * per column at its final offset, so only the current block is in memory.
+ * finish() hashes the payload back from the file, writes the header and
+ * renames the temporary file into place; a writer destroyed before that
+ * removes it. The result is identical to BinaryDataset::write (without
+ * normalization).
+ */
+class BinaryDatasetWriter {
+public:
+    /**
+     * @param path Destination file
+     * @param labels Class label of every row of the dataset
+     * @param cols Number of features
+     * @param sourceSize Size of the text file the data comes from (0 if none)
+     * @param sourceModified Modification time of that text file (0 if none)
+     * @throws std::runtime_error if the temporary file cannot be created
+     */
+    BinaryDatasetWriter(
+        const std::string& path,
+        const LabelVector& labels,
+        std::size_t cols,
+        std::uint64_t sourceSize = 0,
+        std::int64_t sourceModified = 0
+    );
+    ~BinaryDatasetWriter();
+
+    BinaryDatasetWriter(const BinaryDatasetWriter&) = delete;
+    BinaryDatasetWriter& operator=(const BinaryDatasetWriter&) = delete;
+
+    /**
+     * @brief Write the next block.rows() rows
+     * @throws std::runtime_error on a column count mismatch, more rows than labels, or a write error
+     */
+    void append(const DataMatrix& block);
+
+    /**
+     * @brief Complete the file once every row is written
+     * @throws std::runtime_error if rows are missing or the file cannot be completed
+     */
+    void finish();
+
+    std::size_t rowsWritten() const { return rowsWritten_; }
+
+private:
+    std::string path_;
+    std::string tempPath_;
+    BinaryDataset::Header header_ {};
+    std::fstream file_;
+    std::size_t rowsWritten_ = 0;
+    bool finished_ = false;
+};
+
+} // namespace feature_selection
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief How well screening agreed with exact scoring over a search
+ */
+struct ScreeningStats {
+    // Search levels that were screened
+    std::size_t levels = 0;
+    
+    std::size_t candidatesScreened = 0;
+    std::size_t candidatesRescored = 0;
+    
+    // Levels where the top screened candidate was also the exact best
+    // of the re-scored candidates
+    std::size_t topAgreements = 0;
+    
+    // Sum of |screened - exact| accuracy over the re-scored candidates
+    double absoluteErrorSum = 0.0;
+    
+    // With auditing: levels checked, and how often the exact best of all
+    // candidates was among the re-scored ones
+    std::size_t auditedLevels = 0;
+    std::size_t auditHits = 0;
+    
+    double topAgreementRate() const {
+        return levels == 0 ? 0.0 : static_cast<double>(topAgreements) / static_cast<double>(levels);
+    }
+    
+    double meanAbsoluteError() const {
+        return candidatesRescored == 0 ? 0.0 : absoluteErrorSum / static_cast<double>(candidatesRescored);
+    }
+    
+    double auditRecall() const {
+        return auditedLevels == 0 ? 0.0 : static_cast<double>(auditHits) / static_cast<double>(auditedLevels);
+    }
+};
+
+/**
+ * @brief Cheap approximate candidate scoring on a stratified row sample
+ *
+ * Leave-one-out accuracy is computed within a fixed sample of the rows, so
+ * scoring a candidate costs O(m^2) instead of O(n^2) for a sample of m
+ * rows. The sample keeps each class's share of the rows. Screened scores
+ * are only used to rank candidates; the search re-scores the best few
+ * exactly before choosing one.
+ */
+class CandidateScreen {
+public:
+    /**
+     * @brief Draw the sample and copy its rows
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param sampleRows Rows to keep (at most all of them)
+     * @param seed Seed of the sampling generator
+     */
+    CandidateScreen(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        std::size_t sampleRows,
+        std::uint64_t seed
+    );
+    
+    /**
+     * @brief Leave-one-out accuracy of a subset within the sample
+     * @param features Ascending, in-range feature indices
+     * @param featureCount Number of indices
+     */
+    double score(const FeatureIndex* features, std::size_t featureCount) const;
+    
+    std::size_t sampleRows() const { return labels_.size(); }
+    const std::vector<std::size_t>& rows() const { return rows_; }
+    
+    /// The sampled rows, in the order of rows()
+    const DataMatrix& sample() const { return sample_; }
+    
+    /// Class labels of the sampled rows
+    const LabelVector& labels() const { return labels_; }
+    
+    /**
+     * @brief Ascending rows of a stratified sample
+     *
+     * Each class keeps its share of the rows (rounded, at least one row per
+     * class while the count allows); rows within a class are drawn uniformly.
+     * @param labels Class label of each row
+     * @param count Rows to draw
+     * @param seed Seed of the sampling generator
+     */
+    static std::vector<std::size_t> stratifiedRows(
+        const LabelVector& labels,
+        std::size_t count,
+        std::uint64_t seed
+    );
+    
+    /**
+     * @brief Slots of the k best scores, best first; ties go to the lower slot
+     */
+    static std::vector<std::size_t> topCandidates(
+        const std::vector<double>& scores,
+        std::size_t candidateCount,
+        std::size_t k
+    );
+
+private:
+    std::vector<std::size_t> rows_;
+    DataMatrix sample_;
+    LabelVector labels_;
+};
+
+} // namespace feature_selection
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Element type used to store feature values
+ */
+enum class StoragePrecision {
+    Float64,
+    Float32,
+    Int16,
+    Int8
+};
+
+/**
+ * @brief Leave-one-out accuracy of one subset on the double and compact paths
+ */
+struct PrecisionCheck {
+    FeatureSet subset;
+    double referenceAccuracy = 0.0;
+    double compactAccuracy = 0.0;
+    
+    double difference() const { return compactAccuracy - referenceAccuracy; }
+};
+
+/**
+ * @brief Column-major feature storage in reduced precision
+ *
+ * Float32 stores the values as float. Int16 and Int8 quantize each feature
+ * independently by min-max scaling onto 0..32767 or 0..255, so a value is
+ * recovered as offset(j) + scale(j) * q; squared distances are then
+ * sum_j scale(j)^2 * (qa - qb)^2. Integer differences are squared exactly
+ * in 32-bit lanes and accumulated in float.
+ *
+ * A row of k features costs 4, 2 or 1 bytes per feature instead of 8, so
+ * the bandwidth-bound leave-one-out search streams a half to an eighth of
+ * the data and larger working sets stay in cache. Distances are approximate,
+ * so neighbors (and accuracies) can differ from the double path; validate()
+ * reports by how much.
+ */
+class CompactMatrix {
+public:
+    CompactMatrix() = default;
+    
+    /**
+     * @brief Convert a dataset to reduced precision
+     * @param data The dataset
+     * @param precision Float32, Int16 or Int8
+     * @throws std::runtime_error for Float64, which needs no conversion
+     */
+    CompactMatrix(const DataMatrix& data, StoragePrecision precision);
+    
+    /**
+     * @brief Allocate zeroed storage to be filled column by column with setColumn()
+     * @throws std::runtime_error for Float64, which needs no conversion
+     */
+    CompactMatrix(std::size_t rows, std::size_t cols, StoragePrecision precision);
+    
+    /**
+     * @brief Convert (and for integer precisions quantize) feature j from doubles
+     *
+     * Distinct columns may be set from different threads.
+     * @param j Feature index below cols()
+     * @param column rows() values of the feature
+     */
+    void setColumn(std::size_t j, const double* column);
+    
+    StoragePrecision precision() const { return precision_; }
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t columnStride() const { return columnStride_; }
+    
+    /// Bytes of feature storage
+    std::size_t storageBytes() const;
+    
+    /// Quantization step of feature j (1 for Float32)
+    double scale(std::size_t j) const { return scales_[j]; }
+    
+    /// Value that quantized 0 stands for in feature j (0 for Float32)
+    double offset(std::size_t j) const { return offsets_[j]; }
+    
+    /**
+     * @brief Stored value of row i, feature j, converted back to double
+     */
+    double value(std::size_t i, std::size_t j) const;
+    
+    /**
+     * @brief Count correct leave-one-out predictions over a packed feature list
+     *
+     * Cache-blocked like TiledNearestNeighbor: query tiles against reference
+     * tiles of the compact columns, ties to the lowest row index.
+     * @param labels Class label of each row
+     * @param features In-range feature indices
+     * @param featureCount Number of indices
+     */
+    std::size_t leaveOneOutCorrect(
+        const LabelVector& labels,
+        const FeatureIndex* features,
+        std::size_t featureCount
+    ) const;
+    
+    /**
+     * @brief Same count restricted to queries [queryBegin, queryEnd)
+     *
+     * Runs on the calling thread; neighbors are still searched over all rows.
+     */
+    std::size_t leaveOneOutCorrect(
+        const LabelVector& labels,
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::size_t queryBegin,
+        std::size_t queryEnd
+    ) const;
+    
+    /**
+     * @brief Leave-one-out accuracy; an empty subset means all features
+     */
+    double leaveOneOutCrossValidation(const LabelVector& labels, const FeatureSet& featureSubset) const;
+    
+    /**
+     * @brief Compare leave-one-out accuracy against the double path
+     * @param data The dataset in double precision
+     * @param labels Class label of each row
+     * @param subsets Subsets to compare
+     * @return One check per subset
+     */
+    std::vector<PrecisionCheck> validate(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        const std::vector<FeatureSet>& subsets
+    ) const;
+    
+    static const char* precisionName(StoragePrecision precision);
+    
+    /**
+     * @brief Parse "float64", "float32", "int16" or "int8"
+     * @throws std::invalid_argument for any other name
+     */
+    static StoragePrecision parsePrecision(const std::string& name);
+
+private:
+    StoragePrecision precision_ = StoragePrecision::Float32;
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::size_t columnStride_ = 0;
+    
+    // Exactly one of these holds the columns, per precision_
+    std::vector<float> floats_;
+    std::vector<std::uint16_t> words_;
+    std::vector<std::uint8_t> bytes_;
+    
+    std::vector<double> scales_;
+    std::vector<double> offsets_;
+    
+    // scale(j)^2 as float, the per-feature weight of a squared difference
+    std::vector<float> weights_;
+};
+
+} // namespace feature_selection
@@ -1,11 +1,12 @@
 #pragma once
 
+#include "feature_selection/compact_matrix.h"
+#include "feature_selection/normalization.h"
 #include "feature_selection/utils.h"
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
-#include <fstream>
-#include <sstream>
 #include <future>
 #include <thread>
 #include <memory>
@@ -13,6 +14,52 @@
 
 namespace feature_selection {
 
+/**
+ * @brief Options for DataLoader::loadDataset
+ */
+struct LoadOptions {
+    // Reuse a binary copy of a text dataset when it is up to date, and write
+    // one after parsing the text when it is missing or stale
+    bool useBinaryCache = false;
+    
+    // Location of the binary copy; empty means defaultCachePath(), which
+    // gives every normalization method a file of its own
+    std::string cachePath;
+    
+    // Verify the checksum of binary files before using them
+    bool verifyChecksum = true;
+    
+    // Normalize the features after parsing. The binary cache then holds the
+    // normalized values and their parameters, and is reused only for the
+    // same method
+    NormalizationMethod normalization = NormalizationMethod::None;
+};
+
+/**
+ * @brief Path of a binary dataset resolved by DataLoader::binaryDatasetFor
+ *
+ * A private conversion made because the cache was disabled belongs to the
+ * handle and is removed when it is destroyed; caches and binary inputs are
+ * left alone.
+ */
+class BinaryDatasetFile {
+public:
+    BinaryDatasetFile(std::string path, bool temporary) : path_(std::move(path)), temporary_(temporary) {}
+    ~BinaryDatasetFile();
+    
+    BinaryDatasetFile(const BinaryDatasetFile&) = delete;
+    BinaryDatasetFile& operator=(const BinaryDatasetFile&) = delete;
+    BinaryDatasetFile(BinaryDatasetFile&& other) noexcept;
+    BinaryDatasetFile& operator=(BinaryDatasetFile&& other) = delete;
+    
+    const std::string& path() const { return path_; }
+    bool temporary() const { return temporary_; }
+
+private:
+    std::string path_;
+    bool temporary_;
+};
+
 /**
  * @brief Class for loading and manipulating datasets
  */
@@ -20,12 +67,85 @@ class DataLoader {
 public:
     /**
      * @brief Loads data from a file and returns feature matrix and label vector
-     * @param filename Path to the dataset file
+     * @param filename Path to the dataset file (text, or a BinaryDataset file)
+     * @param options Binary cache options
      * @return Tuple containing (data matrix, label vector)
      * 
-     * Format: First column is class label (1 or 2), remaining columns are features
+     * Text format: First column is class label (1 or 2), remaining columns are features
+     *
+     * Binary files and caches are mapped, but the result is still a full
+     * in-memory copy: BinaryDataset::toMatrix() copies every column and
+     * transposes it into the row view. Use loadCompactDataset or
+     * binaryDatasetFor with a StreamingEvaluator to avoid holding it.
+     */
+    static std::tuple<DataMatrix, LabelVector> loadDataset(
+        const std::string& filename,
+        const LoadOptions& options = LoadOptions()
+    );
+    
+    /**
+     * @brief Load a dataset straight into reduced-precision storage
+     *
+     * Text files go through binaryDatasetFor (the unnormalized cache, or a
+     * temporary file without one). The features are then normalized and
+     * converted one column per thread straight from the mapping, so memory
+     * holds the compact matrix and one double column per thread, never the
+     * full double matrix.
+     * @param filename Path to the dataset file (text, or a BinaryDataset file)
+     * @param precision Float32, Int16 or Int8
+     * @param options Binary cache options
+     * @return Tuple containing (compact matrix, label vector)
+     */
+    static std::tuple<CompactMatrix, LabelVector> loadCompactDataset(
+        const std::string& filename,
+        StoragePrecision precision,
+        const LoadOptions& options = LoadOptions()
+    );
+    
+    /**
+     * @brief Default location of the binary cache for a text dataset
+     *
+     * "<dataset>.fsbin" for the raw values, "<dataset>.<method>.fsbin" (e.g.
+     * ".zscore.fsbin") for normalized ones, so runs with different methods
+     * and streamed runs never overwrite each other's cache.
+     */
+    static std::string defaultCachePath(
+        const std::string& filename,
+        NormalizationMethod normalization = NormalizationMethod::None
+    );
+    
+    /**
+     * @brief Convert a text dataset to a BinaryDataset file without loading it whole
+     *
+     * A first pass reads only the labels. The features are then parsed about
+     * chunkBytes of text at a time and appended to the file as column
+     * segments, so memory holds one chunk rather than the whole matrix. The
+     * file is not normalized, and records the text file's size and time like
+     * a binary cache.
+     * @param filename Path to the text dataset
+     * @param binaryPath Destination file
+     * @param chunkBytes Text parsed per chunk
+     * @throws std::runtime_error on malformed input or if the file cannot be written
      */
-    static std::tuple<DataMatrix, LabelVector> loadDataset(const std::string& filename);
+    static void convertToBinary(
+        const std::string& filename,
+        const std::string& binaryPath,
+        std::size_t chunkBytes = std::size_t(64) << 20
+    );
+    
+    /**
+     * @brief A BinaryDataset file holding a dataset, for out-of-core evaluation
+     *
+     * Binary files are returned as they are. With options.useBinaryCache a
+     * text file's unnormalized cache is reused when it is up to date, and
+     * the text is converted with convertToBinary into the cache path when
+     * it is not. Without it the cache is neither read nor written: the text
+     * is converted into a temporary file owned by the returned handle.
+     * @param filename Path to the dataset file (text, or a BinaryDataset file)
+     * @param options Cache location and checksum options; normalization is ignored
+     * @return The binary file
+     */
+    static BinaryDatasetFile binaryDatasetFor(const std::string& filename, const LoadOptions& options = LoadOptions());
     
     /**
      * @brief Get the number of features in the dataset
@@ -52,46 +172,77 @@ public:
      * @brief Extract a subset of features from the data
      * @param data The full dataset
      * @param features The set of features to extract
-     * @return Data matrix containing only the selected features
+     * @return Data matrix containing only the selected features, in ascending index order
      */
     static DataMatrix extractFeatures(const DataMatrix& data, const FeatureSet& features);
 
 private:
     /**
-     * @brief Read a chunk of a file using the specified bounds
-     * @param filename File to read
-     * @param startPos Starting position in the file
-     * @param chunkSize Size of the chunk to read in bytes
-     * @return Vector of rows where each row contains the raw values (including label)
+     * @brief Parse a whitespace-separated text dataset
+     * @param filename Path to the text file
+     * @return Tuple containing (data matrix, label vector)
      */
-    static std::vector<std::vector<double>> readFileChunk(
-        const std::string& filename, 
-        size_t startPos, 
-        size_t chunkSize
-    );
+    static std::tuple<DataMatrix, LabelVector> parseTextFile(const std::string& filename);
     
     /**
-     * @brief Read a file concurrently using multiple threads
-     * @param filename File to read
-     * @return Vector of rows where each row contains the raw values (including label)
+     * @brief Parse a whitespace-separated text dataset held in memory
+     * @param begin Start of the text
+     * @param end End of the text
+     * @return Tuple containing (data matrix, label vector)
      */
-    static std::vector<std::vector<double>> readFileConcurrent(const std::string& filename);
+    static std::tuple<DataMatrix, LabelVector> parseText(const char* begin, const char* end);
     
     /**
-     * @brief Process raw data into features and labels
-     * @param rawData The raw data from the file (includes labels)
-     * @return Tuple containing (data matrix, label vector)
+     * @brief Parse only the label of every non-blank line
      */
-    static std::tuple<DataMatrix, LabelVector> processRawData(
-        const std::vector<std::vector<double>>& rawData
-    );
+    static LabelVector parseLabels(const char* begin, const char* end);
+    
+    /**
+     * @brief A line-aligned byte range of the input and the rows it holds
+     */
+    struct TextChunk {
+        const char* begin;
+        const char* end;
+        std::size_t firstRow;
+        std::size_t rowCount;
+    };
+    
+    /**
+     * @brief Split a buffer into line-aligned chunks of roughly equal size
+     * @param data Start of the file contents
+     * @param size Size of the file contents in bytes
+     * @param chunkCount Desired number of chunks
+     * @return Chunks that together cover the buffer; every chunk ends after a newline or at the end
+     */
+    static std::vector<TextChunk> splitIntoChunks(const char* data, std::size_t size, std::size_t chunkCount);
+    
+    /**
+     * @brief Count the non-blank lines in a byte range
+     */
+    static std::size_t countRows(const char* begin, const char* end);
+    
+    /**
+     * @brief Count the values on the first non-blank line of a byte range
+     */
+    static std::size_t countValuesInFirstRow(const char* begin, const char* end);
+    
+    /**
+     * @brief Parse a chunk straight into its rows of the final matrix
+     * @param chunk The chunk to parse; its firstRow must already be assigned
+     * @param data Destination matrix (row-major view is written)
+     * @param labels Destination label vector
+     * @throws std::runtime_error on malformed numbers or inconsistent rows
+     */
+    static void parseChunk(const TextChunk& chunk, DataMatrix& data, LabelVector& labels);
     
     /**
-     * @brief Verify dataset consistency (all rows have same number of features)
-     * @param data The dataset to check
-     * @return True if the dataset is consistent, false otherwise
+     * @brief Parse one number starting at pos
+     * @param pos First character of the number
+     * @param end End of the line
+     * @param value Receives the parsed number
+     * @return Pointer one past the number
      */
-    static bool verifyDatasetConsistency(const DataMatrix& data);
+    static const char* parseNumber(const char* pos, const char* end, double& value);
 };
 
 } // namespace feature_selection
\ No newline at end of file
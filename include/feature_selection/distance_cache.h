@@ -0,0 +1,125 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Cached n x n squared-distance matrix for incremental subset search
+ *
+ * Keeps the pairwise squared distances over the current feature set. A
+ * candidate that adds feature f is scored as D + (x_f - y_f)^2 in a single
+ * pass over D and column f, so evaluating a search level costs O(n^2 * F)
+ * instead of O(n^2 * |S| * F). The diagonal is held at +infinity so an
+ * instance is never its own neighbor.
+ *
+ * Removals work the same way in reverse: a candidate that drops feature f
+ * is scored as D - (x_f - y_f)^2. Because repeated subtraction accumulates
+ * rounding error, the matrix is recomputed exactly from the data after every
+ * refreshInterval() committed removals.
+ *
+ * Nearest neighbors follow NearestNeighbor::findNearestNeighbor: smallest
+ * squared distance, ties broken by the lowest row index.
+ */
+class DistanceCache {
+public:
+    /**
+     * @brief Create a cache over the empty feature set
+     * @param data The dataset; must outlive the cache
+     * @param labels Class label of each row; must outlive the cache
+     */
+    DistanceCache(const DataMatrix& data, const LabelVector& labels);
+    
+    /**
+     * @brief Recompute the cached distances exactly for a feature set
+     * @param features Features to include
+     */
+    void reset(const FeatureSet& features);
+    
+    /**
+     * @brief Count correct LOOCV predictions for each single-feature addition
+     * @param candidates Features to try adding to the current set
+     * @return Number of correctly classified instances per candidate
+     */
+    std::vector<std::size_t> evaluateAdditions(const std::vector<FeatureIndex>& candidates) const;
+    
+    /**
+     * @brief Add a feature's contribution to the cached distances
+     * @param feature Feature to add to the current set
+     */
+    void commitAddition(FeatureIndex feature);
+    
+    /**
+     * @brief Count correct LOOCV predictions for each single-feature removal
+     * @param candidates Features of the current set to try removing
+     * @return Number of correctly classified instances per candidate
+     */
+    std::vector<std::size_t> evaluateRemovals(const std::vector<FeatureIndex>& candidates) const;
+    
+    /**
+     * @brief Subtract a feature's contribution from the cached distances
+     *
+     * Every refreshInterval() removals the matrix is rebuilt exactly instead.
+     * @param feature Feature to remove from the current set
+     */
+    void commitRemoval(FeatureIndex feature);
+    
+    /**
+     * @brief Set how many removals may be applied before an exact recompute
+     * @param interval Number of removals; 0 recomputes on every removal
+     */
+    void setRefreshInterval(std::size_t interval) { refreshInterval_ = interval; }
+    std::size_t refreshInterval() const { return refreshInterval_; }
+    
+    /**
+     * @brief Count correct LOOCV predictions for the current set
+     */
+    std::size_t evaluateCurrent() const;
+    
+    const FeatureSet& features() const { return features_; }
+    std::size_t instanceCount() const { return rows_; }
+    
+    /// Cached squared distances, rows of a padded stride, for checkpointing
+    const std::vector<double>& distances() const { return distances_; }
+    
+    /// Removals applied since the last exact recompute
+    std::size_t removalsSinceRefresh() const { return removalsSinceRefresh_; }
+    
+    /**
+     * @brief Reinstate a state saved from distances() and removalsSinceRefresh()
+     * @throws std::runtime_error if the distances do not fit this dataset
+     */
+    void restore(const FeatureSet& features, std::vector<double> distances, std::size_t removalsSinceRefresh);
+    
+    /**
+     * @brief Memory needed by a cache over a given number of instances
+     */
+    static std::size_t requiredBytes(std::size_t instances);
+
+private:
+    // Nearest row to query i with an optional feature column added (sign +1)
+    // or removed (sign -1)
+    std::size_t nearestRow(std::size_t i, const double* column, double sign) const;
+    
+    // Correct predictions per candidate column, applied with the given sign
+    std::vector<std::size_t> evaluateCandidates(
+        const std::vector<FeatureIndex>& candidates,
+        double sign
+    ) const;
+    
+    // Add (sign +1) or subtract (sign -1) a feature column's contribution
+    void applyFeature(FeatureIndex feature, double sign);
+    
+    const DataMatrix& data_;
+    const LabelVector& labels_;
+    std::size_t rows_;
+    std::size_t stride_;
+    FeatureSet features_;
+    std::vector<double> distances_;
+    std::size_t refreshInterval_ = 16;
+    std::size_t removalsSinceRefresh_ = 0;
+};
+
+} // namespace feature_selection
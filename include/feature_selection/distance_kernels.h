@@ -0,0 +1,77 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+
+namespace feature_selection {
+
+/**
+ * @brief Vectorized squared-Euclidean distance kernels with runtime CPU dispatch
+ *
+ * The widest instruction set supported by the running CPU is detected once
+ * (AVX-512, then AVX2, then SSE2, then plain scalar code) and every call goes
+ * through the matching implementation. The kernels return squared distances;
+ * callers that only compare distances never need the square root.
+ *
+ * Results are bit-identical at every level: all of them sum the squared
+ * differences into the same eight interleaved partial sums, combine those in
+ * the same order and never fuse the multiply into the add, so the choice of
+ * instruction set can never change which neighbor wins a near-tie.
+ */
+class DistanceKernels {
+public:
+    enum class SimdLevel {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512
+    };
+    
+    /**
+     * @brief Squared distance between two contiguous vectors
+     * @param a First vector
+     * @param b Second vector
+     * @param count Number of values to compare
+     * @return Sum of squared differences
+     */
+    static double squaredDistance(const double* a, const double* b, std::size_t count);
+    
+    /**
+     * @brief Squared distance over a packed list of feature indices
+     * @param a First instance (full row)
+     * @param b Second instance (full row)
+     * @param indices Feature indices to compare; every index must be in range
+     * @param count Number of indices
+     * @return Sum of squared differences over the listed features
+     */
+    static double squaredDistanceIndexed(
+        const double* a,
+        const double* b,
+        const FeatureIndex* indices,
+        std::size_t count
+    );
+    
+    /**
+     * @brief Instruction set the kernels are currently dispatched to
+     */
+    static SimdLevel activeLevel();
+    
+    /**
+     * @brief Widest instruction set supported by this CPU and build
+     */
+    static SimdLevel detectLevel();
+    
+    /**
+     * @brief Force dispatch to a given level (clamped to what the CPU supports)
+     * @param level Requested instruction set
+     * @return The level actually selected
+     */
+    static SimdLevel setLevel(SimdLevel level);
+    
+    /**
+     * @brief Human readable name of an instruction set level
+     */
+    static const char* levelName(SimdLevel level);
+};
+
+} // namespace feature_selection
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "feature_selection/binary_dataset.h"
+#include "feature_selection/utils.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Work counters of a DistributedCoordinator
+ */
+struct DistributedStats {
+    std::size_t unitsSent = 0;      ///< (subset, row shard) units handed to workers
+    std::size_t unitsRequeued = 0;  ///< Units re-sent after their worker disconnected
+    std::size_t workersLost = 0;    ///< Workers that disconnected mid-search
+};
+
+/**
+ * @brief Worker process side of distributed leave-one-out evaluation
+ *
+ * A worker memory-maps the same binary dataset as the coordinator, connects
+ * to it, and answers "count correct predictions of this subset for queries
+ * [begin, end)" until it is told to stop. Neighbors are always searched over
+ * all rows, so shard counts add up to the exact whole-dataset count.
+ *
+ * Messages are frames of native 64-bit words (type, payload length, payload)
+ * over a stream socket, so the same protocol can later run over TCP.
+ */
+class DistributedWorker {
+public:
+    /**
+     * @brief Map the dataset the worker serves
+     * @throws std::runtime_error if it is not a valid binary dataset
+     */
+    explicit DistributedWorker(const std::string& datasetPath);
+
+    /**
+     * @brief Connect to a coordinator's Unix socket
+     * @return The connected socket
+     * @throws std::runtime_error if the connection fails
+     */
+    static int connect(const std::string& socketPath);
+
+    /**
+     * @brief Introduce the dataset and answer requests until shutdown or EOF
+     *
+     * Closes the socket before returning.
+     */
+    void serve(int socket) const;
+
+    /**
+     * @brief Correct predictions among queries [begin, end) of a subset
+     *
+     * Parallel over query tiles within the worker.
+     */
+    std::size_t countCorrect(
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::size_t begin,
+        std::size_t end
+    ) const;
+
+private:
+    BinaryDataset dataset_;
+    LabelVector labels_;
+};
+
+/**
+ * @brief Hands (subset × row shard) units to worker processes and sums the counts
+ *
+ * The coordinator listens on a Unix socket; workers are either spawned by
+ * it (spawnWorkers) or started separately and accepted (acceptWorkers).
+ * Each worker must have mapped the same dataset: rows, columns and payload
+ * checksum are compared on connect, and searches compare datasetHash() with
+ * the data they were given. A worker that disconnects mid-level, or sends
+ * nothing for resultTimeout() seconds while it has units outstanding, is
+ * dropped and its outstanding units are re-sent to the others. Sockets are close-on-exec, so
+ * spawned workers inherit none of the coordinator's connections.
+ */
+class DistributedCoordinator {
+public:
+    /// Units kept outstanding per worker so it never waits on the coordinator
+    static constexpr std::size_t kUnitsInFlight = 2;
+
+    /// Seconds to wait for workers to connect
+    static constexpr int kAcceptTimeoutSeconds = 30;
+
+    /// Default seconds a busy worker may go without answering before it is dropped
+    static constexpr int kResultTimeoutSeconds = 300;
+
+    /**
+     * @brief Listen on socketPath for workers serving datasetPath
+     * @throws std::runtime_error if the dataset or the socket cannot be opened
+     */
+    DistributedCoordinator(const std::string& socketPath, const std::string& datasetPath);
+
+    /**
+     * @brief Stop the workers, reap spawned processes and remove the socket
+     */
+    ~DistributedCoordinator();
+
+    DistributedCoordinator(const DistributedCoordinator&) = delete;
+    DistributedCoordinator& operator=(const DistributedCoordinator&) = delete;
+
+    /**
+     * @brief Start count worker processes on this machine and wait for them
+     * @param workerExecutable Path of the feature_selection_worker binary
+     * @param count Number of workers
+     */
+    void spawnWorkers(const std::string& workerExecutable, std::size_t count);
+
+    /**
+     * @brief Wait for count workers started elsewhere to connect
+     */
+    void acceptWorkers(std::size_t count);
+
+    /**
+     * @brief Adopt an already connected socket (e.g. one end of a socketpair)
+     * @throws std::runtime_error if the worker serves a different dataset
+     */
+    void addWorker(int socket);
+
+    /**
+     * @brief Correct leave-one-out predictions of each subset, computed by the workers
+     * @param subsets Ascending, in-range feature lists
+     * @throws std::runtime_error if every worker is lost
+     */
+    std::vector<std::size_t> countCorrect(const std::vector<std::vector<FeatureIndex>>& subsets);
+
+    std::size_t workerCount() const;
+
+    void setResultTimeout(int seconds) { resultTimeoutSeconds_ = seconds; }
+    int resultTimeout() const { return resultTimeoutSeconds_; }
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+
+    /// SearchCheckpoint::hashDataset of the workers' dataset, to match against the searched one
+    std::uint64_t datasetHash() const { return datasetHash_; }
+
+    const DistributedStats& stats() const { return stats_; }
+
+private:
+    struct Worker {
+        int socket = -1;
+        std::vector<std::size_t> outstanding;  ///< Unit ids sent and not yet answered
+        std::chrono::steady_clock::time_point lastProgress;  ///< Last answer, or first send while idle
+    };
+
+    std::string socketPath_;
+    std::string datasetPath_;
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::uint64_t checksum_ = 0;
+    std::uint64_t datasetHash_ = 0;
+    int listener_ = -1;
+    int resultTimeoutSeconds_ = kResultTimeoutSeconds;
+    std::vector<Worker> workers_;
+    std::vector<int> children_;
+    DistributedStats stats_;
+};
+
+} // namespace feature_selection
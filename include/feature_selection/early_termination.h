@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Counters describing how much scoring early termination skipped
+ */
+struct TerminationStats {
+    // Candidates scored under a bound
+    std::uint64_t candidates = 0;
+
+    // Candidates stopped before their last row block
+    std::uint64_t stopped = 0;
+
+    // Query rows actually scored
+    std::uint64_t rowsScored = 0;
+
+    // Query rows a search without termination would have scored
+    std::uint64_t rowsPossible = 0;
+
+    void merge(const TerminationStats& other) {
+        candidates += other.candidates;
+        stopped += other.stopped;
+        rowsScored += other.rowsScored;
+        rowsPossible += other.rowsPossible;
+    }
+
+    double stopRate() const {
+        return candidates == 0 ? 0.0 : static_cast<double>(stopped) / static_cast<double>(candidates);
+    }
+
+    double workFraction() const {
+        return rowsPossible == 0 ? 1.0 : static_cast<double>(rowsScored) / static_cast<double>(rowsPossible);
+    }
+};
+
+/**
+ * @brief Stops leave-one-out scoring of candidates that can no longer win
+ *
+ * Candidates are scored one block of query rows at a time. Once a candidate
+ * has made more errors than the best finished candidates of its batch allow,
+ * its correct count can only fall short of theirs, so it can neither be
+ * selected nor tie and its remaining blocks are skipped. Ties are always
+ * scored in full, so the selected subsets are exactly those of a search
+ * without termination.
+ *
+ * Blocks have a fixed size for the whole search and are visited in
+ * descending order of the errors seen in them so far, so the rows most
+ * often misclassified by earlier candidates come first and losing
+ * candidates reveal themselves early.
+ */
+class EarlyTermination {
+public:
+    /// Blocks each candidate's rows are split into, i.e. chances to stop it
+    static constexpr std::size_t kBlocksPerCandidate = 16;
+
+    /**
+     * @brief Shared threshold of one batch of candidates
+     *
+     * Thread-safe: units of the batch call record() concurrently.
+     */
+    class Level {
+    public:
+        /**
+         * @param rows Query rows per candidate
+         * @param candidates Candidates in the batch
+         * @param keep How many of the best candidates are needed (1 for a
+         *        greedy step, the width for a beam)
+         */
+        Level(std::size_t rows, std::size_t candidates, std::size_t keep);
+
+        /**
+         * @brief Count a correct total already known for a candidate of the
+         *        batch, e.g. one answered from the memo
+         */
+        void finish(std::size_t correct);
+
+        /**
+         * @brief Add one scored block of a candidate
+         */
+        void record(std::size_t candidate, std::size_t blockRows, std::size_t blockCorrect);
+
+        /// Whether the candidate's remaining blocks can be skipped: even with
+        /// every remaining row correct it would fall short of the threshold
+        bool stopped(std::size_t candidate) const {
+            return rows_ - errors_[candidate].load(std::memory_order_relaxed) < threshold();
+        }
+
+        /// Whether every block of the candidate was scored
+        bool complete(std::size_t candidate) const {
+            return scored_[candidate].load(std::memory_order_relaxed) == rows_;
+        }
+
+        std::size_t rowsScored(std::size_t candidate) const {
+            return scored_[candidate].load(std::memory_order_relaxed);
+        }
+
+        /// Correct count a candidate must still be able to reach
+        std::size_t threshold() const { return threshold_.load(std::memory_order_relaxed); }
+
+    private:
+        std::size_t rows_;
+        std::size_t keep_;
+        std::vector<std::atomic<std::size_t>> errors_;
+        std::vector<std::atomic<std::size_t>> scored_;
+        std::atomic<std::size_t> threshold_{0};
+
+        // Smallest of the `keep` best finished counts on top
+        std::mutex mutex_;
+        std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<std::size_t>> best_;
+    };
+
+    /**
+     * @param rows Query rows of the dataset
+     */
+    explicit EarlyTermination(std::size_t rows);
+
+    /// Rows per block; fixed for the search
+    std::size_t blockRows() const { return blockRows_; }
+
+    std::size_t blockCount() const { return errors_.size(); }
+
+    /**
+     * @brief Block indices in descending order of errors seen, ties by index
+     */
+    std::vector<std::size_t> blockOrder() const;
+
+    /**
+     * @brief Count a scored block's errors towards its position in blockOrder(); thread-safe
+     */
+    void addErrors(std::size_t block, std::size_t errors) {
+        errors_[block].fetch_add(errors, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add a finished batch to the counters
+     */
+    void countLevel(const Level& level, std::size_t candidates);
+
+    const TerminationStats& stats() const { return stats_; }
+
+private:
+    std::size_t rows_;
+    std::size_t blockRows_;
+    std::vector<std::atomic<std::uint64_t>> errors_;
+    TerminationStats stats_;
+};
+
+} // namespace feature_selection
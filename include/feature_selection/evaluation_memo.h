@@ -0,0 +1,146 @@
+#pragma once
+
+#include "feature_selection/feature_bitset.h"
+#include "feature_selection/utils.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Lookup counters of an EvaluationMemo
+ */
+struct MemoStats {
+    // Subsets looked up before scoring
+    std::uint64_t lookups = 0;
+
+    // Lookups answered from the memo
+    std::uint64_t hits = 0;
+
+    // Accuracies stored after scoring
+    std::uint64_t inserts = 0;
+
+    double hitRate() const {
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * @brief Exact leave-one-out accuracy of every feature subset scored so far
+ *
+ * Subsets are keyed by their FeatureBitset words, which are canonical for a
+ * fixed feature count, and spread by a hash of those words over kShards
+ * independently locked maps, so threads scoring different subsets rarely
+ * contend. One memo can be handed to every search over the same dataset
+ * (SearchOptions::memo) and saved to a file between runs.
+ *
+ * File layout (native little-endian, like BinaryDataset):
+ *   - Header
+ *   - entries records of (words 64-bit bitset words, float64 accuracy)
+ */
+class EvaluationMemo {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    /// Independently locked maps, picked by the top six bits of the key hash
+    static constexpr std::size_t kShards = 64;
+
+    /**
+     * @brief Fixed-size file header
+     */
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianMarker;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t datasetHash;
+        std::uint64_t words;
+        std::uint64_t entries;
+        std::uint64_t payloadChecksum;
+        std::uint64_t headerChecksum;
+    };
+
+    /**
+     * @brief Create an empty memo for subsets of this dataset's features
+     */
+    EvaluationMemo(const DataMatrix& data, const LabelVector& labels);
+
+    EvaluationMemo(const EvaluationMemo&) = delete;
+    EvaluationMemo& operator=(const EvaluationMemo&) = delete;
+
+    /**
+     * @brief Whether accuracies in this memo are valid for a dataset
+     */
+    bool matches(const DataMatrix& data, const LabelVector& labels) const;
+
+    /**
+     * @brief Look up a subset; thread-safe
+     * @param subset Subset of the memo's featureCount() features
+     * @param accuracy Set to the stored accuracy on a hit
+     * @return Whether the subset was found
+     */
+    bool lookup(const FeatureBitset& subset, double& accuracy) const;
+
+    /**
+     * @brief Store the accuracy of a subset; thread-safe
+     */
+    void insert(const FeatureBitset& subset, double accuracy);
+
+    /// Number of stored subsets
+    std::size_t size() const;
+
+    std::size_t featureCount() const { return cols_; }
+
+    /// Counters since construction
+    MemoStats stats() const;
+
+    /**
+     * @brief Write every stored subset to a file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Add the subsets stored in a file
+     * @throws std::runtime_error if the file is corrupted or belongs to
+     *         another dataset
+     */
+    void load(const std::string& path);
+
+private:
+    struct Key {
+        std::uint64_t hash;
+        std::vector<std::uint64_t> words;
+
+        bool operator==(const Key& other) const { return hash == other.hash && words == other.words; }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const { return static_cast<std::size_t>(key.hash); }
+    };
+
+    // Padded so neighbouring shard locks do not share a cache line
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<Key, double, KeyHash> entries;
+    };
+
+    static Key makeKey(const std::vector<std::uint64_t>& words);
+    Shard& shardOf(const Key& key) const { return shards_[key.hash >> 58]; }
+    void store(Key key, double accuracy);
+
+    std::size_t rows_;
+    std::size_t cols_;
+    std::uint64_t datasetHash_;
+    mutable std::vector<Shard> shards_;
+    mutable std::atomic<std::uint64_t> lookups_{0};
+    mutable std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> inserts_{0};
+};
+
+} // namespace feature_selection
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstdint>
+#include <vector>
+
+namespace feature_selection {
+
+namespace detail {
+
+inline std::size_t popcount64(std::uint64_t word) {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+    std::size_t total = 0;
+    for (; word != 0; word &= word - 1) {
+        ++total;
+    }
+    return total;
+#endif
+}
+
+inline std::size_t countTrailingZeros64(std::uint64_t word) {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+    std::size_t zeros = 0;
+    for (; (word & 1u) == 0; word >>= 1) {
+        ++zeros;
+    }
+    return zeros;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Fixed-capacity feature subset stored as a bitset
+ *
+ * Membership tests, inserts and erases are O(1) and never allocate once the
+ * bitset is constructed, which makes it the working set type of the search
+ * loops. Use toSet() to convert to the ordered FeatureSet used in results.
+ */
+class FeatureBitset {
+public:
+    FeatureBitset() = default;
+
+    /**
+     * @brief Create an empty subset of features [0, featureCount)
+     */
+    explicit FeatureBitset(std::size_t featureCount)
+        : featureCount_(featureCount), words_((featureCount + 63) / 64, 0) {}
+
+    /**
+     * @brief Create a subset holding the in-range members of a FeatureSet
+     */
+    FeatureBitset(std::size_t featureCount, const FeatureSet& features)
+        : FeatureBitset(featureCount) {
+        for (FeatureIndex feature : features) {
+            if (feature < featureCount_) {
+                insert(feature);
+            }
+        }
+    }
+
+    bool contains(FeatureIndex feature) const {
+        return (words_[feature >> 6] >> (feature & 63)) & 1u;
+    }
+
+    void insert(FeatureIndex feature) {
+        words_[feature >> 6] |= std::uint64_t(1) << (feature & 63);
+    }
+
+    void erase(FeatureIndex feature) {
+        words_[feature >> 6] &= ~(std::uint64_t(1) << (feature & 63));
+    }
+
+    std::size_t count() const {
+        std::size_t total = 0;
+        for (std::uint64_t word : words_) {
+            total += detail::popcount64(word);
+        }
+        return total;
+    }
+
+    bool empty() const {
+        for (std::uint64_t word : words_) {
+            if (word != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Number of features the bitset can hold
+    std::size_t capacity() const { return featureCount_; }
+
+    const std::vector<std::uint64_t>& words() const { return words_; }
+
+    /**
+     * @brief Write the members in ascending order into a caller-owned list
+     */
+    void toList(std::vector<FeatureIndex>& out) const {
+        out.clear();
+        for (std::size_t w = 0; w < words_.size(); ++w) {
+            std::uint64_t word = words_[w];
+            while (word != 0) {
+                out.push_back(w * 64 + detail::countTrailingZeros64(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    FeatureSet toSet() const {
+        std::vector<FeatureIndex> list;
+        toList(list);
+        return FeatureSet(list.begin(), list.end());
+    }
+
+    bool operator==(const FeatureBitset& other) const {
+        return featureCount_ == other.featureCount_ && words_ == other.words_;
+    }
+    bool operator!=(const FeatureBitset& other) const { return !(*this == other); }
+
+private:
+    std::size_t featureCount_ = 0;
+    std::vector<std::uint64_t> words_;
+};
+
+} // namespace feature_selection
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Non-owning, read-only view over the feature values of one instance
+ *
+ * A RowView can wrap a row of a FeatureMatrix or any std::vector<double>,
+ * so distance functions accept either without copying.
+ */
+class RowView {
+public:
+    RowView() = default;
+    RowView(const double* data, std::size_t size) : data_(data), size_(size) {}
+    RowView(const std::vector<double>& values) : data_(values.data()), size_(values.size()) {}
+
+    const double* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const double& operator[](std::size_t i) const { return data_[i]; }
+    const double* begin() const { return data_; }
+    const double* end() const { return data_ + size_; }
+
+private:
+    const double* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Contiguous, cache-aligned feature store with row- and column-major views
+ *
+ * Values are kept twice: once row-major (one instance per row, used for
+ * per-pair distances) and once column-major (one feature per column, used for
+ * per-feature sweeps and subset gathers). Both buffers are 64-byte aligned and
+ * every row and column is zero-padded to a multiple of 8 doubles, so SIMD code
+ * can run over a full stride without tail handling.
+ *
+ * Writes through set() keep both views in sync. Bulk writers that fill one
+ * view through mutableRowData()/mutableColumnData() must call
+ * syncColumnsFromRows()/syncRowsFromColumns() before the other view is read.
+ */
+class FeatureMatrix {
+public:
+    static constexpr std::size_t kAlignment = 64;
+    static constexpr std::size_t kPadding = kAlignment / sizeof(double);
+
+    /**
+     * @brief Random-access iterator over the rows of a matrix
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = RowView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = RowView;
+
+        const_iterator(const FeatureMatrix* matrix, std::size_t index)
+            : matrix_(matrix), index_(index) {}
+
+        RowView operator*() const { return matrix_->row(index_); }
+        RowView operator[](difference_type n) const { return matrix_->row(index_ + n); }
+
+        const_iterator& operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { auto tmp = *this; ++index_; return tmp; }
+        const_iterator& operator--() { --index_; return *this; }
+        const_iterator operator--(int) { auto tmp = *this; --index_; return tmp; }
+        const_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+        const_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return {matrix_, index_ + n}; }
+        const_iterator operator-(difference_type n) const { return {matrix_, index_ - n}; }
+        difference_type operator-(const const_iterator& other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+        bool operator<(const const_iterator& other) const { return index_ < other.index_; }
+
+    private:
+        const FeatureMatrix* matrix_;
+        std::size_t index_;
+    };
+
+    FeatureMatrix() = default;
+
+    /**
+     * @brief Create a zero-initialised matrix
+     * @param rows Number of instances
+     * @param cols Number of features per instance
+     */
+    FeatureMatrix(std::size_t rows, std::size_t cols);
+
+    FeatureMatrix(const FeatureMatrix& other);
+    FeatureMatrix& operator=(const FeatureMatrix& other);
+    FeatureMatrix(FeatureMatrix&&) noexcept = default;
+    FeatureMatrix& operator=(FeatureMatrix&&) noexcept = default;
+
+    /**
+     * @brief Build a matrix from a vector of equally sized rows
+     * @param rows Row values; every row must have the same length
+     * @return The packed matrix
+     */
+    static FeatureMatrix fromRows(const std::vector<std::vector<double>>& rows);
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t size() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+
+    /// Distance in doubles between consecutive rows of the row-major view
+    std::size_t rowStride() const { return rowStride_; }
+    /// Distance in doubles between consecutive columns of the column-major view
+    std::size_t columnStride() const { return columnStride_; }
+
+    RowView row(std::size_t i) const { return RowView(rowData(i), cols_); }
+    RowView operator[](std::size_t i) const { return row(i); }
+
+    const double* rowData(std::size_t i) const { return rowMajor_.get() + i * rowStride_; }
+    const double* columnData(std::size_t j) const { return columnMajor_.get() + j * columnStride_; }
+    double* mutableRowData(std::size_t i) { return rowMajor_.get() + i * rowStride_; }
+    double* mutableColumnData(std::size_t j) { return columnMajor_.get() + j * columnStride_; }
+
+    double at(std::size_t i, std::size_t j) const { return rowMajor_[i * rowStride_ + j]; }
+
+    void set(std::size_t i, std::size_t j, double value) {
+        rowMajor_[i * rowStride_ + j] = value;
+        columnMajor_[j * columnStride_ + i] = value;
+    }
+
+    /**
+     * @brief Rebuild the column-major view after bulk writes to rows
+     */
+    void syncColumnsFromRows();
+
+    /**
+     * @brief Rebuild the row-major view after bulk writes to columns
+     */
+    void syncRowsFromColumns();
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, rows_); }
+
+private:
+    struct AlignedDeleter {
+        void operator()(double* ptr) const;
+    };
+    using Buffer = std::unique_ptr<double[], AlignedDeleter>;
+
+    static Buffer allocate(std::size_t count);
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::size_t rowStride_ = 0;
+    std::size_t columnStride_ = 0;
+    Buffer rowMajor_;
+    Buffer columnMajor_;
+};
+
+} // namespace feature_selection
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "feature_selection/candidate_screen.h"
+#include "feature_selection/compact_matrix.h"
+#include "feature_selection/distributed_evaluator.h"
+#include "feature_selection/early_termination.h"
+#include "feature_selection/evaluation_memo.h"
+#include "feature_selection/numa_topology.h"
+#include "feature_selection/partial_distance_search.h"
+#include "feature_selection/streaming_evaluator.h"
+#include "feature_selection/successive_halving.h"
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Outcome of a feature subset search
+ */
+struct SearchResult {
+    FeatureSet bestFeatureSet;
+    double bestAccuracy = 0.0;
+    
+    // Best feature set chosen at each level of the search, with its accuracy
+    std::vector<std::pair<FeatureSet, double>> allResults;
+    
+    // Early-abandon counters when SearchOptions::partialDistanceSearch was used
+    PruningStats pruning;
+    
+    // Screening/exact agreement when SearchOptions::screeningRows was set
+    ScreeningStats screening;
+    
+    // Each level's chosen subset scored on both paths, when
+    // SearchOptions::validatePrecision was set
+    std::vector<PrecisionCheck> precisionChecks;
+    
+    // NUMA placement and thread binding the search ran with
+    PlacementReport placement;
+    
+    // Units handed to worker processes when SearchOptions::coordinator was set
+    DistributedStats distributed;
+    
+    // Levels taken from a checkpoint instead of computed (SearchOptions::resume)
+    std::size_t resumedLevels = 0;
+    
+    // Lookups this search made in SearchOptions::memo
+    MemoStats memo;
+    
+    // Rows skipped when SearchOptions::earlyTermination was set
+    TerminationStats termination;
+    
+    // Per-level schedules when SearchOptions::halvingRows was set
+    HalvingStats halving;
+};
+
+/**
+ * @brief Tuning knobs shared by the search strategies
+ */
+struct SearchOptions {
+    // Keep an incremental n x n distance cache when it fits in this many
+    // bytes; 0 always recomputes every candidate from scratch. Unused with
+    // earlyTermination
+    std::size_t distanceCacheBudget = std::size_t(1) << 30;
+    
+    // Decremental cache updates applied in backward elimination before the
+    // cached distances are recomputed exactly to bound round-off drift
+    std::size_t cacheRefreshInterval = 16;
+    
+    // Score candidates the cache does not cover with the early-abandoning
+    // PartialDistanceSearch instead of the tiled engine; pays off on wide
+    // subsets where most candidates are rejected after a few features
+    bool partialDistanceSearch = false;
+    
+    // Screen each level's candidates by leave-one-out accuracy on a
+    // stratified sample of this many rows and re-score only the best
+    // screeningTopK exactly; 0 (or at least the dataset size) disables
+    // screening. Replaces the distance cache when enabled
+    std::size_t screeningRows = 0;
+    std::size_t screeningTopK = 3;
+    std::uint64_t screeningSeed = 1;
+    
+    // Also score every screened candidate exactly, to measure how often the
+    // exact best survives screening (for tuning; as slow as no screening)
+    bool screeningAudit = false;
+    
+    // Successive halving in forwardSelection and backwardElimination: score
+    // each level's candidates within a stratified sample of halvingRows rows,
+    // keep the best halvingKeep share on a sample twice the size, and repeat
+    // until halvingFinalists remain, which are scored exactly; 0 (or at
+    // least the dataset size) disables it. Replaces the distance cache;
+    // screening takes precedence
+    std::size_t halvingRows = 0;
+    double halvingKeep = 0.5;
+    std::size_t halvingFinalists = 2;
+    std::uint64_t halvingSeed = 1;
+    
+    // Score candidates on a float32 or min-max quantized integer copy of the
+    // features instead of the doubles; replaces the distance cache when set.
+    // The copy is made beside the caller's doubles; to hold only the compact
+    // storage, load it with DataLoader::loadCompactDataset and search it
+    // with the CompactMatrix overloads
+    StoragePrecision storagePrecision = StoragePrecision::Float64;
+    
+    // With reduced precision, also score each level's chosen subset on the
+    // double path and record both accuracies
+    bool validatePrecision = false;
+    
+    // Spread the feature store over the NUMA nodes by parallel first touch,
+    // or give every node its own copy for the tiled engine to read
+    NumaPlacement numaPlacement = NumaPlacement::FirstTouch;
+    
+    // Bind the OpenMP threads to CPUs before the search; Spread matches the
+    // per-node replicas, Compact fills one socket first
+    ThreadAffinity threadAffinity = ThreadAffinity::None;
+    
+    // Score candidates on the worker processes of this coordinator instead
+    // of in-process; its dataset must be the one being searched. Replaces
+    // the distance cache, reduced precision and partial distance search.
+    // Not owned
+    DistributedCoordinator* coordinator = nullptr;
+    
+    // Save the search state (current set, allResults and any distance cache)
+    // to this file after every checkpointInterval completed levels; empty
+    // disables checkpoints. Diagnostic counters are not saved
+    std::string checkpointPath;
+    std::size_t checkpointInterval = 1;
+    
+    // Continue from checkpointPath when it exists instead of starting over;
+    // a missing file starts a fresh search
+    bool resume = false;
+    
+    // Stop forwardSelection and backwardElimination after this many levels,
+    // counted from where they start or resume; 0 runs the whole search
+    std::size_t maxLevels = 0;
+    
+    // Look every exactly scored subset up in this memo before scoring it and
+    // store the new ones; share one memo between searches over the same
+    // dataset. Unused for reduced-precision scoring. Not owned
+    EvaluationMemo* memo = nullptr;
+    
+    // Subsets kept per level by beamSearch; 1 reproduces forwardSelection
+    std::size_t beamWidth = 4;
+    
+    // Score candidates block by block, hardest rows first, and stop those
+    // whose errors already rule them out of the level's best; they print as
+    // "stopped early". Replaces the distance cache in forwardSelection and
+    // backwardElimination, since cached candidates are not scored per row
+    // block; does not apply to screening, halving, the sorted sweep of the
+    // first forward level or distributed workers
+    bool earlyTermination = false;
+};
+
+/**
+ * @brief Greedy wrapper feature selection around the 1-NN classifier
+ */
+class FeatureSelection {
+public:
+    /**
+     * @brief Greedy forward selection starting from the empty set
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult forwardSelection(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Greedy backward elimination starting from all features
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult backwardElimination(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Greedy forward selection on reduced-precision storage alone
+     *
+     * For data loaded with DataLoader::loadCompactDataset: no double matrix
+     * is held, unlike forwardSelection with options.storagePrecision, which
+     * keeps the caller's doubles for the first level and precision checks.
+     * Options apply as for the streamed forwardSelection
+     * @param data The dataset in float32, int16 or int8 storage
+     * @param labels Class label of each row
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult forwardSelection(
+        const CompactMatrix& data,
+        const LabelVector& labels,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Greedy backward elimination on reduced-precision storage alone
+     * @param data The dataset in float32, int16 or int8 storage
+     * @param labels Class label of each row
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult backwardElimination(
+        const CompactMatrix& data,
+        const LabelVector& labels,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Greedy forward selection scored out of core through a StreamingEvaluator
+     *
+     * Candidates are scored as (candidate x row block) units straight from
+     * the mapped dataset, so the feature matrix is never loaded. Gives the
+     * same trace as forwardSelection on the loaded data. Only earlyTermination
+     * and maxLevels apply; the other options need the data in memory
+     * @param evaluator Evaluator over the mapped dataset
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult forwardSelection(
+        const StreamingEvaluator& evaluator,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Greedy backward elimination scored out of core through a StreamingEvaluator
+     *
+     * The streamed counterpart of backwardElimination; options apply as for
+     * the streamed forwardSelection
+     * @param evaluator Evaluator over the mapped dataset
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult backwardElimination(
+        const StreamingEvaluator& evaluator,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Forward beam search keeping the options.beamWidth best subsets per level
+     *
+     * Every child of every kept subset is scored in one parallel batch.
+     * Uses the memo, reduced precision, partial distance search, NUMA
+     * placement and distributed workers like the greedy searches, but not the
+     * distance cache or screening. allResults holds the best subset of each level
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult beamSearch(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Sequential floating forward selection (SFFS)
+     *
+     * After each addition, removes features again while that improves on
+     * the best subset of the smaller size found so far. allResults holds
+     * every step; scoring options apply as for beamSearch
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult floatingForwardSelection(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Sequential floating backward selection (SBFS)
+     *
+     * The mirror image of floatingForwardSelection, starting from all
+     * features; like backwardElimination it also scores the empty set
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param verbose Print every evaluated candidate
+     * @param options Search tuning options
+     * @return The search trace and the best subset found
+     */
+    static SearchResult floatingBackwardSelection(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        bool verbose = true,
+        const SearchOptions& options = SearchOptions()
+    );
+    
+    /**
+     * @brief Print a summary of a search result
+     * @param result The result to print
+     * @param algorithmName Name shown in the header line
+     */
+    static void printSearchResults(
+        const SearchResult& result,
+        const std::string& algorithmName
+    );
+};
+
+} // namespace feature_selection
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Read-only view of a whole file, memory-mapped where the OS allows it
+ *
+ * On POSIX systems the file is mapped with mmap, so its pages are loaded on
+ * demand and shared with the page cache. Elsewhere the contents are read
+ * into an owned buffer instead. Either way data() stays valid for the
+ * lifetime of the object.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Map a file for reading
+     * @param filename File to open
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    /**
+     * @brief Hint that the mapping will be read front to back
+     */
+    void adviseSequential() const;
+
+private:
+    void release();
+    
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<char> buffer_;
+};
+
+} // namespace feature_selection
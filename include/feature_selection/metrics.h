@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace feature_selection {
+
+// Builds configured with -DFEATURE_SELECTION_METRICS=OFF compile every
+// counter and timer below to nothing; exports then report zeros
+#ifdef FEATURE_SELECTION_METRICS
+inline constexpr bool kMetricsEnabled = true;
+#else
+inline constexpr bool kMetricsEnabled = false;
+#endif
+
+/**
+ * @brief Event counters of the hot paths
+ */
+enum class Counter : std::size_t {
+    // Query-reference pairs scored by leave-one-out: (rows - 1) per query
+    // row scored, whichever engine answered the subset
+    DistanceEvaluations,
+
+    // Feature subsets scored by leave-one-out, partly or fully
+    LeaveOneOutCalls,
+
+    // Bytes of dataset files read by DataLoader::loadDataset
+    BytesLoaded,
+
+    // Bytes of text parsed
+    BytesParsed,
+
+    Count
+};
+
+/**
+ * @brief Phases timed with Metrics::ScopedTimer
+ */
+enum class Phase : std::size_t {
+    Load,
+    Parse,
+    Normalize,
+    Search,
+    Count
+};
+
+inline constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::Count);
+inline constexpr std::size_t kPhaseCount = static_cast<std::size_t>(Phase::Count);
+
+/**
+ * @brief Work and wall time of one search level
+ */
+struct LevelMetrics {
+    std::string search;
+    std::size_t level = 0;
+    std::size_t candidates = 0;
+    double seconds = 0.0;
+};
+
+/**
+ * @brief Totals of every thread's counters and timers at one moment
+ */
+struct MetricsSnapshot {
+    bool enabled = kMetricsEnabled;
+    std::array<std::uint64_t, kCounterCount> counters {};
+    std::array<std::uint64_t, kPhaseCount> phaseNanoseconds {};
+    std::array<std::uint64_t, kPhaseCount> phaseCalls {};
+    std::vector<LevelMetrics> levels;
+
+    std::uint64_t counter(Counter c) const { return counters[static_cast<std::size_t>(c)]; }
+    double seconds(Phase phase) const { return phaseNanoseconds[static_cast<std::size_t>(phase)] * 1e-9; }
+
+    /// BytesLoaded over the load time, in MB (10^6 bytes) per second
+    double loadMegabytesPerSecond() const;
+
+    /// BytesParsed over the parse time, in MB per second
+    double parseMegabytesPerSecond() const;
+
+    std::string toJson() const;
+
+    /// Prometheus text exposition format
+    std::string toPrometheus() const;
+};
+
+/**
+ * @brief Process-wide instrumentation with per-thread counters
+ *
+ * Every thread owns a cache-line aligned block of counters that only it
+ * writes (plain relaxed load and store, no locked instructions), so counting
+ * from inside parallel loops does not contend. snapshot() sums the blocks of
+ * every thread that ever counted. Per-level records are rare and go through
+ * a mutex.
+ */
+class Metrics {
+public:
+    static constexpr bool enabled() { return kMetricsEnabled; }
+
+    static void add(Counter counter, std::uint64_t amount = 1) {
+        if constexpr (kMetricsEnabled) {
+            bump(local().counters[static_cast<std::size_t>(counter)], amount);
+        }
+    }
+
+    static void addTime(Phase phase, std::uint64_t nanoseconds) {
+        if constexpr (kMetricsEnabled) {
+            ThreadCounters& counters = local();
+            bump(counters.phaseNanoseconds[static_cast<std::size_t>(phase)], nanoseconds);
+            bump(counters.phaseCalls[static_cast<std::size_t>(phase)], 1);
+        }
+    }
+
+    static void recordLevel(const LevelMetrics& level);
+
+    static MetricsSnapshot snapshot();
+
+    /// Zero every counter and drop the level records
+    static void reset();
+
+    /**
+     * @brief Write a snapshot: JSON for a ".json" path, Prometheus text otherwise
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void write(const std::string& path);
+
+    static const char* counterName(Counter counter);
+    static const char* phaseName(Phase phase);
+
+    /**
+     * @brief Adds the lifetime of the scope to a phase
+     */
+    class ScopedTimer {
+    public:
+#ifdef FEATURE_SELECTION_METRICS
+        explicit ScopedTimer(Phase phase) : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() { addTime(phase_, elapsedNanoseconds(start_)); }
+#else
+        explicit ScopedTimer(Phase) {}
+#endif
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+#ifdef FEATURE_SELECTION_METRICS
+    private:
+        Phase phase_;
+        std::chrono::steady_clock::time_point start_;
+#endif
+    };
+
+    /**
+     * @brief Records a search level with the lifetime of the scope as its time
+     */
+    class LevelTimer {
+    public:
+#ifdef FEATURE_SELECTION_METRICS
+        LevelTimer(const char* search, std::size_t level, std::size_t candidates)
+            : search_(search), level_(level), candidates_(candidates), start_(std::chrono::steady_clock::now()) {}
+        ~LevelTimer() { recordLevel({search_, level_, candidates_, elapsedNanoseconds(start_) * 1e-9}); }
+#else
+        LevelTimer(const char*, std::size_t, std::size_t) {}
+#endif
+        LevelTimer(const LevelTimer&) = delete;
+        LevelTimer& operator=(const LevelTimer&) = delete;
+
+#ifdef FEATURE_SELECTION_METRICS
+    private:
+        const char* search_;
+        std::size_t level_;
+        std::size_t candidates_;
+        std::chrono::steady_clock::time_point start_;
+#endif
+    };
+
+private:
+    struct alignas(64) ThreadCounters {
+        std::array<std::atomic<std::uint64_t>, kCounterCount> counters {};
+        std::array<std::atomic<std::uint64_t>, kPhaseCount> phaseNanoseconds {};
+        std::array<std::atomic<std::uint64_t>, kPhaseCount> phaseCalls {};
+    };
+
+    // Only the owning thread writes, so a relaxed read-modify-write suffices
+    static void bump(std::atomic<std::uint64_t>& value, std::uint64_t amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static ThreadCounters& local() {
+        thread_local ThreadCounters* counters = registerThread();
+        return *counters;
+    }
+
+    static std::uint64_t elapsedNanoseconds(std::chrono::steady_clock::time_point start) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start
+        ).count());
+    }
+
+    // Allocates the calling thread's block; blocks outlive their threads
+    static ThreadCounters* registerThread();
+};
+
+} // namespace feature_selection
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief 1-nearest-neighbor classifier with Euclidean distance
+ *
+ * Single distances are computed by the SIMD kernels in DistanceKernels;
+ * leave-one-out evaluation runs on the cache-blocked TiledNearestNeighbor
+ * engine over the matrix's column-major view, on a KD-tree or ball tree
+ * when SpatialIndex::chooseStrategy() expects that to be cheaper, and by a
+ * SortedSweep for single-feature subsets.
+ */
+class NearestNeighbor {
+public:
+    /**
+     * @brief Euclidean distance between two instances
+     * @param a First instance
+     * @param b Second instance
+     * @param featureSubset Features to compare; an empty set means all features
+     * @return Distance over the selected features
+     */
+    static double calculateDistance(
+        RowView a,
+        RowView b,
+        const FeatureSet& featureSubset = FeatureSet()
+    );
+    
+    /**
+     * @brief Find the instance closest to a query point
+     * @param data The dataset to search
+     * @param point The query point
+     * @param excludeIndex Row to skip (the query itself in leave-one-out)
+     * @param featureSubset Features to compare; an empty set means all features
+     * @return Row index of the nearest neighbor; ties go to the lowest index
+     *
+     * Candidates are abandoned once a partial squared distance reaches the
+     * best so far; see PartialDistanceSearch for the variance-ordered
+     * variant with pruning statistics.
+     */
+    static std::size_t findNearestNeighbor(
+        const DataMatrix& data,
+        RowView point,
+        std::size_t excludeIndex,
+        const FeatureSet& featureSubset = FeatureSet()
+    );
+    
+    /**
+     * @brief Leave-one-out cross-validation accuracy of the 1-NN classifier
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param featureSubset Features to use; an empty set means all features
+     * @param verbose Print each instance's nearest neighbor
+     * @return Fraction of instances whose nearest neighbor has the same label
+     */
+    static double leaveOneOutCrossValidation(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        const FeatureSet& featureSubset = FeatureSet(),
+        bool verbose = false
+    );
+    
+    /**
+     * @brief Count correct leave-one-out predictions over a packed feature list
+     *
+     * Allocation-free variant used on the search hot path: distances are read
+     * through the index list directly from the data columns.
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param features Ascending, in-range feature indices
+     * @param featureCount Number of indices
+     * @return Number of instances whose nearest neighbor has the same label
+     */
+    static std::size_t leaveOneOutCorrect(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        const FeatureIndex* features,
+        std::size_t featureCount
+    );
+
+private:
+    /**
+     * @brief Packed, ascending list of the subset's in-range features
+     */
+    static std::vector<FeatureIndex> packFeatures(
+        const FeatureSet& featureSubset,
+        std::size_t featureCount
+    );
+};
+
+} // namespace feature_selection
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Per-feature scaling applied to a dataset before searching
+ */
+enum class NormalizationMethod : std::uint32_t {
+    None = 0,
+    ZScore = 1,
+    MinMax = 2,
+    Robust = 3
+};
+
+/**
+ * @brief Summary statistics of one feature column
+ */
+struct ColumnStats {
+    double mean = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @brief Parameters of a normalization: value j becomes (x - center[j]) / scale[j]
+ */
+struct NormalizationParams {
+    NormalizationMethod method = NormalizationMethod::None;
+    std::vector<double> centers;
+    std::vector<double> scales;
+
+    bool empty() const { return method == NormalizationMethod::None; }
+};
+
+/**
+ * @brief Feature normalization: z-score, min-max or robust (median and IQR)
+ *
+ * Column statistics are computed from the contiguous column-major view, one
+ * column per thread, with mean, variance, minimum and maximum gathered in a
+ * single vectorized pass (the sums are shifted by the first value of the
+ * column to keep the variance accurate). The robust method selects its
+ * quantiles from a copy of each column instead. Normalizing rewrites both
+ * views of the matrix in place, so no second matrix is allocated.
+ *
+ * Constant columns get a scale of 1 and become all zero.
+ */
+class Normalizer {
+public:
+    /**
+     * @brief Mean, population standard deviation, minimum and maximum of every column
+     */
+    static std::vector<ColumnStats> columnStats(const DataMatrix& data);
+
+    /**
+     * @brief Compute the parameters of a method from the data
+     */
+    static NormalizationParams fit(const DataMatrix& data, NormalizationMethod method);
+
+    /**
+     * @brief Rewrite the data in place with the given parameters
+     * @throws std::invalid_argument if the parameters do not match the columns
+     */
+    static void apply(DataMatrix& data, const NormalizationParams& params);
+
+    /**
+     * @brief Fit and apply in one call
+     * @return The parameters used
+     */
+    static NormalizationParams normalize(DataMatrix& data, NormalizationMethod method);
+
+    /**
+     * @brief Fit and apply a method to a single column in place
+     *
+     * Same arithmetic as fit() and apply() on that column, for loaders that
+     * never hold the whole matrix.
+     */
+    static void normalizeColumn(
+        double* column,
+        std::size_t rows,
+        NormalizationMethod method,
+        double& center,
+        double& scale
+    );
+
+    static const char* methodName(NormalizationMethod method);
+
+    /**
+     * @brief Parse "none", "zscore", "minmax" or "robust"
+     * @throws std::invalid_argument for any other name
+     */
+    static NormalizationMethod parseMethod(const std::string& name);
+};
+
+} // namespace feature_selection
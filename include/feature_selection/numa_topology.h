@@ -0,0 +1,164 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Where the feature store lives on a multi-socket machine
+ */
+enum class NumaPlacement {
+    FirstTouch,  ///< One copy, pages zeroed in parallel so they spread over the nodes
+    Replicate    ///< One copy per node, each first touched by a thread on that node
+};
+
+/**
+ * @brief How OpenMP threads are bound to CPUs
+ */
+enum class ThreadAffinity {
+    None,     ///< Leave placement to the OS and OMP_PROC_BIND
+    Compact,  ///< Fill the CPUs of node 0, then node 1, ...
+    Spread    ///< Round-robin threads over the nodes
+};
+
+/**
+ * @brief One NUMA node and the CPUs attached to it
+ */
+struct NumaNode {
+    std::size_t id = 0;
+    std::vector<int> cpus;
+};
+
+/**
+ * @brief Which placement a search ran with, and where its threads ended up
+ */
+struct PlacementReport {
+    NumaPlacement placement = NumaPlacement::FirstTouch;
+    ThreadAffinity affinity = ThreadAffinity::None;
+    std::size_t nodes = 1;
+    std::size_t replicas = 0;                 ///< Per-node copies of the data (0 = shared copy)
+    std::vector<int> threadCpus;              ///< CPU each thread was pinned to, or -1
+    std::vector<std::size_t> threadsPerNode;  ///< Pinned threads on each node
+
+    /**
+     * @brief One-line summary, e.g. "replicate on 2 nodes, spread 16 threads (8+8)"
+     */
+    std::string toString() const;
+};
+
+/**
+ * @brief NUMA nodes of this machine, read from /sys/devices/system/node
+ *
+ * Machines without that directory (or non-Linux systems) are reported as a
+ * single node holding every CPU, so callers never need a special case.
+ */
+class NumaTopology {
+public:
+    /**
+     * @brief Node layout of this machine
+     *
+     * Read from sysfs on the first call; the layout does not change while
+     * the process runs, so later calls return the same topology.
+     */
+    static const NumaTopology& detect();
+
+    /**
+     * @brief Build a topology from one kernel cpulist string per node
+     */
+    static NumaTopology fromCpuLists(const std::vector<std::string>& cpuLists);
+
+    /**
+     * @brief Parse a kernel cpulist such as "0-3,8,10-11"
+     * @throws std::runtime_error on malformed input
+     */
+    static std::vector<int> parseCpuList(const std::string& list);
+
+    std::size_t nodeCount() const { return nodes_.size(); }
+    const std::vector<NumaNode>& nodes() const { return nodes_; }
+
+    /**
+     * @brief Node position of a CPU, or 0 if the CPU is not listed
+     */
+    std::size_t nodeOfCpu(int cpu) const;
+
+    /**
+     * @brief Node position of the CPU the calling thread is running on
+     */
+    std::size_t currentNode() const;
+
+    /**
+     * @brief CPU that thread `thread` of `threads` is pinned to under an affinity
+     * @return A CPU id, or -1 for ThreadAffinity::None
+     */
+    int cpuForThread(ThreadAffinity affinity, std::size_t thread) const;
+
+    /**
+     * @brief Pin every thread of the OpenMP team to its CPU
+     *
+     * libgomp keeps its threads between parallel regions, so the binding
+     * holds for later regions of the same size, until a ThreadAffinityGuard
+     * restores it. Does nothing for ThreadAffinity::None or where thread
+     * affinity is unsupported.
+     * @return The placement report with threadCpus and threadsPerNode filled in
+     */
+    PlacementReport pinThreads(ThreadAffinity affinity) const;
+
+    static const char* placementName(NumaPlacement placement);
+    static const char* affinityName(ThreadAffinity affinity);
+
+private:
+    std::vector<NumaNode> nodes_;
+};
+
+/**
+ * @brief Restores the OpenMP team's CPU masks on destruction
+ *
+ * Saves the mask of every team thread before a search pins them, so the
+ * caller's later parallel regions run where they did before. Saves nothing
+ * for ThreadAffinity::None, which never rebinds.
+ */
+class ThreadAffinityGuard {
+public:
+    explicit ThreadAffinityGuard(ThreadAffinity affinity);
+    ~ThreadAffinityGuard();
+
+    ThreadAffinityGuard(const ThreadAffinityGuard&) = delete;
+    ThreadAffinityGuard& operator=(const ThreadAffinityGuard&) = delete;
+
+private:
+    std::vector<std::vector<int>> previous_;  ///< Allowed CPUs of each team thread (empty = unknown)
+};
+
+/**
+ * @brief Per-node copies of a feature matrix
+ *
+ * Each copy is allocated and first touched by a thread bound to its node,
+ * so reads from local() never cross the socket interconnect. On a single
+ * node no copy is made and local() returns the original.
+ */
+class NumaReplicas {
+public:
+    NumaReplicas(const DataMatrix& data, const NumaTopology& topology);
+
+    /**
+     * @brief The copy on the calling thread's node
+     */
+    const DataMatrix& local() const;
+
+    /**
+     * @brief Copy on node position `node` (the original if there are no copies)
+     */
+    const DataMatrix& replica(std::size_t node) const;
+
+    std::size_t replicaCount() const { return replicas_.size(); }
+
+private:
+    const DataMatrix& data_;
+    const NumaTopology& topology_;
+    std::vector<DataMatrix> replicas_;
+};
+
+} // namespace feature_selection
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Counters describing how much work early abandoning saved
+ */
+struct PruningStats {
+    // Candidate distances started
+    std::uint64_t candidates = 0;
+    
+    // Candidates dropped before their last feature was accumulated
+    std::uint64_t abandoned = 0;
+    
+    // Per-feature terms actually accumulated
+    std::uint64_t termsComputed = 0;
+    
+    // Terms a search without abandoning would have accumulated
+    std::uint64_t termsPossible = 0;
+    
+    void merge(const PruningStats& other) {
+        candidates += other.candidates;
+        abandoned += other.abandoned;
+        termsComputed += other.termsComputed;
+        termsPossible += other.termsPossible;
+    }
+    
+    double abandonRate() const {
+        return candidates == 0 ? 0.0 : static_cast<double>(abandoned) / static_cast<double>(candidates);
+    }
+    
+    double workFraction() const {
+        return termsPossible == 0 ? 1.0 : static_cast<double>(termsComputed) / static_cast<double>(termsPossible);
+    }
+};
+
+/**
+ * @brief Nearest-neighbor search with early abandoning of partial distances
+ *
+ * A candidate's squared distance is accumulated a few features at a time and
+ * the candidate is dropped as soon as the partial sum reaches the best
+ * distance found so far; since every term is non-negative it could no longer
+ * win. Features are visited in descending order of variance, so the terms
+ * most likely to be large come first and candidates are rejected early.
+ *
+ * Ties go to the lowest row index as in NearestNeighbor::findNearestNeighbor
+ * (a candidate equal to the best is never taken). The summation order
+ * differs from the other paths, so on near-ties that differ only by
+ * round-off the chosen neighbor can differ from theirs.
+ */
+class PartialDistanceSearch {
+public:
+    /**
+     * @brief Features accumulated between two abandon checks
+     */
+    static constexpr std::size_t kCheckInterval = 4;
+    
+    /**
+     * @brief Prepare a search over a dataset (computes per-feature variances)
+     * @param data The dataset; must outlive the search
+     */
+    explicit PartialDistanceSearch(const DataMatrix& data);
+    
+    /**
+     * @brief Population variance of each feature
+     */
+    const std::vector<double>& variances() const { return variances_; }
+    
+    /**
+     * @brief Order features by descending variance, ties by ascending index
+     * @param features In-range feature indices
+     * @param featureCount Number of indices
+     * @param ordered Receives the reordered list
+     */
+    void orderByVariance(
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::vector<FeatureIndex>& ordered
+    ) const;
+    
+    /**
+     * @brief Nearest row to a query over a variance-ordered feature list
+     * @param query Query values, indexed by feature
+     * @param excludeIndex Row to skip (the query itself in leave-one-out)
+     * @param ordered Feature indices, as produced by orderByVariance()
+     * @param featureCount Number of indices
+     * @param stats Pruning counters to add to, or nullptr
+     * @return Row index of the nearest neighbor
+     */
+    std::size_t findNearest(
+        const double* query,
+        std::size_t excludeIndex,
+        const FeatureIndex* ordered,
+        std::size_t featureCount,
+        PruningStats* stats = nullptr
+    ) const;
+    
+    /**
+     * @brief Count correct leave-one-out predictions over a feature list
+     *
+     * Parallel over query rows when called outside a parallel region.
+     * @param labels Class label of each row
+     * @param features In-range feature indices, in any order
+     * @param featureCount Number of indices
+     * @param stats Pruning counters to add to, or nullptr
+     * @return Number of instances whose nearest neighbor has the same label
+     */
+    std::size_t leaveOneOutCorrect(
+        const LabelVector& labels,
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        PruningStats* stats = nullptr
+    ) const;
+    
+    /**
+     * @brief Same count restricted to queries [queryBegin, queryEnd)
+     *
+     * Runs on the calling thread; neighbors are still searched over all rows.
+     */
+    std::size_t leaveOneOutCorrect(
+        const LabelVector& labels,
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::size_t queryBegin,
+        std::size_t queryEnd,
+        PruningStats* stats = nullptr
+    ) const;
+
+private:
+    const DataMatrix& data_;
+    std::vector<double> variances_;
+};
+
+} // namespace feature_selection
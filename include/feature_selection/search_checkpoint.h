@@ -0,0 +1,106 @@
+#pragma once
+
+#include "feature_selection/binary_dataset.h"
+#include "feature_selection/distance_cache.h"
+#include "feature_selection/utils.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Which greedy search wrote a checkpoint
+ */
+enum class SearchDirection : std::uint32_t {
+    Forward = 0,
+    Backward = 1
+};
+
+/**
+ * @brief Progress of a search after its last completed level
+ *
+ * File layout (native little-endian, like BinaryDataset):
+ *   - Header
+ *   - state: stateWords 64-bit words holding the current list, the best
+ *     subset and accuracy, allResults, and the cached feature set
+ *   - cache: cacheValues float64 distances of a DistanceCache, if one was in use
+ *
+ * Header, state and cache each carry a checksum, and the header records a
+ * hash of the dataset so a checkpoint is never resumed against other data.
+ * Files are written to a temporary name and renamed, so a job killed while
+ * checkpointing leaves the previous checkpoint intact.
+ */
+struct SearchCheckpoint {
+    static constexpr std::uint32_t kVersion = 1;
+
+    /**
+     * @brief Fixed-size file header
+     */
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianMarker;
+        std::uint32_t direction;
+        std::uint32_t hasCache;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t datasetHash;
+        std::uint64_t levelsCompleted;
+        std::uint64_t cacheRemovals;
+        std::uint64_t stateWords;
+        std::uint64_t cacheValues;
+        std::uint64_t stateChecksum;
+        std::uint64_t cacheChecksum;
+        std::uint64_t headerChecksum;
+    };
+
+    SearchDirection direction = SearchDirection::Forward;
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::uint64_t datasetHash = 0;
+    std::size_t levelsCompleted = 0;
+
+    // Ascending current feature list (selected so far, or remaining)
+    std::vector<FeatureIndex> current;
+    FeatureSet bestFeatureSet;
+    double bestAccuracy = 0.0;
+    std::vector<std::pair<FeatureSet, double>> allResults;
+
+    // DistanceCache state, filled by read() when the writer had a cache
+    bool hasCache = false;
+    FeatureSet cacheFeatures;
+    std::size_t cacheRemovals = 0;
+    std::vector<double> cacheDistances;
+
+    /**
+     * @brief Hash of the feature values and labels a checkpoint belongs to
+     */
+    static std::uint64_t hashDataset(const DataMatrix& data, const LabelVector& labels);
+
+    /**
+     * @brief The same hash, computed from the mapped columns of a binary dataset
+     */
+    static std::uint64_t hashDataset(const BinaryDataset& dataset);
+
+    /**
+     * @brief Write the checkpoint, with the state of cache if it is not null
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& path, const DistanceCache* cache = nullptr) const;
+
+    /**
+     * @brief Read and validate a checkpoint
+     * @throws std::runtime_error if the file is missing, truncated or corrupted
+     */
+    static SearchCheckpoint read(const std::string& path);
+
+    /**
+     * @brief Move the saved cache state into cache
+     * @return false if the checkpoint holds no cache state
+     */
+    bool restoreCache(DistanceCache& cache);
+};
+
+} // namespace feature_selection
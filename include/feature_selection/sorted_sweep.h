@@ -0,0 +1,70 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Exact 1-NN leave-one-out over a single feature by sorting
+ *
+ * In one dimension a point's nearest neighbor lies in an adjacent group of
+ * equal values in sorted order, so sorting the column once gives every
+ * row's neighbor in O(n log n) instead of O(n^2).
+ *
+ * Ties match NearestNeighbor::findNearestNeighbor: rows are sorted by
+ * (value, row), so the first row of a group of equal values is its lowest
+ * index, and the sweep keeps walking outward while a further group's
+ * squared distance rounds to the same minimum, taking the lowest index
+ * over all of them.
+ */
+class SortedSweep {
+public:
+    /**
+     * @brief Nearest other row of every row using one feature
+     * @param column Feature values, one per row
+     * @param rows Number of rows
+     * @param nearest Receives each row's nearest neighbor
+     */
+    static void findAllNearest(const double* column, std::size_t rows, std::vector<std::size_t>& nearest);
+    
+    /**
+     * @brief Count rows whose nearest other row has the same label
+     * @param column Feature values, one per row
+     * @param labels Class label of each row
+     */
+    static std::size_t countCorrect(const double* column, const LabelVector& labels);
+    
+    /**
+     * @brief Count rows of [begin, end) whose nearest neighbor has the same label
+     *
+     * The sort cannot be split by rows, so row blocks of one feature share
+     * the neighbors from a single findAllNearest() call.
+     * @param nearest Each row's nearest neighbor, from findAllNearest()
+     * @param labels Class label of each row
+     */
+    static std::size_t countCorrect(
+        const std::vector<std::size_t>& nearest,
+        const LabelVector& labels,
+        std::size_t begin,
+        std::size_t end
+    );
+    
+    /**
+     * @brief Leave-one-out correct counts for each single-feature subset
+     *
+     * The columns are sorted in parallel, one feature per task.
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param features Features to evaluate on their own
+     * @return Number of correctly classified instances per feature
+     */
+    static std::vector<std::size_t> evaluateFeatures(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        const std::vector<FeatureIndex>& features
+    );
+};
+
+} // namespace feature_selection
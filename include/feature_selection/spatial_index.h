@@ -0,0 +1,200 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief How leave-one-out nearest neighbors are found for one subset
+ */
+enum class NeighborStrategy {
+    BruteForce,
+    KDTree,
+    BallTree
+};
+
+/**
+ * @brief Spatial index over a feature subset for exclude-self 1-NN queries
+ *
+ * An index is built per candidate subset: the selected columns are packed
+ * into a compact row-major copy in tree order, so queries touch only the
+ * subset's values. Distances are summed over the features in the order
+ * given, as TiledNearestNeighbor does, and ties go to the lowest row index,
+ * so an index returns the same neighbors as brute force.
+ *
+ * Trees pay off only while the subset is low-dimensional; chooseStrategy()
+ * compares estimated costs and falls back to brute force otherwise.
+ */
+class SpatialIndex {
+public:
+    /// Points per leaf
+    static constexpr std::size_t kLeafSize = 16;
+    
+    /// Widest subset an index is built for
+    static constexpr std::size_t kMaxDimensions = 16;
+    
+    /// Fewest rows for which an index is considered
+    static constexpr std::size_t kMinRows = 256;
+    
+    virtual ~SpatialIndex() = default;
+    
+    /**
+     * @brief Nearest indexed row to a query, skipping one row
+     * @param query Query values of the indexed features, in index order
+     * @param excludeIndex Row to skip (the query itself in leave-one-out)
+     * @return Row index of the nearest neighbor; ties go to the lowest index
+     */
+    virtual std::size_t nearest(const double* query, std::size_t excludeIndex) const = 0;
+    
+    std::size_t rows() const { return indices_.size(); }
+    std::size_t dimensions() const { return dimensions_; }
+    
+    /**
+     * @brief Pick the cheapest way to find every row's nearest neighbor
+     * @param rows Number of instances
+     * @param featureCount Subset dimension
+     */
+    static NeighborStrategy chooseStrategy(std::size_t rows, std::size_t featureCount);
+    
+    /**
+     * @brief Build an index of the given kind (nullptr for BruteForce)
+     */
+    static std::unique_ptr<SpatialIndex> build(
+        NeighborStrategy strategy,
+        const DataMatrix& data,
+        const FeatureIndex* features,
+        std::size_t featureCount
+    );
+    
+    /**
+     * @brief Nearest other row of every indexed row, parallel over rows
+     */
+    void findAllNearest(std::vector<std::size_t>& nearest) const;
+    
+    /**
+     * @brief Count rows whose nearest other row has the same label
+     */
+    std::size_t countCorrect(const LabelVector& labels) const;
+    
+    /**
+     * @brief Same, over the queries of rows [begin, end) only
+     *
+     * Serial: the caller runs row blocks of one index on several threads,
+     * and the counts of a partition of the rows add up to countCorrect().
+     */
+    std::size_t countCorrect(const LabelVector& labels, std::size_t begin, std::size_t end) const;
+    
+    static const char* strategyName(NeighborStrategy strategy);
+
+protected:
+    SpatialIndex(const DataMatrix& data, const FeatureIndex* features, std::size_t featureCount);
+    
+    /**
+     * @brief Scan rows [begin, end) of the packed points, updating the best match
+     */
+    void scanLeaf(
+        const double* query,
+        std::size_t excludeIndex,
+        std::size_t begin,
+        std::size_t end,
+        double& bestDistance,
+        std::size_t& bestIndex
+    ) const;
+    
+    /**
+     * @brief Reorder rows [begin, end) around their median along the widest feature
+     * @return Split position; rows before it are <= splitValue <= rows from it
+     */
+    std::size_t splitRange(std::size_t begin, std::size_t end, std::size_t& splitDimension, double& splitValue);
+    
+    /**
+     * @brief Value of a feature at a tree position while the tree is being built
+     */
+    double coordinate(std::size_t position, std::size_t dimension) const {
+        return points_[indices_[position] * dimensions_ + dimension];
+    }
+    
+    /**
+     * @brief Rewrite the packed points in tree order once building is done
+     */
+    void packInTreeOrder();
+    
+    const double* point(std::size_t position) const { return points_.data() + position * dimensions_; }
+    
+    std::size_t dimensions_;
+    
+    // Packed subset values (by original row while building, in tree order
+    // afterwards), each tree position's original row, and each original
+    // row's tree position once the tree is packed
+    std::vector<double> points_;
+    std::vector<std::size_t> indices_;
+    std::vector<std::size_t> positions_;
+};
+
+/**
+ * @brief KD-tree with median splits along the widest feature
+ *
+ * A subtree is skipped when the query's distance to its splitting plane
+ * already exceeds the best distance; that bound is exact in floating point,
+ * so pruning never changes the answer.
+ */
+class KDTree : public SpatialIndex {
+public:
+    KDTree(const DataMatrix& data, const FeatureIndex* features, std::size_t featureCount);
+    
+    std::size_t nearest(const double* query, std::size_t excludeIndex) const override;
+
+private:
+    struct Node {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t splitDimension;
+        double splitValue;
+        std::size_t left;
+        std::size_t right;
+        bool leaf;
+    };
+    
+    std::size_t buildNode(std::size_t begin, std::size_t end);
+    
+    std::vector<Node> nodes_;
+};
+
+/**
+ * @brief Ball tree: each node holds a centroid and a covering radius
+ *
+ * A subtree is skipped when the query is farther from the ball than the
+ * best distance. That bound involves a square root, so it is compared with
+ * a small relative slack and rounding can never prune a true nearest
+ * neighbor (or a lower-index tie). Balls adapt to the data better than
+ * axis-aligned cells as the dimension grows.
+ */
+class BallTree : public SpatialIndex {
+public:
+    BallTree(const DataMatrix& data, const FeatureIndex* features, std::size_t featureCount);
+    
+    std::size_t nearest(const double* query, std::size_t excludeIndex) const override;
+
+private:
+    struct Node {
+        std::size_t begin;
+        std::size_t end;
+        double radius;
+        std::size_t left;
+        std::size_t right;
+        bool leaf;
+    };
+    
+    std::size_t buildNode(std::size_t begin, std::size_t end);
+    double centroidDistance(const double* query, std::size_t node) const;
+    
+    std::vector<Node> nodes_;
+    
+    // Node centroids, dimensions() values per node
+    std::vector<double> centroids_;
+};
+
+} // namespace feature_selection
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "feature_selection/binary_dataset.h"
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Out-of-core leave-one-out evaluation over a memory-mapped dataset
+ *
+ * Rows are streamed in blocks straight from a BinaryDataset mapping: each
+ * block of query rows is compared against every reference block in turn by
+ * the TiledNearestNeighbor engine, which reads the mapped column segments in
+ * place, and each query keeps only its running minimum squared distance and
+ * argmin. The working set is the two blocks plus 16 bytes per row, so
+ * datasets larger than RAM can be evaluated; the mapped pages are read on
+ * demand and left to the page cache.
+ *
+ * Results match NearestNeighbor::leaveOneOutCrossValidation: reference
+ * blocks are visited in ascending order, so ties go to the lowest index.
+ */
+class StreamingEvaluator {
+public:
+    /**
+     * @brief Create an evaluator over a mapped dataset
+     * @param dataset The dataset; must outlive the evaluator
+     * @param memoryBudget Bytes of mapped columns touched per query/reference block pair
+     */
+    explicit StreamingEvaluator(
+        const BinaryDataset& dataset,
+        std::size_t memoryBudget = std::size_t(256) << 20
+    );
+    
+    /**
+     * @brief Leave-one-out accuracy for a feature subset
+     * @param featureSubset Features to use; an empty set means all features
+     * @return Fraction of instances whose nearest neighbor has the same label
+     */
+    double leaveOneOutCrossValidation(const FeatureSet& featureSubset) const;
+    
+    /**
+     * @brief Count correct leave-one-out predictions over a packed feature list
+     * @param features Ascending, in-range feature indices
+     * @param featureCount Number of indices
+     * @return Number of correctly classified instances
+     */
+    std::size_t leaveOneOutCorrect(const FeatureIndex* features, std::size_t featureCount) const;
+    
+    /**
+     * @brief Count correct predictions for queries [queryBegin, queryEnd) only
+     *
+     * Runs on the calling thread, for schedulers that split rows themselves;
+     * the running minima cover one query block, not the whole dataset.
+     */
+    std::size_t leaveOneOutCorrect(
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::size_t queryBegin,
+        std::size_t queryEnd
+    ) const;
+    
+    const LabelVector& labels() const { return labels_; }
+    
+    std::size_t rows() const { return dataset_.rows(); }
+    std::size_t cols() const { return dataset_.cols(); }
+    
+    /**
+     * @brief Rows per block used for a subset of the given size
+     */
+    std::size_t blockRows(std::size_t featureCount) const;
+
+private:
+    const BinaryDataset& dataset_;
+    LabelVector labels_;
+    std::size_t memoryBudget_;
+};
+
+} // namespace feature_selection
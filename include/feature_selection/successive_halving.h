@@ -0,0 +1,101 @@
+#pragma once
+
+#include "feature_selection/candidate_screen.h"
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Candidates scored in one successive-halving round
+ */
+struct HalvingRound {
+    std::size_t sampleRows = 0;
+    std::size_t candidates = 0;
+};
+
+/**
+ * @brief Schedule of one search level: the sampled rounds, then the
+ *        finalists scored exactly on every row
+ */
+struct HalvingLevel {
+    std::vector<HalvingRound> rounds;
+    std::size_t finalists = 0;
+};
+
+/**
+ * @brief Successive-halving schedules and the distance work they saved
+ */
+struct HalvingStats {
+    std::vector<HalvingLevel> levels;
+
+    // Pairwise distances computed by the rounds and the finalists, and the
+    // number exact scoring of every candidate would have computed
+    std::uint64_t distanceComputations = 0;
+    std::uint64_t distanceComputationsFull = 0;
+
+    double savedFraction() const {
+        return distanceComputationsFull == 0
+            ? 0.0
+            : 1.0 - static_cast<double>(distanceComputations) / static_cast<double>(distanceComputationsFull);
+    }
+};
+
+/**
+ * @brief Successive halving of a level's candidates over growing row samples
+ *
+ * Every candidate is first scored by leave-one-out within a small stratified
+ * sample of the rows; the best keepFraction of them survive to a sample twice
+ * the size, and so on until at most `finalists` remain or the next sample
+ * would hold every row. The survivors are then scored exactly by the caller.
+ * The samples are drawn once per search (round r uses seed + r), so a level
+ * costs no copying.
+ */
+class SuccessiveHalving {
+public:
+    /**
+     * @param data The dataset
+     * @param labels Class label of each row
+     * @param initialRows Rows of the first sample; doubled every round
+     * @param keepFraction Share of the candidates kept after each round
+     * @param finalists Candidates left for exact scoring (at least 1)
+     * @param seed Seed of the first round's sample
+     */
+    SuccessiveHalving(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        std::size_t initialRows,
+        double keepFraction,
+        std::size_t finalists,
+        std::uint64_t seed
+    );
+
+    /// Sampled rounds; samples smaller than the dataset only
+    std::size_t roundCount() const { return rounds_.size(); }
+
+    const CandidateScreen& round(std::size_t r) const { return *rounds_[r]; }
+
+    std::size_t finalists() const { return finalists_; }
+
+    /**
+     * @brief Candidates kept out of `candidates` after a round
+     */
+    std::size_t survivors(std::size_t candidates) const;
+
+    /**
+     * @brief Pairwise distances of one leave-one-out pass over `rows` rows
+     */
+    static std::uint64_t distanceComputations(std::size_t rows) {
+        return rows < 2 ? 0 : static_cast<std::uint64_t>(rows) * (rows - 1);
+    }
+
+private:
+    std::vector<std::unique_ptr<CandidateScreen>> rounds_;
+    double keepFraction_;
+    std::size_t finalists_;
+};
+
+} // namespace feature_selection
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "feature_selection/utils.h"
+#include <cstddef>
+#include <vector>
+
+namespace feature_selection {
+
+class BinaryDataset;
+
+/**
+ * @brief Cache-blocked all-pairs nearest-neighbor engine
+ *
+ * Works on column-major (SoA) feature storage. Queries are processed in
+ * tiles and compared against tiles of reference rows sized to stay in L2;
+ * for each query the squared distances to a whole reference tile are
+ * accumulated one feature at a time in an L1-resident buffer, vectorized
+ * across the references (direct differences, so results are exact rather
+ * than relying on the |a|^2 + |b|^2 - 2ab expansion). Each query keeps a
+ * running minimum and argmin.
+ *
+ * Reference tiles are visited in ascending order and the first minimum in a
+ * tile is taken, so ties go to the lowest row index as in
+ * NearestNeighbor::findNearestNeighbor. Distances are accumulated over the
+ * features in the order given, so every caller passing the same ascending
+ * feature list sees bit-identical distances.
+ */
+class TiledNearestNeighbor {
+public:
+    /**
+     * @brief Column-major feature storage: column j starts at base + j * stride
+     */
+    struct ColumnSource {
+        const double* base;
+        std::size_t stride;
+    };
+    
+    static constexpr std::size_t kQueryTile = 64;
+    
+    static ColumnSource columns(const DataMatrix& data);
+    static ColumnSource columns(const BinaryDataset& dataset);
+    
+    /**
+     * @brief Update running nearest neighbors of queries [queryBegin, queryEnd)
+     *        against references [referenceBegin, referenceEnd)
+     *
+     * A query never matches itself. Parallel over query tiles.
+     * @param source Column-major features
+     * @param features Feature indices to use, or nullptr for features [0, featureCount)
+     * @param featureCount Number of features
+     * @param bestDistance Running minimum squared distance, indexed by row
+     * @param bestIndex Running argmin, indexed by row
+     */
+    static void updateNearest(
+        ColumnSource source,
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::size_t queryBegin,
+        std::size_t queryEnd,
+        std::size_t referenceBegin,
+        std::size_t referenceEnd,
+        double* bestDistance,
+        std::size_t* bestIndex
+    );
+    
+    /**
+     * @brief updateNearest on the calling thread, with running minima local to the queries
+     *
+     * For schedulers that split rows themselves.
+     * @param bestDistance Running minimum squared distance, indexed by row - queryBegin
+     * @param bestIndex Running argmin, indexed by row - queryBegin
+     */
+    static void updateNearestBlock(
+        ColumnSource source,
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::size_t queryBegin,
+        std::size_t queryEnd,
+        std::size_t referenceBegin,
+        std::size_t referenceEnd,
+        double* bestDistance,
+        std::size_t* bestIndex
+    );
+    
+    /**
+     * @brief Nearest other row for every row in [0, rows)
+     */
+    static void findAllNearest(
+        ColumnSource source,
+        std::size_t rows,
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::vector<std::size_t>& nearest
+    );
+    
+    /**
+     * @brief Count rows whose nearest other row has the same label
+     *
+     * Needs no heap memory: running minima live on the stack per query tile.
+     */
+    static std::size_t countCorrect(
+        ColumnSource source,
+        const LabelVector& labels,
+        const FeatureIndex* features,
+        std::size_t featureCount
+    );
+    
+    /**
+     * @brief Count correct predictions for queries [queryBegin, queryEnd) only
+     *
+     * Runs on the calling thread, for schedulers that split rows themselves.
+     */
+    static std::size_t countCorrect(
+        ColumnSource source,
+        const LabelVector& labels,
+        const FeatureIndex* features,
+        std::size_t featureCount,
+        std::size_t queryBegin,
+        std::size_t queryEnd
+    );
+    
+    /**
+     * @brief Reference rows per tile for a given number of features
+     */
+    static std::size_t referenceTileRows(std::size_t featureCount);
+};
+
+} // namespace feature_selection
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "feature_selection/feature_matrix.h"
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -14,7 +15,7 @@ namespace feature_selection {
 using FeatureIndex = std::size_t;
 using FeatureSet = std::set<FeatureIndex>;
 using DataPoint = std::vector<double>;
-using DataMatrix = std::vector<DataPoint>;
+using DataMatrix = FeatureMatrix;
 using Label = int;
 using LabelVector = std::vector<Label>;
 
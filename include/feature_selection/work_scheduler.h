@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace feature_selection {
+
+/**
+ * @brief Flat (task × row block) scheduler for one level of a search
+ *
+ * Each task (a candidate subset) is split into blocks of query rows, and
+ * every (task, block) unit is handed out from a single dynamically scheduled
+ * parallel loop. Units never open parallel regions of their own, so there is
+ * no nested oversubscription, and the block size is chosen so that a level
+ * with 3 candidates and a level with 3000 both give every thread several
+ * units to balance over.
+ */
+class WorkScheduler {
+public:
+    /// Smallest block of query rows worth a unit of its own
+    static constexpr std::size_t kMinBlockRows = 64;
+
+    /// Units per thread the block size aims for when tasks alone are too few
+    static constexpr std::size_t kUnitsPerThread = 4;
+
+    /**
+     * @brief Query rows per block for a level
+     *
+     * All rows form one block when there are already enough tasks to keep
+     * every thread busy; otherwise tasks are split into blocks that are
+     * multiples of kMinBlockRows.
+     * @param tasks Tasks in the level
+     * @param rows Query rows per task
+     * @param threads Threads that will run the level
+     */
+    static std::size_t blockRows(std::size_t tasks, std::size_t rows, std::size_t threads);
+
+    /**
+     * @brief Number of blocks one task is split into
+     */
+    static std::size_t blockCount(std::size_t rows, std::size_t blockRows) {
+        return blockRows == 0 ? 0 : (rows + blockRows - 1) / blockRows;
+    }
+
+    /**
+     * @brief Run fn(task, rowBegin, rowEnd) once for every unit
+     *
+     * Units are ordered task-major so consecutive units share a subset's
+     * columns. fn runs on the calling thread of its unit and must only
+     * combine results through per-thread state or atomics.
+     * @param tasks Number of tasks
+     * @param rows Query rows per task
+     * @param blockRows Rows per block (see blockRows())
+     * @param fn Callable taking (std::size_t task, std::size_t rowBegin, std::size_t rowEnd)
+     */
+    template <typename Fn>
+    static void run(std::size_t tasks, std::size_t rows, std::size_t blockRows, Fn&& fn) {
+        const std::size_t blocks = blockCount(rows, blockRows);
+        const long long units = static_cast<long long>(tasks * blocks);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long u = 0; u < units; ++u) {
+            const std::size_t task = static_cast<std::size_t>(u) / blocks;
+            const std::size_t begin = (static_cast<std::size_t>(u) % blocks) * blockRows;
+            const std::size_t end = begin + blockRows < rows ? begin + blockRows : rows;
+            fn(task, begin, end);
+        }
+    }
+
+    /**
+     * @brief Same, visiting each task's blocks in the given order
+     * @param blockOrder Permutation of [0, blockCount(rows, blockRows))
+     */
+    template <typename Fn>
+    static void run(
+        std::size_t tasks,
+        std::size_t rows,
+        std::size_t blockRows,
+        const std::vector<std::size_t>& blockOrder,
+        Fn&& fn
+    ) {
+        const std::size_t blocks = blockCount(rows, blockRows);
+        const long long units = static_cast<long long>(tasks * blocks);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long long u = 0; u < units; ++u) {
+            const std::size_t task = static_cast<std::size_t>(u) / blocks;
+            const std::size_t begin = blockOrder[static_cast<std::size_t>(u) % blocks] * blockRows;
+            const std::size_t end = begin + blockRows < rows ? begin + blockRows : rows;
+            fn(task, begin, end);
+        }
+    }
+};
+
+} // namespace feature_selection
@@ -0,0 +1,380 @@
+#include "feature_selection/binary_dataset.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#define FEATURE_SELECTION_GETPID _getpid
+#else
+#include <unistd.h>
+#define FEATURE_SELECTION_GETPID getpid
+#endif
+
+namespace feature_selection {
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'S', 'B', 'I', 'N', '\0', '\0', '\0'};
+constexpr std::uint32_t kEndianMarker = 0x01020304u;
+
+std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Four-lane multiply-xor hash over 64-bit words; the lanes are independent
+// so the loop runs at memory bandwidth rather than multiply latency
+std::uint64_t hashBytes(const char* data, std::size_t size) {
+    constexpr std::uint64_t kPrime = 0x100000001b3ull;
+    std::uint64_t lanes[4] = {
+        0xcbf29ce484222325ull, 0x84222325cbf29ce4ull, 0x9ce484222325cbf2ull, 0x2325cbf29ce48422ull
+    };
+
+    std::size_t words = size / sizeof(std::uint64_t);
+    std::size_t i = 0;
+    for (; i + 4 <= words; i += 4) {
+        for (int lane = 0; lane < 4; ++lane) {
+            std::uint64_t word;
+            std::memcpy(&word, data + (i + lane) * sizeof(word), sizeof(word));
+            lanes[lane] = (lanes[lane] ^ word) * kPrime;
+        }
+    }
+
+    std::uint64_t hash = lanes[0];
+    for (int lane = 1; lane < 4; ++lane) {
+        hash = (hash ^ lanes[lane]) * kPrime;
+    }
+    for (std::size_t byte = i * sizeof(std::uint64_t); byte < size; ++byte) {
+        hash = (hash ^ static_cast<unsigned char>(data[byte])) * kPrime;
+    }
+    return hash;
+}
+
+std::uint64_t headerChecksum(const BinaryDataset::Header& header) {
+    BinaryDataset::Header copy = header;
+    copy.headerChecksum = 0;
+    return hashBytes(reinterpret_cast<const char*>(&copy), sizeof(copy));
+}
+
+// Distinct labels in order of first appearance, and each row's index into them
+void buildLabelTable(
+    const LabelVector& labels,
+    std::vector<std::int32_t>& labelTable,
+    std::vector<std::uint32_t>& rowLabels
+) {
+    std::unordered_map<Label, std::uint32_t> labelIndex;
+    rowLabels.resize(labels.size());
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+        auto [it, inserted] = labelIndex.emplace(labels[i], static_cast<std::uint32_t>(labelTable.size()));
+        if (inserted) {
+            labelTable.push_back(static_cast<std::int32_t>(labels[i]));
+        }
+        rowLabels[i] = it->second;
+    }
+}
+
+// Header with every section laid out; the checksums are left to the writer
+BinaryDataset::Header layoutHeader(
+    std::size_t rows,
+    std::size_t cols,
+    std::size_t labelCount,
+    std::uint64_t sourceSize,
+    std::int64_t sourceModified,
+    NormalizationMethod normalization
+) {
+    BinaryDataset::Header header {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = BinaryDataset::kVersion;
+    header.endianMarker = kEndianMarker;
+    header.dtype = BinaryDataset::kDTypeFloat64;
+    header.normalization = static_cast<std::uint32_t>(normalization);
+    header.rows = rows;
+    header.cols = cols;
+    header.columnStride = alignUp(rows, BinaryDataset::kSectionAlignment / sizeof(double));
+    header.labelCount = labelCount;
+    header.labelTableOffset = alignUp(sizeof(BinaryDataset::Header), BinaryDataset::kSectionAlignment);
+    header.rowLabelOffset = alignUp(
+        header.labelTableOffset + labelCount * sizeof(std::int32_t), BinaryDataset::kSectionAlignment
+    );
+    header.normalizationOffset = alignUp(
+        header.rowLabelOffset + rows * sizeof(std::uint32_t), BinaryDataset::kSectionAlignment
+    );
+    const std::size_t normalizationValues = normalization == NormalizationMethod::None ? 0 : 2 * cols;
+    header.dataOffset = alignUp(
+        header.normalizationOffset + normalizationValues * sizeof(double), BinaryDataset::kSectionAlignment
+    );
+    header.fileSize = header.dataOffset + header.cols * header.columnStride * sizeof(double);
+    header.sourceSize = sourceSize;
+    header.sourceModified = sourceModified;
+    return header;
+}
+
+} // namespace
+
+std::uint64_t BinaryDataset::checksum(const char* data, std::size_t size) {
+    return hashBytes(data, size);
+}
+
+std::string BinaryDataset::temporaryPath(const std::string& path) {
+    static std::atomic<std::uint64_t> counter{0};
+    return path + ".tmp." + std::to_string(FEATURE_SELECTION_GETPID()) + "." + std::to_string(counter++);
+}
+
+bool BinaryDataset::isBinaryDataset(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(kMagic)] = {};
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::uint32_t BinaryDataset::fileVersion(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char prefix[offsetof(Header, version) + sizeof(std::uint32_t)] = {};
+    if (!file.read(prefix, sizeof(prefix)) || std::memcmp(prefix, kMagic, sizeof(kMagic)) != 0) {
+        return 0;
+    }
+    std::uint32_t version = 0;
+    std::memcpy(&version, prefix + offsetof(Header, version), sizeof(version));
+    return version;
+}
+
+BinaryDataset::BinaryDataset(const std::string& path, bool verifyChecksum)
+    : file_(path) {
+    if (file_.size() < sizeof(Header)) {
+        throw std::runtime_error("Binary dataset is truncated: " + path);
+    }
+    std::memcpy(&header_, file_.data(), sizeof(Header));
+
+    if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a binary dataset: " + path);
+    }
+    if (header_.endianMarker != kEndianMarker) {
+        throw std::runtime_error("Binary dataset has foreign byte order: " + path);
+    }
+    if (header_.version != kVersion) {
+        throw std::runtime_error("Unsupported binary dataset version " + std::to_string(header_.version) + ": " + path);
+    }
+    if (header_.dtype != kDTypeFloat64) {
+        throw std::runtime_error("Unsupported binary dataset value type: " + path);
+    }
+    if (header_.headerChecksum != headerChecksum(header_)) {
+        throw std::runtime_error("Binary dataset header is corrupted: " + path);
+    }
+    if (header_.normalization > static_cast<std::uint32_t>(NormalizationMethod::Robust) ||
+        (header_.normalization != 0 &&
+         header_.normalizationOffset + 2 * header_.cols * sizeof(double) > header_.dataOffset)) {
+        throw std::runtime_error("Binary dataset has invalid normalization: " + path);
+    }
+    if (header_.fileSize != file_.size()) {
+        throw std::runtime_error("Binary dataset is truncated: " + path);
+    }
+
+    if (verifyChecksum) {
+        std::uint64_t actual = checksum(file_.data() + sizeof(Header), file_.size() - sizeof(Header));
+        if (actual != header_.payloadChecksum) {
+            throw std::runtime_error("Binary dataset checksum mismatch: " + path);
+        }
+    }
+}
+
+LabelVector BinaryDataset::labels() const {
+    const auto* table = reinterpret_cast<const std::int32_t*>(file_.data() + header_.labelTableOffset);
+    const auto* rowLabels = reinterpret_cast<const std::uint32_t*>(file_.data() + header_.rowLabelOffset);
+
+    LabelVector labels(rows());
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+        if (rowLabels[i] >= header_.labelCount) {
+            throw std::runtime_error("Binary dataset has an invalid label index");
+        }
+        labels[i] = static_cast<Label>(table[rowLabels[i]]);
+    }
+    return labels;
+}
+
+NormalizationParams BinaryDataset::normalization() const {
+    NormalizationParams params;
+    params.method = normalizationMethod();
+    if (!params.empty()) {
+        const auto* values = reinterpret_cast<const double*>(file_.data() + header_.normalizationOffset);
+        params.centers.assign(values, values + cols());
+        params.scales.assign(values + cols(), values + 2 * cols());
+    }
+    return params;
+}
+
+DataMatrix BinaryDataset::toMatrix() const {
+    DataMatrix data(rows(), cols());
+    const long long columnCount = static_cast<long long>(cols());
+    #pragma omp parallel for schedule(static) if(rows() * cols() > (1u << 16))
+    for (long long jj = 0; jj < columnCount; ++jj) {
+        const std::size_t j = static_cast<std::size_t>(jj);
+        std::memcpy(data.mutableColumnData(j), columnData(j), rows() * sizeof(double));
+    }
+    data.syncRowsFromColumns();
+    return data;
+}
+
+void BinaryDataset::write(
+    const std::string& path,
+    const DataMatrix& data,
+    const LabelVector& labels,
+    std::uint64_t sourceSize,
+    std::int64_t sourceModified,
+    const NormalizationParams& normalization
+) {
+    if (labels.size() != data.rows()) {
+        throw std::runtime_error("Mismatch between number of labels and data points");
+    }
+    if (!normalization.empty() &&
+        (normalization.centers.size() != data.cols() || normalization.scales.size() != data.cols())) {
+        throw std::runtime_error("Normalization parameters do not match the dataset's features");
+    }
+
+    std::vector<std::int32_t> labelTable;
+    std::vector<std::uint32_t> rowLabels;
+    buildLabelTable(labels, labelTable, rowLabels);
+    Header header = layoutHeader(
+        data.rows(), data.cols(), labelTable.size(), sourceSize, sourceModified, normalization.method
+    );
+
+    // Assemble the payload in memory so it can be checksummed in one pass
+    std::vector<char> payload(header.fileSize - sizeof(Header), 0);
+    char* base = payload.data() - sizeof(Header);
+    std::memcpy(base + header.labelTableOffset, labelTable.data(), labelTable.size() * sizeof(std::int32_t));
+    std::memcpy(base + header.rowLabelOffset, rowLabels.data(), rowLabels.size() * sizeof(std::uint32_t));
+    if (!normalization.empty()) {
+        char* params = base + header.normalizationOffset;
+        std::memcpy(params, normalization.centers.data(), data.cols() * sizeof(double));
+        std::memcpy(params + data.cols() * sizeof(double), normalization.scales.data(), data.cols() * sizeof(double));
+    }
+    for (std::size_t j = 0; j < data.cols(); ++j) {
+        std::memcpy(
+            base + header.dataOffset + j * header.columnStride * sizeof(double),
+            data.columnData(j),
+            data.rows() * sizeof(double)
+        );
+    }
+    header.payloadChecksum = checksum(payload.data(), payload.size());
+    header.headerChecksum = headerChecksum(header);
+
+    // Write to a temporary name first so readers never see a partial file
+    std::string tempPath = temporaryPath(path);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not create binary dataset: " + tempPath);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+        if (!file) {
+            throw std::runtime_error("Could not write binary dataset: " + tempPath);
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        throw std::runtime_error("Could not replace binary dataset: " + path);
+    }
+}
+
+BinaryDatasetWriter::BinaryDatasetWriter(
+    const std::string& path,
+    const LabelVector& labels,
+    std::size_t cols,
+    std::uint64_t sourceSize,
+    std::int64_t sourceModified
+) : path_(path), tempPath_(BinaryDataset::temporaryPath(path)) {
+    std::vector<std::int32_t> labelTable;
+    std::vector<std::uint32_t> rowLabels;
+    buildLabelTable(labels, labelTable, rowLabels);
+    header_ = layoutHeader(labels.size(), cols, labelTable.size(), sourceSize, sourceModified, NormalizationMethod::None);
+
+    // The header is written last, once the checksum is known
+    file_.open(tempPath_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Could not create binary dataset: " + tempPath_);
+    }
+    file_.seekp(static_cast<std::streamoff>(header_.labelTableOffset));
+    file_.write(reinterpret_cast<const char*>(labelTable.data()),
+                static_cast<std::streamsize>(labelTable.size() * sizeof(std::int32_t)));
+    file_.seekp(static_cast<std::streamoff>(header_.rowLabelOffset));
+    file_.write(reinterpret_cast<const char*>(rowLabels.data()),
+                static_cast<std::streamsize>(rowLabels.size() * sizeof(std::uint32_t)));
+    if (!file_) {
+        throw std::runtime_error("Could not write binary dataset: " + tempPath_);
+    }
+}
+
+BinaryDatasetWriter::~BinaryDatasetWriter() {
+    if (!finished_) {
+        file_.close();
+        std::remove(tempPath_.c_str());
+    }
+}
+
+void BinaryDatasetWriter::append(const DataMatrix& block) {
+    if (block.empty()) {
+        return;
+    }
+    if (block.cols() != header_.cols) {
+        throw std::runtime_error("Inconsistent feature count in dataset");
+    }
+    if (rowsWritten_ + block.rows() > header_.rows) {
+        throw std::runtime_error("Mismatch between number of labels and data points");
+    }
+
+    // One contiguous segment per column block; the gaps are filled by later
+    // blocks, and the column padding reads back as zeros
+    for (std::size_t j = 0; j < block.cols(); ++j) {
+        const std::uint64_t offset = header_.dataOffset + (j * header_.columnStride + rowsWritten_) * sizeof(double);
+        file_.seekp(static_cast<std::streamoff>(offset));
+        file_.write(reinterpret_cast<const char*>(block.columnData(j)),
+                    static_cast<std::streamsize>(block.rows() * sizeof(double)));
+    }
+    if (!file_) {
+        throw std::runtime_error("Could not write binary dataset: " + tempPath_);
+    }
+    rowsWritten_ += block.rows();
+}
+
+void BinaryDatasetWriter::finish() {
+    if (rowsWritten_ != header_.rows) {
+        throw std::runtime_error("Mismatch between number of labels and data points");
+    }
+    file_.close();
+    std::error_code ec;
+    std::filesystem::resize_file(tempPath_, header_.fileSize, ec);
+    if (ec) {
+        throw std::runtime_error("Could not write binary dataset: " + tempPath_);
+    }
+
+    // The payload is hashed back from the mapping, one page at a time
+    {
+        MappedFile written(tempPath_);
+        header_.payloadChecksum = BinaryDataset::checksum(
+            written.data() + sizeof(BinaryDataset::Header), written.size() - sizeof(BinaryDataset::Header)
+        );
+    }
+    header_.headerChecksum = headerChecksum(header_);
+
+    file_.open(tempPath_, std::ios::in | std::ios::out | std::ios::binary);
+    file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    file_.close();
+    if (file_.fail()) {
+        throw std::runtime_error("Could not write binary dataset: " + tempPath_);
+    }
+    if (std::rename(tempPath_.c_str(), path_.c_str()) != 0) {
+        throw std::runtime_error("Could not replace binary dataset: " + path_);
+    }
+    finished_ = true;
+}
+
+} // namespace feature_selection
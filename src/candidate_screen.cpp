@@ -0,0 +1,119 @@
+#include "feature_selection/candidate_screen.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+
+namespace feature_selection {
+
+CandidateScreen::CandidateScreen(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    std::size_t sampleRows,
+    std::uint64_t seed
+)
+    : rows_(stratifiedRows(labels, std::min(sampleRows, data.rows()), seed)),
+      sample_(rows_.size(), data.cols()),
+      labels_(rows_.size()) {
+    for (std::size_t s = 0; s < rows_.size(); ++s) {
+        std::copy_n(data.rowData(rows_[s]), data.cols(), sample_.mutableRowData(s));
+        labels_[s] = labels[rows_[s]];
+    }
+    sample_.syncColumnsFromRows();
+}
+
+double CandidateScreen::score(const FeatureIndex* features, std::size_t featureCount) const {
+    if (labels_.empty()) {
+        return 0.0;
+    }
+    std::size_t correct = NearestNeighbor::leaveOneOutCorrect(sample_, labels_, features, featureCount);
+    return static_cast<double>(correct) / static_cast<double>(labels_.size());
+}
+
+std::vector<std::size_t> CandidateScreen::stratifiedRows(
+    const LabelVector& labels,
+    std::size_t count,
+    std::uint64_t seed
+) {
+    const std::size_t total = labels.size();
+    count = std::min(count, total);
+    
+    // Members of each class in ascending label order
+    std::map<Label, std::vector<std::size_t>> byLabel;
+    for (std::size_t i = 0; i < total; ++i) {
+        byLabel[labels[i]].push_back(i);
+    }
+    std::vector<std::vector<std::size_t>> classes;
+    for (auto& entry : byLabel) {
+        classes.push_back(std::move(entry.second));
+    }
+    
+    // Proportional quotas, at least one per class while the count allows;
+    // rows left over go to the largest remainders
+    std::vector<std::size_t> quotas(classes.size());
+    std::vector<std::pair<double, std::size_t>> remainders;
+    std::size_t assigned = 0;
+    for (std::size_t c = 0; c < classes.size(); ++c) {
+        double exact = static_cast<double>(count) * static_cast<double>(classes[c].size()) / static_cast<double>(total);
+        quotas[c] = static_cast<std::size_t>(exact);
+        if (quotas[c] == 0 && count >= classes.size()) {
+            quotas[c] = 1;
+        }
+        remainders.push_back({exact - static_cast<double>(quotas[c]), c});
+        assigned += quotas[c];
+    }
+    while (assigned > count) {
+        auto largest = std::max_element(quotas.begin(), quotas.end());
+        --*largest;
+        --assigned;
+    }
+    std::stable_sort(remainders.begin(), remainders.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+    for (std::size_t r = 0; assigned < count; r = (r + 1) % remainders.size()) {
+        std::size_t c = remainders[r].second;
+        if (quotas[c] < classes[c].size()) {
+            ++quotas[c];
+            ++assigned;
+        }
+    }
+    
+    std::mt19937_64 rng(seed);
+    std::vector<std::size_t> rows;
+    rows.reserve(count);
+    for (std::size_t c = 0; c < classes.size(); ++c) {
+        auto& members = classes[c];
+        // Partial Fisher-Yates: the first quota entries become the sample
+        for (std::size_t k = 0; k < quotas[c] && k < members.size(); ++k) {
+            std::uniform_int_distribution<std::size_t> pick(k, members.size() - 1);
+            std::swap(members[k], members[pick(rng)]);
+            rows.push_back(members[k]);
+        }
+    }
+    
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+std::vector<std::size_t> CandidateScreen::topCandidates(
+    const std::vector<double>& scores,
+    std::size_t candidateCount,
+    std::size_t k
+) {
+    std::vector<std::size_t> slots(candidateCount);
+    std::iota(slots.begin(), slots.end(), std::size_t(0));
+    k = std::min(k, candidateCount);
+    std::partial_sort(
+        slots.begin(),
+        slots.begin() + static_cast<std::ptrdiff_t>(k),
+        slots.end(),
+        [&scores](std::size_t a, std::size_t b) {
+            return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+        }
+    );
+    slots.resize(k);
+    return slots;
+}
+
+} // namespace feature_selection
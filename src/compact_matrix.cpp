@@ -0,0 +1,314 @@
+#include "feature_selection/compact_matrix.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// Same multiversioning as the double tiled engine
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define FEATURE_SELECTION_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define FEATURE_SELECTION_TARGET_CLONES
+#endif
+
+namespace feature_selection {
+
+namespace {
+
+constexpr std::size_t kQueryTile = 64;
+constexpr std::size_t kMinReferenceTile = 64;
+constexpr std::size_t kMaxReferenceTile = 4096;
+
+// Reference tile footprint (features x rows) targeted to stay in L2
+constexpr std::size_t kReferenceTileBytes = 256 * 1024;
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+std::size_t roundUpToPadding(std::size_t value) {
+    return (value + FeatureMatrix::kPadding - 1) / FeatureMatrix::kPadding * FeatureMatrix::kPadding;
+}
+
+FEATURE_SELECTION_TARGET_CLONES
+void accumulate(const float* column, std::size_t count, float query, float, float* distances) {
+    #pragma omp simd
+    for (std::size_t j = 0; j < count; ++j) {
+        float diff = column[j] - query;
+        distances[j] += diff * diff;
+    }
+}
+
+FEATURE_SELECTION_TARGET_CLONES
+void accumulate(const std::uint16_t* column, std::size_t count, std::uint16_t query, float weight, float* distances) {
+    const std::int32_t q = query;
+    #pragma omp simd
+    for (std::size_t j = 0; j < count; ++j) {
+        std::int32_t diff = static_cast<std::int32_t>(column[j]) - q;
+        distances[j] += weight * static_cast<float>(diff * diff);
+    }
+}
+
+FEATURE_SELECTION_TARGET_CLONES
+void accumulate(const std::uint8_t* column, std::size_t count, std::uint8_t query, float weight, float* distances) {
+    const std::int32_t q = query;
+    #pragma omp simd
+    for (std::size_t j = 0; j < count; ++j) {
+        std::int32_t diff = static_cast<std::int32_t>(column[j]) - q;
+        distances[j] += weight * static_cast<float>(diff * diff);
+    }
+}
+
+FEATURE_SELECTION_TARGET_CLONES
+float tileMinimum(const float* distances, std::size_t count) {
+    float best = kInfinity;
+    #pragma omp simd reduction(min:best)
+    for (std::size_t j = 0; j < count; ++j) {
+        best = std::min(best, distances[j]);
+    }
+    return best;
+}
+
+std::size_t referenceTileRows(std::size_t featureCount, std::size_t elementBytes) {
+    std::size_t rows = kReferenceTileBytes / (std::max<std::size_t>(1, featureCount) * elementBytes);
+    rows = std::max(kMinReferenceTile, std::min(kMaxReferenceTile, rows));
+    return rows / 16 * 16;
+}
+
+template <typename T>
+std::size_t countCorrectRange(
+    const T* base,
+    std::size_t stride,
+    const float* weights,
+    const LabelVector& labels,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t queryBegin,
+    std::size_t queryEnd
+) {
+    const std::size_t rows = labels.size();
+    const std::size_t tileRows = referenceTileRows(featureCount, sizeof(T));
+    std::size_t correct = 0;
+    
+    for (std::size_t q0 = queryBegin; q0 < queryEnd; q0 += kQueryTile) {
+        const std::size_t q1 = std::min(queryEnd, q0 + kQueryTile);
+        
+        float tileBest[kQueryTile];
+        std::size_t tileIndex[kQueryTile];
+        std::fill(tileBest, tileBest + kQueryTile, std::numeric_limits<float>::max());
+        std::fill(tileIndex, tileIndex + kQueryTile, std::size_t(0));
+        alignas(64) float distances[kMaxReferenceTile];
+        
+        for (std::size_t r0 = 0; r0 < rows; r0 += tileRows) {
+            const std::size_t count = std::min(rows, r0 + tileRows) - r0;
+            
+            for (std::size_t q = q0; q < q1; ++q) {
+                std::fill(distances, distances + count, 0.0f);
+                for (std::size_t k = 0; k < featureCount; ++k) {
+                    const T* column = base + features[k] * stride;
+                    accumulate(column + r0, count, column[q], weights[features[k]], distances);
+                }
+                
+                // A query is never its own neighbor
+                if (q >= r0 && q < r0 + count) {
+                    distances[q - r0] = kInfinity;
+                }
+                
+                float minimum = tileMinimum(distances, count);
+                if (minimum < tileBest[q - q0]) {
+                    std::size_t j = 0;
+                    while (distances[j] != minimum) {
+                        ++j;
+                    }
+                    tileBest[q - q0] = minimum;
+                    tileIndex[q - q0] = r0 + j;
+                }
+            }
+        }
+        
+        for (std::size_t q = q0; q < q1; ++q) {
+            if (labels[q] == labels[tileIndex[q - q0]]) {
+                correct++;
+            }
+        }
+    }
+    
+    return correct;
+}
+
+// Min-max quantization of one column onto 0..levels
+template <typename T>
+void quantizeColumn(
+    const double* column,
+    std::size_t rows,
+    double levels,
+    T* out,
+    double& scale,
+    double& offset
+) {
+    double low = std::numeric_limits<double>::max();
+    double high = std::numeric_limits<double>::lowest();
+    for (std::size_t i = 0; i < rows; ++i) {
+        low = std::min(low, column[i]);
+        high = std::max(high, column[i]);
+    }
+    offset = rows > 0 ? low : 0.0;
+    scale = high > low ? (high - low) / levels : 0.0;
+    
+    for (std::size_t i = 0; i < rows; ++i) {
+        double q = scale > 0.0 ? std::round((column[i] - offset) / scale) : 0.0;
+        out[i] = static_cast<T>(std::min(levels, std::max(0.0, q)));
+    }
+}
+
+} // namespace
+
+CompactMatrix::CompactMatrix(std::size_t rows, std::size_t cols, StoragePrecision precision)
+    : precision_(precision),
+      rows_(rows),
+      cols_(cols),
+      columnStride_(roundUpToPadding(rows)),
+      scales_(cols, 1.0),
+      offsets_(cols, 0.0),
+      weights_(cols, 1.0f) {
+    const std::size_t total = cols_ * columnStride_;
+    switch (precision_) {
+        case StoragePrecision::Float32: floats_.assign(total, 0.0f); break;
+        case StoragePrecision::Int16: words_.assign(total, 0); break;
+        case StoragePrecision::Int8: bytes_.assign(total, 0); break;
+        default: throw std::runtime_error("CompactMatrix needs a reduced precision");
+    }
+}
+
+CompactMatrix::CompactMatrix(const DataMatrix& data, StoragePrecision precision)
+    : CompactMatrix(data.rows(), data.cols(), precision) {
+    const long long cols = static_cast<long long>(cols_);
+    #pragma omp parallel for schedule(static)
+    for (long long jj = 0; jj < cols; ++jj) {
+        const std::size_t j = static_cast<std::size_t>(jj);
+        setColumn(j, data.columnData(j));
+    }
+}
+
+void CompactMatrix::setColumn(std::size_t j, const double* column) {
+    const std::size_t start = j * columnStride_;
+    switch (precision_) {
+        case StoragePrecision::Float32:
+            for (std::size_t i = 0; i < rows_; ++i) {
+                floats_[start + i] = static_cast<float>(column[i]);
+            }
+            return;
+        case StoragePrecision::Int16:
+            quantizeColumn(column, rows_, 32767.0, words_.data() + start, scales_[j], offsets_[j]);
+            break;
+        default:
+            quantizeColumn(column, rows_, 255.0, bytes_.data() + start, scales_[j], offsets_[j]);
+            break;
+    }
+    weights_[j] = static_cast<float>(scales_[j] * scales_[j]);
+}
+
+std::size_t CompactMatrix::storageBytes() const {
+    return floats_.size() * sizeof(float) + words_.size() * sizeof(std::uint16_t) + bytes_.size();
+}
+
+double CompactMatrix::value(std::size_t i, std::size_t j) const {
+    const std::size_t index = j * columnStride_ + i;
+    switch (precision_) {
+        case StoragePrecision::Float32: return floats_[index];
+        case StoragePrecision::Int16: return offsets_[j] + scales_[j] * words_[index];
+        default: return offsets_[j] + scales_[j] * bytes_[index];
+    }
+}
+
+std::size_t CompactMatrix::leaveOneOutCorrect(
+    const LabelVector& labels,
+    const FeatureIndex* features,
+    std::size_t featureCount
+) const {
+    if (labels.size() != rows_) {
+        return 0;
+    }
+    const long long tiles = static_cast<long long>((rows_ + kQueryTile - 1) / kQueryTile);
+    std::size_t correct = 0;
+    
+    #pragma omp parallel for schedule(dynamic) reduction(+:correct)
+    for (long long t = 0; t < tiles; ++t) {
+        const std::size_t q0 = static_cast<std::size_t>(t) * kQueryTile;
+        correct += leaveOneOutCorrect(labels, features, featureCount, q0, std::min(rows_, q0 + kQueryTile));
+    }
+    
+    return correct;
+}
+
+std::size_t CompactMatrix::leaveOneOutCorrect(
+    const LabelVector& labels,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t queryBegin,
+    std::size_t queryEnd
+) const {
+    if (labels.size() != rows_) {
+        return 0;
+    }
+    switch (precision_) {
+        case StoragePrecision::Float32:
+            return countCorrectRange(floats_.data(), columnStride_, weights_.data(), labels, features, featureCount, queryBegin, queryEnd);
+        case StoragePrecision::Int16:
+            return countCorrectRange(words_.data(), columnStride_, weights_.data(), labels, features, featureCount, queryBegin, queryEnd);
+        default:
+            return countCorrectRange(bytes_.data(), columnStride_, weights_.data(), labels, features, featureCount, queryBegin, queryEnd);
+    }
+}
+
+double CompactMatrix::leaveOneOutCrossValidation(const LabelVector& labels, const FeatureSet& featureSubset) const {
+    if (rows_ == 0 || labels.size() != rows_) {
+        return 0.0;
+    }
+    
+    std::vector<FeatureIndex> features;
+    for (FeatureIndex f = 0; f < cols_; ++f) {
+        if (featureSubset.empty() || featureSubset.count(f) > 0) {
+            features.push_back(f);
+        }
+    }
+    std::size_t correct = leaveOneOutCorrect(labels, features.data(), features.size());
+    return static_cast<double>(correct) / static_cast<double>(rows_);
+}
+
+std::vector<PrecisionCheck> CompactMatrix::validate(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    const std::vector<FeatureSet>& subsets
+) const {
+    std::vector<PrecisionCheck> checks;
+    checks.reserve(subsets.size());
+    for (const FeatureSet& subset : subsets) {
+        PrecisionCheck check;
+        check.subset = subset;
+        check.referenceAccuracy = NearestNeighbor::leaveOneOutCrossValidation(data, labels, subset);
+        check.compactAccuracy = leaveOneOutCrossValidation(labels, subset);
+        checks.push_back(check);
+    }
+    return checks;
+}
+
+const char* CompactMatrix::precisionName(StoragePrecision precision) {
+    switch (precision) {
+        case StoragePrecision::Float32: return "float32";
+        case StoragePrecision::Int16: return "int16";
+        case StoragePrecision::Int8: return "int8";
+        default: return "float64";
+    }
+}
+
+StoragePrecision CompactMatrix::parsePrecision(const std::string& name) {
+    for (StoragePrecision precision : {StoragePrecision::Float64, StoragePrecision::Float32,
+                                       StoragePrecision::Int16, StoragePrecision::Int8}) {
+        if (name == precisionName(precision)) {
+            return precision;
+        }
+    }
+    throw std::invalid_argument("Unknown storage precision '" + name + "'");
+}
+
+} // namespace feature_selection
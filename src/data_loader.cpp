@@ -1,10 +1,16 @@
 #include "feature_selection/data_loader.h"
-#include <fstream>
-#include <sstream>
-#include <stdexcept>
+#include "feature_selection/mapped_file.h"
+#include "feature_selection/binary_dataset.h"
+#include "feature_selection/metrics.h"
 #include <algorithm>
-#include <unordered_map>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
 #include <iomanip>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace feature_selection {
 
@@ -65,7 +71,7 @@ std::size_t DataLoader::getFeatureCount(const DataMatrix& data) {
     if (data.empty()) {
         return 0;
     }
-    return data[0].size();
+    return data.cols();
 }
 
 std::size_t DataLoader::getInstanceCount(const DataMatrix& data) {
@@ -118,183 +124,479 @@ DataMatrix DataLoader::extractFeatures(const DataMatrix& data, const FeatureSet&
         return DataMatrix();
     }
     
-    DataMatrix result;
-    result.reserve(data.size());
-    
-    for (const auto& dataPoint : data) {
-        DataPoint newPoint;
-        newPoint.reserve(features.size());
-        
-        for (FeatureIndex idx : features) {
-            if (idx < dataPoint.size()) {
-                newPoint.push_back(dataPoint[idx]);
-            }
+    // Out-of-range indices are skipped, as before
+    std::vector<FeatureIndex> selected;
+    selected.reserve(features.size());
+    for (FeatureIndex idx : features) {
+        if (idx < data.cols()) {
+            selected.push_back(idx);
         }
-        
-        result.push_back(newPoint);
     }
     
+    DataMatrix result(data.rows(), selected.size());
+    
+    // Whole columns are contiguous, so each selected feature is a single copy
+    for (std::size_t j = 0; j < selected.size(); ++j) {
+        std::copy_n(data.columnData(selected[j]), data.rows(), result.mutableColumnData(j));
+    }
+    result.syncRowsFromColumns();
+    
     return result;
 }
 
-// These are the new concurrent file reading methods
+// Parsing works directly on the memory-mapped file: chunks are aligned to
+// line boundaries, counted in parallel to assign row offsets, and then parsed
+// in parallel straight into the final matrix
 
-std::vector<std::vector<double>> DataLoader::readFileChunk(
-    const std::string& filename,
-    size_t startPos, 
-    size_t chunkSize
+namespace {
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char* skipSpaces(const char* pos, const char* end) {
+    while (pos < end && isSpace(*pos)) {
+        ++pos;
+    }
+    return pos;
+}
+
+inline const char* findLineEnd(const char* pos, const char* end) {
+    const void* newline = std::memchr(pos, '\n', static_cast<std::size_t>(end - pos));
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+} // namespace
+
+std::vector<DataLoader::TextChunk> DataLoader::splitIntoChunks(
+    const char* data,
+    std::size_t size,
+    std::size_t chunkCount
 ) {
-    std::vector<std::vector<double>> chunkData;
+    std::vector<TextChunk> chunks;
+    const char* end = data + size;
+    const char* pos = data;
+    const std::size_t targetSize = std::max<std::size_t>(1, size / std::max<std::size_t>(1, chunkCount));
     
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file: " + filename);
+    while (pos < end) {
+        const char* chunkEnd = (static_cast<std::size_t>(end - pos) <= targetSize) ? end : pos + targetSize;
+        
+        // Extend the chunk to the end of the line it stops in
+        if (chunkEnd < end) {
+            chunkEnd = findLineEnd(chunkEnd, end);
+            if (chunkEnd < end) {
+                ++chunkEnd;
+            }
+        }
+        
+        chunks.push_back({pos, chunkEnd, 0, 0});
+        pos = chunkEnd;
     }
     
-    file.seekg(startPos);
-    std::string line;
-    size_t bytesRead = 0;
+    return chunks;
+}
+
+std::size_t DataLoader::countRows(const char* begin, const char* end) {
+    std::size_t rows = 0;
+    const char* pos = begin;
     
-    // If not at the beginning of the file, discard the first (partial) line
-    if (startPos > 0) {
-        std::getline(file, line);
-        bytesRead += line.length() + 1; // +1 for newline character
+    while (pos < end) {
+        const char* lineEnd = findLineEnd(pos, end);
+        if (skipSpaces(pos, lineEnd) < lineEnd) {
+            ++rows;
+        }
+        pos = lineEnd + 1;
     }
     
-    // Read and process complete lines
-    while (bytesRead < chunkSize && std::getline(file, line)) {
-        bytesRead += line.length() + 1; // +1 for newline character
-        
-        std::vector<double> row;
-        std::istringstream iss(line);
-        double value;
-        
-        while (iss >> value) {
-            row.push_back(value);
+    return rows;
+}
+
+std::size_t DataLoader::countValuesInFirstRow(const char* begin, const char* end) {
+    const char* pos = begin;
+    
+    while (pos < end) {
+        const char* lineEnd = findLineEnd(pos, end);
+        std::size_t values = 0;
+        const char* cursor = skipSpaces(pos, lineEnd);
+        while (cursor < lineEnd) {
+            double ignored;
+            cursor = skipSpaces(parseNumber(cursor, lineEnd, ignored), lineEnd);
+            ++values;
         }
-        
-        if (!row.empty()) {
-            chunkData.push_back(row);
+        if (values > 0) {
+            return values;
         }
+        pos = lineEnd + 1;
     }
     
-    return chunkData;
+    return 0;
 }
 
-std::vector<std::vector<double>> DataLoader::readFileConcurrent(const std::string& filename) {
-    // Get file size
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file: " + filename);
+const char* DataLoader::parseNumber(const char* pos, const char* end, double& value) {
+    // from_chars rejects an explicit leading '+', which some exporters write
+    if (pos < end && *pos == '+') {
+        ++pos;
     }
     
-    const size_t fileSize = file.tellg();
-    file.close();
-    
-    // Determine optimal number of threads (not more than 8)
-    const unsigned int numThreads = std::min(8u, std::thread::hardware_concurrency());
-    const size_t chunkSize = fileSize / numThreads;
-    
-    // Prepare threads and futures
-    std::vector<std::future<std::vector<std::vector<double>>>> futures;
-    std::vector<std::vector<double>> result;
+    auto [next, ec] = std::from_chars(pos, end, value);
+    if (ec != std::errc() || (next < end && !isSpace(*next))) {
+        const char* tokenEnd = pos;
+        while (tokenEnd < end && !isSpace(*tokenEnd)) {
+            ++tokenEnd;
+        }
+        throw std::runtime_error("Invalid numeric value '" + std::string(pos, tokenEnd) + "'");
+    }
     
-    // Reserve space for the results based on an estimate
-    result.reserve(fileSize / 100); // Rough estimate, adjust based on avg line length
+    return next;
+}
+
+void DataLoader::parseChunk(const TextChunk& chunk, DataMatrix& data, LabelVector& labels) {
+    const std::size_t featureCount = data.cols();
+    std::size_t row = chunk.firstRow;
+    const char* pos = chunk.begin;
     
-    // Create a thread for each chunk
-    for (unsigned int i = 0; i < numThreads; ++i) {
-        size_t startPos = i * chunkSize;
-        size_t endPos = (i == numThreads - 1) ? fileSize : startPos + chunkSize;
-        size_t actualChunkSize = endPos - startPos;
+    while (pos < chunk.end) {
+        const char* lineEnd = findLineEnd(pos, chunk.end);
+        const char* cursor = skipSpaces(pos, lineEnd);
+        pos = lineEnd + 1;
+        
+        // Skip empty or blank lines
+        if (cursor == lineEnd) {
+            continue;
+        }
         
-        // Use async to launch threads
-        futures.push_back(std::async(std::launch::async, 
-            [filename, startPos, actualChunkSize]() {
-                return readFileChunk(filename, startPos, actualChunkSize);
+        // First column is the class label
+        double label;
+        cursor = skipSpaces(parseNumber(cursor, lineEnd, label), lineEnd);
+        labels[row] = static_cast<Label>(label);
+        
+        // Remaining columns are features, written straight into the matrix
+        double* values = data.mutableRowData(row);
+        for (std::size_t j = 0; j < featureCount; ++j) {
+            if (cursor == lineEnd) {
+                throw std::runtime_error("Inconsistent feature count in dataset");
             }
-        ));
+            cursor = skipSpaces(parseNumber(cursor, lineEnd, values[j]), lineEnd);
+        }
+        if (cursor != lineEnd) {
+            throw std::runtime_error("Inconsistent feature count in dataset");
+        }
+        
+        ++row;
     }
-    
-    // Collect results from all threads
-    for (auto& future : futures) {
-        auto chunkData = future.get();
-        result.insert(result.end(), chunkData.begin(), chunkData.end());
+}
+
+std::string DataLoader::defaultCachePath(const std::string& filename, NormalizationMethod normalization) {
+    if (normalization == NormalizationMethod::None) {
+        return filename + ".fsbin";
     }
-    
-    return result;
+    return filename + "." + Normalizer::methodName(normalization) + ".fsbin";
 }
 
-std::tuple<DataMatrix, LabelVector> DataLoader::processRawData(
-    const std::vector<std::vector<double>>& rawData
-) {
-    DataMatrix data;
+LabelVector DataLoader::parseLabels(const char* begin, const char* end) {
     LabelVector labels;
+    const char* pos = begin;
     
-    // Reserve space for efficiency
-    data.reserve(rawData.size());
-    labels.reserve(rawData.size());
-    
-    // Process each row of the raw data
-    for (const auto& row : rawData) {
-        if (row.empty()) {
+    while (pos < end) {
+        const char* lineEnd = findLineEnd(pos, end);
+        const char* cursor = skipSpaces(pos, lineEnd);
+        pos = lineEnd + 1;
+        if (cursor == lineEnd) {
             continue;
         }
         
-        // First column is the class label
-        labels.push_back(static_cast<Label>(row[0]));
+        double label;
+        parseNumber(cursor, lineEnd, label);
+        labels.push_back(static_cast<Label>(label));
+    }
+    
+    return labels;
+}
+
+void DataLoader::convertToBinary(
+    const std::string& filename,
+    const std::string& binaryPath,
+    std::size_t chunkBytes
+) {
+    try {
+        Metrics::ScopedTimer parseTimer(Phase::Parse);
+        MappedFile file(filename);
+        file.adviseSequential();
+        Metrics::add(Counter::BytesParsed, file.size());
         
-        // Remaining columns are features
-        DataPoint point;
-        point.reserve(row.size() - 1);
+        const char* begin = file.data();
+        const char* end = begin + file.size();
+        const std::size_t valueCount = countValuesInFirstRow(begin, end);
+        const std::size_t featureCount = valueCount == 0 ? 0 : valueCount - 1;
         
-        for (size_t i = 1; i < row.size(); ++i) {
-            point.push_back(row[i]);
-        }
+        // The labels lay out the file, so they are read in a first pass
+        BinaryDatasetWriter writer(
+            binaryPath,
+            parseLabels(begin, end),
+            featureCount,
+            std::filesystem::file_size(filename),
+            static_cast<std::int64_t>(std::filesystem::last_write_time(filename).time_since_epoch().count())
+        );
         
-        data.push_back(point);
+        // Then one window of text at a time is parsed (in parallel, like a
+        // whole file) and appended as column segments
+        const std::size_t windows = std::max<std::size_t>(1, file.size() / std::max<std::size_t>(1, chunkBytes));
+        for (const TextChunk& window : splitIntoChunks(begin, file.size(), windows)) {
+            auto [block, blockLabels] = parseText(window.begin, window.end);
+            if (!block.empty() && block.cols() != featureCount) {
+                throw std::runtime_error("Inconsistent feature count in dataset");
+            }
+            writer.append(block);
+        }
+        writer.finish();
+    }
+    catch (const std::exception& e) {
+        throw std::runtime_error("Failed to convert dataset '" + filename + "': " + e.what());
     }
-    
-    return {data, labels};
 }
 
-bool DataLoader::verifyDatasetConsistency(const DataMatrix& data) {
-    if (data.empty()) {
-        return true;
+BinaryDatasetFile::~BinaryDatasetFile() {
+    if (temporary_ && !path_.empty()) {
+        std::remove(path_.c_str());
+    }
+}
+
+BinaryDatasetFile::BinaryDatasetFile(BinaryDatasetFile&& other) noexcept
+    : path_(std::move(other.path_)), temporary_(other.temporary_) {
+    other.path_.clear();
+    other.temporary_ = false;
+}
+
+BinaryDatasetFile DataLoader::binaryDatasetFor(const std::string& filename, const LoadOptions& options) {
+    if (BinaryDataset::isBinaryDataset(filename)) {
+        return BinaryDatasetFile(filename, false);
+    }
+    
+    std::string cachePath = options.cachePath.empty() ? defaultCachePath(filename) : options.cachePath;
+    if (!options.useBinaryCache) {
+        BinaryDatasetFile converted(BinaryDataset::temporaryPath(cachePath), true);
+        convertToBinary(filename, converted.path());
+        return converted;
     }
     
-    std::size_t featureCount = data[0].size();
-    return std::all_of(data.begin(), data.end(), 
-        [featureCount](const DataPoint& point) {
-            return point.size() == featureCount;
+    std::error_code ec;
+    if (std::filesystem::exists(cachePath, ec) &&
+        BinaryDataset::fileVersion(cachePath) == BinaryDataset::kVersion) {
+        try {
+            BinaryDataset binary(cachePath, options.verifyChecksum);
+            std::int64_t sourceModified = static_cast<std::int64_t>(
+                std::filesystem::last_write_time(filename).time_since_epoch().count()
+            );
+            if (binary.sourceSize() == std::filesystem::file_size(filename) &&
+                binary.sourceModified() == sourceModified &&
+                binary.normalizationMethod() == NormalizationMethod::None) {
+                return BinaryDatasetFile(cachePath, false);
+            }
+        } catch (const std::exception&) {
+            // Converted again below
         }
-    );
+    }
+    
+    convertToBinary(filename, cachePath);
+    return BinaryDatasetFile(cachePath, false);
 }
 
-// This is the updated loadDataset method that uses concurrent file reading
-std::tuple<DataMatrix, LabelVector> DataLoader::loadDataset(const std::string& filename) {
+namespace {
+
+// Count the file a load was served from towards load throughput
+void countLoaded(const std::string& path) {
+    if (Metrics::enabled()) {
+        std::error_code ec;
+        const std::uintmax_t size = std::filesystem::file_size(path, ec);
+        Metrics::add(Counter::BytesLoaded, ec ? 0 : static_cast<std::uint64_t>(size));
+    }
+}
+
+} // namespace
+
+std::tuple<DataMatrix, LabelVector> DataLoader::loadDataset(
+    const std::string& filename,
+    const LoadOptions& options
+) {
+    Metrics::ScopedTimer loadTimer(Phase::Load);
     try {
-        // Read the data concurrently
-        auto rawData = readFileConcurrent(filename);
+        // Binary datasets are mapped and copied column by column; raw ones
+        // are normalized on request, normalized ones only match their method
+        if (BinaryDataset::isBinaryDataset(filename)) {
+            BinaryDataset binary(filename, options.verifyChecksum);
+            DataMatrix data = binary.toMatrix();
+            if (options.normalization != binary.normalizationMethod()) {
+                if (binary.normalizationMethod() != NormalizationMethod::None) {
+                    throw std::runtime_error(
+                        std::string("binary dataset is already normalized (") +
+                        Normalizer::methodName(binary.normalizationMethod()) + ")"
+                    );
+                }
+                Normalizer::normalize(data, options.normalization);
+            }
+            countLoaded(filename);
+            return {std::move(data), binary.labels()};
+        }
+        
+        if (!options.useBinaryCache) {
+            auto [data, labels] = parseTextFile(filename);
+            countLoaded(filename);
+            Normalizer::normalize(data, options.normalization);
+            return {std::move(data), std::move(labels)};
+        }
         
-        // Process raw data into features and labels
-        auto [data, labels] = processRawData(rawData);
+        std::string cachePath = options.cachePath.empty()
+            ? defaultCachePath(filename, options.normalization) : options.cachePath;
+        std::uint64_t sourceSize = std::filesystem::file_size(filename);
+        std::int64_t sourceModified = static_cast<std::int64_t>(
+            std::filesystem::last_write_time(filename).time_since_epoch().count()
+        );
         
-        // Verify data consistency
-        if (!verifyDatasetConsistency(data)) {
-            throw std::runtime_error("Inconsistent feature count in dataset");
+        // Use the cache only if it was written from this exact version of the
+        // text file, normalized the same way, in the current format
+        std::error_code ec;
+        if (std::filesystem::exists(cachePath, ec) &&
+            BinaryDataset::fileVersion(cachePath) == BinaryDataset::kVersion) {
+            try {
+                BinaryDataset binary(cachePath, options.verifyChecksum);
+                if (binary.sourceSize() == sourceSize && binary.sourceModified() == sourceModified &&
+                    binary.normalizationMethod() == options.normalization) {
+                    countLoaded(cachePath);
+                    return {binary.toMatrix(), binary.labels()};
+                }
+            } catch (const std::exception&) {
+                // Stale or corrupted caches are rebuilt below
+            }
+        }
+        
+        auto [data, labels] = parseTextFile(filename);
+        countLoaded(filename);
+        NormalizationParams normalization = Normalizer::normalize(data, options.normalization);
+        
+        try {
+            BinaryDataset::write(cachePath, data, labels, sourceSize, sourceModified, normalization);
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: could not write binary cache: " << e.what() << std::endl;
         }
         
-        // Verify labels and data points match
-        if (labels.size() != data.size()) {
-            throw std::runtime_error("Mismatch between number of labels and data points");
+        return {std::move(data), std::move(labels)};
+    }
+    catch (const std::exception& e) {
+        throw std::runtime_error("Failed to load dataset '" + filename + "': " + e.what());
+    }
+}
+
+std::tuple<CompactMatrix, LabelVector> DataLoader::loadCompactDataset(
+    const std::string& filename,
+    StoragePrecision precision,
+    const LoadOptions& options
+) {
+    Metrics::ScopedTimer loadTimer(Phase::Load);
+    try {
+        // Text is converted into the unnormalized binary form first, so
+        // the columns can be normalized and quantized straight from the
+        // mapping, one at a time
+        const BinaryDatasetFile source = binaryDatasetFor(filename, options);
+        BinaryDataset binary(source.path(), options.verifyChecksum);
+        NormalizationMethod method = options.normalization;
+        if (method != binary.normalizationMethod()) {
+            if (binary.normalizationMethod() != NormalizationMethod::None) {
+                throw std::runtime_error(
+                    std::string("binary dataset is already normalized (") +
+                    Normalizer::methodName(binary.normalizationMethod()) + ")"
+                );
+            }
+        } else {
+            method = NormalizationMethod::None;
         }
         
-        return {data, labels};
+        const std::size_t rows = binary.rows();
+        CompactMatrix compact(rows, binary.cols(), precision);
+        const long long cols = static_cast<long long>(binary.cols());
+        #pragma omp parallel
+        {
+            std::vector<double> column(rows);
+            #pragma omp for schedule(dynamic)
+            for (long long jj = 0; jj < cols; ++jj) {
+                const std::size_t j = static_cast<std::size_t>(jj);
+                std::copy(binary.columnData(j), binary.columnData(j) + rows, column.begin());
+                double center;
+                double scale;
+                Normalizer::normalizeColumn(column.data(), rows, method, center, scale);
+                compact.setColumn(j, column.data());
+            }
+        }
+        countLoaded(source.path());
+        return {std::move(compact), binary.labels()};
     }
     catch (const std::exception& e) {
         throw std::runtime_error("Failed to load dataset '" + filename + "': " + e.what());
     }
 }
 
+std::tuple<DataMatrix, LabelVector> DataLoader::parseTextFile(const std::string& filename) {
+    Metrics::ScopedTimer parseTimer(Phase::Parse);
+    MappedFile file(filename);
+    file.adviseSequential();
+    Metrics::add(Counter::BytesParsed, file.size());
+    
+    return parseText(file.data(), file.data() + file.size());
+}
+
+std::tuple<DataMatrix, LabelVector> DataLoader::parseText(const char* begin, const char* end) {
+    // Values per row (label included) come from the first non-blank line
+    std::size_t valueCount = countValuesInFirstRow(begin, end);
+    if (valueCount == 0) {
+        return {DataMatrix(), LabelVector()};
+    }
+    
+    const std::size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    auto chunks = splitIntoChunks(begin, static_cast<std::size_t>(end - begin), numThreads);
+    
+    // Pass 1: count rows per chunk concurrently, then assign row offsets
+    std::vector<std::future<std::size_t>> counts;
+    for (const auto& chunk : chunks) {
+        counts.push_back(std::async(std::launch::async, 
+            [chunk]() { return countRows(chunk.begin, chunk.end); }
+        ));
+    }
+    
+    std::size_t totalRows = 0;
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+        chunks[c].firstRow = totalRows;
+        chunks[c].rowCount = counts[c].get();
+        totalRows += chunks[c].rowCount;
+    }
+    
+    // Pass 2: parse every chunk concurrently into its rows of the matrix
+    DataMatrix data(totalRows, valueCount - 1);
+    LabelVector labels(totalRows);
+    
+    std::vector<std::future<void>> parsers;
+    for (const auto& chunk : chunks) {
+        parsers.push_back(std::async(std::launch::async, 
+            [&data, &labels, chunk]() { parseChunk(chunk, data, labels); }
+        ));
+    }
+    
+    // Wait for every parser before rethrowing, since they all write into data
+    std::exception_ptr failure;
+    for (auto& parser : parsers) {
+        try {
+            parser.get();
+        } catch (...) {
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    
+    data.syncColumnsFromRows();
+    
+    return {std::move(data), std::move(labels)};
+}
+
 } // namespace feature_selection
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "feature_selection/distance_cache.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+
+namespace feature_selection {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+std::size_t paddedStride(std::size_t rows) {
+    return (rows + FeatureMatrix::kPadding - 1) / FeatureMatrix::kPadding * FeatureMatrix::kPadding;
+}
+
+} // namespace
+
+DistanceCache::DistanceCache(const DataMatrix& data, const LabelVector& labels)
+    : data_(data),
+      labels_(labels),
+      rows_(data.rows()),
+      stride_(paddedStride(data.rows())),
+      distances_(rows_ * stride_, 0.0) {
+    for (std::size_t i = 0; i < rows_; ++i) {
+        distances_[i * stride_ + i] = kInfinity;
+    }
+}
+
+std::size_t DistanceCache::requiredBytes(std::size_t instances) {
+    return instances * paddedStride(instances) * sizeof(double);
+}
+
+void DistanceCache::reset(const FeatureSet& features) {
+    std::fill(distances_.begin(), distances_.end(), 0.0);
+    for (std::size_t i = 0; i < rows_; ++i) {
+        distances_[i * stride_ + i] = kInfinity;
+    }
+    features_.clear();
+    for (FeatureIndex feature : features) {
+        if (feature < data_.cols()) {
+            applyFeature(feature, 1.0);
+            features_.insert(feature);
+        }
+    }
+    removalsSinceRefresh_ = 0;
+}
+
+void DistanceCache::restore(
+    const FeatureSet& features,
+    std::vector<double> distances,
+    std::size_t removalsSinceRefresh
+) {
+    if (distances.size() != distances_.size()) {
+        throw std::runtime_error("Saved distance cache does not match the dataset");
+    }
+    features_ = features;
+    distances_ = std::move(distances);
+    removalsSinceRefresh_ = removalsSinceRefresh;
+}
+
+void DistanceCache::applyFeature(FeatureIndex feature, double sign) {
+    const double* column = data_.columnData(feature);
+    const long long n = static_cast<long long>(rows_);
+    
+    #pragma omp parallel for schedule(static)
+    for (long long ii = 0; ii < n; ++ii) {
+        std::size_t i = static_cast<std::size_t>(ii);
+        double* row = distances_.data() + i * stride_;
+        const double query = column[i];
+        
+        // Clamping at zero keeps round-off from producing negative distances
+        #pragma omp simd
+        for (std::size_t j = 0; j < rows_; ++j) {
+            double diff = column[j] - query;
+            row[j] = std::max(0.0, row[j] + sign * (diff * diff));
+        }
+    }
+}
+
+void DistanceCache::commitAddition(FeatureIndex feature) {
+    applyFeature(feature, 1.0);
+    features_.insert(feature);
+}
+
+void DistanceCache::commitRemoval(FeatureIndex feature) {
+    features_.erase(feature);
+    
+    if (++removalsSinceRefresh_ >= refreshInterval_) {
+        // Bound the drift from repeated subtraction with an exact rebuild
+        FeatureSet remaining = features_;
+        reset(remaining);
+    } else {
+        applyFeature(feature, -1.0);
+    }
+}
+
+std::size_t DistanceCache::nearestRow(std::size_t i, const double* column, double sign) const {
+    const double* row = distances_.data() + i * stride_;
+    double best = kInfinity;
+    
+    // First pass finds the minimum with a vectorized reduction, the second
+    // recomputes the same values to find the lowest index that attains it
+    if (column != nullptr) {
+        const double query = column[i];
+        #pragma omp simd reduction(min:best)
+        for (std::size_t j = 0; j < rows_; ++j) {
+            double diff = column[j] - query;
+            best = std::min(best, std::max(0.0, row[j] + sign * (diff * diff)));
+        }
+        for (std::size_t j = 0; j < rows_; ++j) {
+            double diff = column[j] - query;
+            if (std::max(0.0, row[j] + sign * (diff * diff)) == best) {
+                return j;
+            }
+        }
+    } else {
+        #pragma omp simd reduction(min:best)
+        for (std::size_t j = 0; j < rows_; ++j) {
+            best = std::min(best, row[j]);
+        }
+        for (std::size_t j = 0; j < rows_; ++j) {
+            if (row[j] == best) {
+                return j;
+            }
+        }
+    }
+    
+    // Only reached with a single instance, which is then its own neighbor
+    return 0;
+}
+
+std::vector<std::size_t> DistanceCache::evaluateCandidates(
+    const std::vector<FeatureIndex>& candidates,
+    double sign
+) const {
+    const std::size_t candidateCount = candidates.size();
+    const long long n = static_cast<long long>(rows_);
+    std::vector<std::size_t> correct(candidateCount, 0);
+    
+    // Rows on the outside: each cached row is read once from memory and then
+    // reused from cache for every candidate column
+    #pragma omp parallel
+    {
+        std::vector<std::size_t> localCorrect(candidateCount, 0);
+        
+        #pragma omp for schedule(dynamic, 16)
+        for (long long ii = 0; ii < n; ++ii) {
+            std::size_t i = static_cast<std::size_t>(ii);
+            for (std::size_t c = 0; c < candidateCount; ++c) {
+                std::size_t nearest = nearestRow(i, data_.columnData(candidates[c]), sign);
+                if (labels_[nearest] == labels_[i]) {
+                    localCorrect[c]++;
+                }
+            }
+        }
+        
+        #pragma omp critical
+        {
+            for (std::size_t c = 0; c < candidateCount; ++c) {
+                correct[c] += localCorrect[c];
+            }
+        }
+    }
+    
+    return correct;
+}
+
+std::vector<std::size_t> DistanceCache::evaluateAdditions(
+    const std::vector<FeatureIndex>& candidates
+) const {
+    return evaluateCandidates(candidates, 1.0);
+}
+
+std::vector<std::size_t> DistanceCache::evaluateRemovals(
+    const std::vector<FeatureIndex>& candidates
+) const {
+    return evaluateCandidates(candidates, -1.0);
+}
+
+std::size_t DistanceCache::evaluateCurrent() const {
+    const long long n = static_cast<long long>(rows_);
+    std::size_t correct = 0;
+    
+    #pragma omp parallel for schedule(dynamic, 16) reduction(+:correct)
+    for (long long ii = 0; ii < n; ++ii) {
+        std::size_t i = static_cast<std::size_t>(ii);
+        if (labels_[nearestRow(i, nullptr, 1.0)] == labels_[i]) {
+            correct++;
+        }
+    }
+    
+    return correct;
+}
+
+} // namespace feature_selection
@@ -0,0 +1,286 @@
+#include "feature_selection/distance_kernels.h"
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FEATURE_SELECTION_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace feature_selection {
+
+namespace {
+
+struct KernelTable {
+    DistanceKernels::SimdLevel level;
+    double (*contiguous)(const double*, const double*, std::size_t);
+    double (*indexed)(const double*, const double*, const FeatureIndex*, std::size_t);
+};
+
+// Every level sums in the same order, so results do not depend on the
+// dispatch: squared difference i goes into partial sum i % kLanes, in
+// increasing i, and the partial sums are combined by combineLanes. The
+// file is built with -ffp-contract=off and the kernels multiply and add
+// separately, so no level rounds through a fused multiply-add either.
+constexpr std::size_t kLanes = 8;
+
+double combineLanes(const double* lanes) {
+    return ((lanes[0] + lanes[4]) + (lanes[2] + lanes[6])) + ((lanes[1] + lanes[5]) + (lanes[3] + lanes[7]));
+}
+
+// ---------------------------------------------------------------------------
+// Scalar fallback
+// ---------------------------------------------------------------------------
+
+double contiguousScalar(const double* a, const double* b, std::size_t count) {
+    double lanes[kLanes] = {};
+    std::size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            double d = a[i + lane] - b[i + lane];
+            lanes[lane] += d * d;
+        }
+    }
+    for (; i < count; ++i) {
+        double d = a[i] - b[i];
+        lanes[i % kLanes] += d * d;
+    }
+    return combineLanes(lanes);
+}
+
+double indexedScalar(const double* a, const double* b, const FeatureIndex* indices, std::size_t count) {
+    double lanes[kLanes] = {};
+    std::size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            double d = a[indices[i + lane]] - b[indices[i + lane]];
+            lanes[lane] += d * d;
+        }
+    }
+    for (; i < count; ++i) {
+        double d = a[indices[i]] - b[indices[i]];
+        lanes[i % kLanes] += d * d;
+    }
+    return combineLanes(lanes);
+}
+
+#ifdef FEATURE_SELECTION_X86_DISPATCH
+
+// ---------------------------------------------------------------------------
+// SSE2 (2 doubles per vector, no gather instruction; four vectors of lanes)
+// ---------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+double contiguousSSE2(const double* a, const double* b, std::size_t count) {
+    __m128d acc[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+    std::size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (std::size_t v = 0; v < 4; ++v) {
+            __m128d d = _mm_sub_pd(_mm_loadu_pd(a + i + 2 * v), _mm_loadu_pd(b + i + 2 * v));
+            acc[v] = _mm_add_pd(acc[v], _mm_mul_pd(d, d));
+        }
+    }
+    double lanes[kLanes];
+    for (std::size_t v = 0; v < 4; ++v) {
+        _mm_storeu_pd(lanes + 2 * v, acc[v]);
+    }
+    for (; i < count; ++i) {
+        double d = a[i] - b[i];
+        lanes[i % kLanes] += d * d;
+    }
+    return combineLanes(lanes);
+}
+
+__attribute__((target("sse2")))
+double indexedSSE2(const double* a, const double* b, const FeatureIndex* indices, std::size_t count) {
+    __m128d acc[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+    std::size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (std::size_t v = 0; v < 4; ++v) {
+            const FeatureIndex* idx = indices + i + 2 * v;
+            __m128d va = _mm_set_pd(a[idx[1]], a[idx[0]]);
+            __m128d vb = _mm_set_pd(b[idx[1]], b[idx[0]]);
+            __m128d d = _mm_sub_pd(va, vb);
+            acc[v] = _mm_add_pd(acc[v], _mm_mul_pd(d, d));
+        }
+    }
+    double lanes[kLanes];
+    for (std::size_t v = 0; v < 4; ++v) {
+        _mm_storeu_pd(lanes + 2 * v, acc[v]);
+    }
+    for (; i < count; ++i) {
+        double d = a[indices[i]] - b[indices[i]];
+        lanes[i % kLanes] += d * d;
+    }
+    return combineLanes(lanes);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 (4 doubles per vector, hardware gather; two vectors of lanes)
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+double contiguousAVX2(const double* a, const double* b, std::size_t count) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+    }
+    double lanes[kLanes];
+    _mm256_storeu_pd(lanes, acc0);
+    _mm256_storeu_pd(lanes + 4, acc1);
+    for (; i < count; ++i) {
+        double d = a[i] - b[i];
+        lanes[i % kLanes] += d * d;
+    }
+    return combineLanes(lanes);
+}
+
+__attribute__((target("avx2")))
+double indexedAVX2(const double* a, const double* b, const FeatureIndex* indices, std::size_t count) {
+    static_assert(sizeof(FeatureIndex) == sizeof(long long), "gather expects 64-bit indices");
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        __m256i idx0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+        __m256i idx1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i + 4));
+        __m256d d0 = _mm256_sub_pd(_mm256_i64gather_pd(a, idx0, 8), _mm256_i64gather_pd(b, idx0, 8));
+        __m256d d1 = _mm256_sub_pd(_mm256_i64gather_pd(a, idx1, 8), _mm256_i64gather_pd(b, idx1, 8));
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+    }
+    double lanes[kLanes];
+    _mm256_storeu_pd(lanes, acc0);
+    _mm256_storeu_pd(lanes + 4, acc1);
+    for (; i < count; ++i) {
+        double d = a[indices[i]] - b[indices[i]];
+        lanes[i % kLanes] += d * d;
+    }
+    return combineLanes(lanes);
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512F (8 doubles per vector, one vector of lanes, masked tails)
+// ---------------------------------------------------------------------------
+
+// Summed through memory: _mm512_reduce_add_pd and _mm512_extractf64x4_pd
+// start from an undefined vector, which GCC 12 reports as uninitialized.
+// Masked-off lanes add +0.0, which leaves a sum of squares unchanged.
+__attribute__((target("avx512f")))
+double horizontalSum512(__m512d v) {
+    alignas(64) double lanes[kLanes];
+    _mm512_store_pd(lanes, v);
+    return combineLanes(lanes);
+}
+
+__attribute__((target("avx512f")))
+double contiguousAVX512(const double* a, const double* b, std::size_t count) {
+    __m512d acc = _mm512_setzero_pd();
+    for (std::size_t i = 0; i < count; i += kLanes) {
+        std::size_t remaining = count - i;
+        __mmask8 mask = remaining >= kLanes ? static_cast<__mmask8>(0xFF)
+                                            : static_cast<__mmask8>((1u << remaining) - 1);
+        __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a + i), _mm512_maskz_loadu_pd(mask, b + i));
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(d, d));
+    }
+    return horizontalSum512(acc);
+}
+
+__attribute__((target("avx512f")))
+double indexedAVX512(const double* a, const double* b, const FeatureIndex* indices, std::size_t count) {
+    __m512d acc = _mm512_setzero_pd();
+    for (std::size_t i = 0; i < count; i += kLanes) {
+        std::size_t remaining = count - i;
+        __mmask8 mask = remaining >= kLanes ? static_cast<__mmask8>(0xFF)
+                                            : static_cast<__mmask8>((1u << remaining) - 1);
+        __m512i idx = _mm512_maskz_loadu_epi64(mask, indices + i);
+        __m512d va = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), mask, idx, a, 8);
+        __m512d vb = _mm512_mask_i64gather_pd(_mm512_setzero_pd(), mask, idx, b, 8);
+        __m512d d = _mm512_sub_pd(va, vb);
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(d, d));
+    }
+    return horizontalSum512(acc);
+}
+
+#endif // FEATURE_SELECTION_X86_DISPATCH
+
+const KernelTable kScalarTable = {DistanceKernels::SimdLevel::Scalar, contiguousScalar, indexedScalar};
+#ifdef FEATURE_SELECTION_X86_DISPATCH
+const KernelTable kSSE2Table = {DistanceKernels::SimdLevel::SSE2, contiguousSSE2, indexedSSE2};
+const KernelTable kAVX2Table = {DistanceKernels::SimdLevel::AVX2, contiguousAVX2, indexedAVX2};
+const KernelTable kAVX512Table = {DistanceKernels::SimdLevel::AVX512, contiguousAVX512, indexedAVX512};
+#endif
+
+const KernelTable* tableFor(DistanceKernels::SimdLevel level) {
+    switch (level) {
+#ifdef FEATURE_SELECTION_X86_DISPATCH
+        case DistanceKernels::SimdLevel::AVX512: return &kAVX512Table;
+        case DistanceKernels::SimdLevel::AVX2: return &kAVX2Table;
+        case DistanceKernels::SimdLevel::SSE2: return &kSSE2Table;
+#endif
+        default: return &kScalarTable;
+    }
+}
+
+std::atomic<const KernelTable*>& activeTable() {
+    static std::atomic<const KernelTable*> table{tableFor(DistanceKernels::detectLevel())};
+    return table;
+}
+
+} // namespace
+
+DistanceKernels::SimdLevel DistanceKernels::detectLevel() {
+#ifdef FEATURE_SELECTION_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SimdLevel::SSE2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+DistanceKernels::SimdLevel DistanceKernels::activeLevel() {
+    return activeTable().load(std::memory_order_relaxed)->level;
+}
+
+DistanceKernels::SimdLevel DistanceKernels::setLevel(SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(detectLevel())) {
+        level = detectLevel();
+    }
+    activeTable().store(tableFor(level), std::memory_order_relaxed);
+    return activeLevel();
+}
+
+const char* DistanceKernels::levelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return "AVX-512";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE2: return "SSE2";
+        default: return "scalar";
+    }
+}
+
+double DistanceKernels::squaredDistance(const double* a, const double* b, std::size_t count) {
+    return activeTable().load(std::memory_order_relaxed)->contiguous(a, b, count);
+}
+
+double DistanceKernels::squaredDistanceIndexed(
+    const double* a,
+    const double* b,
+    const FeatureIndex* indices,
+    std::size_t count
+) {
+    return activeTable().load(std::memory_order_relaxed)->indexed(a, b, indices, count);
+}
+
+} // namespace feature_selection
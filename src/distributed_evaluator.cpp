@@ -0,0 +1,411 @@
+#include "feature_selection/distributed_evaluator.h"
+#include "feature_selection/search_checkpoint.h"
+#include "feature_selection/tiled_nearest_neighbor.h"
+#include "feature_selection/work_scheduler.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+
+#if defined(__unix__)
+#define FEATURE_SELECTION_HAVE_SOCKETS 1
+#include <poll.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace feature_selection {
+
+#ifdef FEATURE_SELECTION_HAVE_SOCKETS
+
+namespace {
+
+// Frame types; every frame is (type, payload words, payload...)
+constexpr std::uint64_t kHello = 1;     // worker -> coordinator: rows, cols, checksum
+constexpr std::uint64_t kTask = 2;      // coordinator -> worker: unit, begin, end, k, features...
+constexpr std::uint64_t kResult = 3;    // worker -> coordinator: unit, correct
+constexpr std::uint64_t kShutdown = 4;  // coordinator -> worker
+
+// Longest payload accepted, so a corrupted length cannot exhaust memory
+constexpr std::uint64_t kMaxPayloadWords = std::uint64_t(1) << 24;
+
+bool writeAll(int socket, const void* data, std::size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::send(socket, bytes, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool readAll(int socket, void* data, std::size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t received = ::recv(socket, bytes, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        bytes += received;
+        size -= static_cast<std::size_t>(received);
+    }
+    return true;
+}
+
+bool sendMessage(int socket, std::uint64_t type, const std::vector<std::uint64_t>& payload) {
+    std::vector<std::uint64_t> frame;
+    frame.reserve(payload.size() + 2);
+    frame.push_back(type);
+    frame.push_back(payload.size());
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return writeAll(socket, frame.data(), frame.size() * sizeof(std::uint64_t));
+}
+
+bool receiveMessage(int socket, std::uint64_t& type, std::vector<std::uint64_t>& payload) {
+    std::uint64_t header[2];
+    if (!readAll(socket, header, sizeof(header)) || header[1] > kMaxPayloadWords) {
+        return false;
+    }
+    type = header[0];
+    payload.resize(static_cast<std::size_t>(header[1]));
+    return readAll(socket, payload.data(), payload.size() * sizeof(std::uint64_t));
+}
+
+sockaddr_un socketAddress(const std::string& path) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Worker
+// ---------------------------------------------------------------------------
+
+DistributedWorker::DistributedWorker(const std::string& datasetPath)
+    : dataset_(datasetPath, false), labels_(dataset_.labels()) {}
+
+int DistributedWorker::connect(const std::string& socketPath) {
+    sockaddr_un address = socketAddress(socketPath);
+    int socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket < 0) {
+        throw std::runtime_error("Could not create socket");
+    }
+    if (::connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(socket);
+        throw std::runtime_error("Could not connect to coordinator: " + socketPath);
+    }
+    return socket;
+}
+
+void DistributedWorker::serve(int socket) const {
+    const std::vector<std::uint64_t> hello = {dataset_.rows(), dataset_.cols(), dataset_.payloadChecksum()};
+    if (!sendMessage(socket, kHello, hello)) {
+        ::close(socket);
+        return;
+    }
+
+    std::uint64_t type = 0;
+    std::vector<std::uint64_t> payload;
+    std::vector<FeatureIndex> features;
+    while (receiveMessage(socket, type, payload) && type == kTask && payload.size() >= 4) {
+        const std::uint64_t unit = payload[0];
+        const std::size_t begin = static_cast<std::size_t>(payload[1]);
+        const std::size_t end = static_cast<std::size_t>(payload[2]);
+        const std::size_t featureCount = static_cast<std::size_t>(payload[3]);
+
+        // A malformed request ends the session rather than reading out of range
+        if (payload.size() != 4 + featureCount || begin > end || end > dataset_.rows()) {
+            break;
+        }
+        features.assign(payload.begin() + 4, payload.end());
+        if (std::any_of(features.begin(), features.end(), [&](FeatureIndex f) { return f >= dataset_.cols(); })) {
+            break;
+        }
+
+        std::size_t correct = countCorrect(features.data(), features.size(), begin, end);
+        if (!sendMessage(socket, kResult, {unit, correct})) {
+            break;
+        }
+    }
+    ::close(socket);
+}
+
+std::size_t DistributedWorker::countCorrect(
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t begin,
+    std::size_t end
+) const {
+    const auto source = TiledNearestNeighbor::columns(dataset_);
+    const std::size_t tile = TiledNearestNeighbor::kQueryTile;
+    const long long tiles = static_cast<long long>((end - begin + tile - 1) / tile);
+    std::size_t correct = 0;
+
+    #pragma omp parallel for schedule(dynamic) reduction(+:correct)
+    for (long long t = 0; t < tiles; ++t) {
+        const std::size_t q0 = begin + static_cast<std::size_t>(t) * tile;
+        correct += TiledNearestNeighbor::countCorrect(
+            source, labels_, features, featureCount, q0, std::min(end, q0 + tile)
+        );
+    }
+    return correct;
+}
+
+// ---------------------------------------------------------------------------
+// Coordinator
+// ---------------------------------------------------------------------------
+
+DistributedCoordinator::DistributedCoordinator(const std::string& socketPath, const std::string& datasetPath)
+    : socketPath_(socketPath), datasetPath_(datasetPath) {
+    BinaryDataset dataset(datasetPath, false);
+    rows_ = dataset.rows();
+    cols_ = dataset.cols();
+    checksum_ = dataset.payloadChecksum();
+    datasetHash_ = SearchCheckpoint::hashDataset(dataset);
+
+    sockaddr_un address = socketAddress(socketPath);
+    listener_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener_ < 0) {
+        throw std::runtime_error("Could not create socket");
+    }
+    ::unlink(socketPath.c_str());
+    if (::bind(listener_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener_, 64) != 0) {
+        ::close(listener_);
+        throw std::runtime_error("Could not listen on socket: " + socketPath);
+    }
+}
+
+DistributedCoordinator::~DistributedCoordinator() {
+    for (Worker& worker : workers_) {
+        if (worker.socket >= 0) {
+            sendMessage(worker.socket, kShutdown, {});
+            ::close(worker.socket);
+        }
+    }
+    if (listener_ >= 0) {
+        ::close(listener_);
+        ::unlink(socketPath_.c_str());
+    }
+    for (int child : children_) {
+        int status = 0;
+        ::waitpid(child, &status, 0);
+    }
+}
+
+void DistributedCoordinator::spawnWorkers(const std::string& workerExecutable, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::vector<char*> argv = {
+            const_cast<char*>(workerExecutable.c_str()),
+            const_cast<char*>(socketPath_.c_str()),
+            const_cast<char*>(datasetPath_.c_str()),
+            nullptr
+        };
+        pid_t child = 0;
+        if (::posix_spawn(&child, workerExecutable.c_str(), nullptr, nullptr, argv.data(), environ) != 0) {
+            throw std::runtime_error("Could not start worker: " + workerExecutable);
+        }
+        children_.push_back(child);
+    }
+    acceptWorkers(count);
+}
+
+void DistributedCoordinator::acceptWorkers(std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        pollfd waiting = {listener_, POLLIN, 0};
+        int ready = ::poll(&waiting, 1, kAcceptTimeoutSeconds * 1000);
+        if (ready <= 0) {
+            throw std::runtime_error("Timed out waiting for workers on " + socketPath_);
+        }
+        int socket = ::accept4(listener_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (socket < 0) {
+            throw std::runtime_error("Could not accept worker on " + socketPath_);
+        }
+        addWorker(socket);
+    }
+}
+
+void DistributedCoordinator::addWorker(int socket) {
+    std::uint64_t type = 0;
+    std::vector<std::uint64_t> hello;
+    if (!receiveMessage(socket, type, hello) || type != kHello || hello.size() != 3) {
+        ::close(socket);
+        throw std::runtime_error("Worker did not introduce itself");
+    }
+    if (hello[0] != rows_ || hello[1] != cols_ || hello[2] != checksum_) {
+        ::close(socket);
+        throw std::runtime_error("Worker serves a different dataset than " + datasetPath_);
+    }
+    Worker worker;
+    worker.socket = socket;
+    workers_.push_back(worker);
+}
+
+std::size_t DistributedCoordinator::workerCount() const {
+    return static_cast<std::size_t>(std::count_if(
+        workers_.begin(), workers_.end(), [](const Worker& worker) { return worker.socket >= 0; }
+    ));
+}
+
+std::vector<std::size_t> DistributedCoordinator::countCorrect(
+    const std::vector<std::vector<FeatureIndex>>& subsets
+) {
+    std::vector<std::size_t> counts(subsets.size(), 0);
+    if (subsets.empty() || rows_ == 0) {
+        return counts;
+    }
+    if (workerCount() == 0) {
+        throw std::runtime_error("No workers connected");
+    }
+
+    // Same grain rule as the in-process scheduler, with workers for threads
+    const std::size_t blockRows = WorkScheduler::blockRows(subsets.size(), rows_, workerCount());
+    const std::size_t blocks = WorkScheduler::blockCount(rows_, blockRows);
+    std::deque<std::size_t> pending;
+    for (std::size_t unit = 0; unit < subsets.size() * blocks; ++unit) {
+        pending.push_back(unit);
+    }
+    std::size_t remaining = pending.size();
+
+    // A lost worker's units go back to the front of the queue
+    auto disconnect = [&](Worker& worker) {
+        ::close(worker.socket);
+        worker.socket = -1;
+        pending.insert(pending.begin(), worker.outstanding.begin(), worker.outstanding.end());
+        stats_.unitsRequeued += worker.outstanding.size();
+        stats_.workersLost++;
+        worker.outstanding.clear();
+    };
+
+    using Clock = std::chrono::steady_clock;
+    const std::chrono::seconds timeout(resultTimeoutSeconds_);
+    std::uint64_t type = 0;
+    std::vector<std::uint64_t> message;
+    std::vector<pollfd> waiting;
+    std::vector<Worker*> polled;
+    while (remaining > 0) {
+        for (Worker& worker : workers_) {
+            while (worker.socket >= 0 && worker.outstanding.size() < kUnitsInFlight && !pending.empty()) {
+                const std::size_t unit = pending.front();
+                const auto& subset = subsets[unit / blocks];
+                const std::size_t begin = (unit % blocks) * blockRows;
+                message = {unit, begin, std::min(rows_, begin + blockRows), subset.size()};
+                message.insert(message.end(), subset.begin(), subset.end());
+                if (!sendMessage(worker.socket, kTask, message)) {
+                    disconnect(worker);
+                    break;
+                }
+                pending.pop_front();
+                if (worker.outstanding.empty()) {
+                    worker.lastProgress = Clock::now();
+                }
+                worker.outstanding.push_back(unit);
+                stats_.unitsSent++;
+            }
+        }
+
+        waiting.clear();
+        polled.clear();
+        for (Worker& worker : workers_) {
+            if (worker.socket >= 0 && !worker.outstanding.empty()) {
+                waiting.push_back({worker.socket, POLLIN, 0});
+                polled.push_back(&worker);
+            }
+        }
+        if (waiting.empty()) {
+            throw std::runtime_error("All workers disconnected");
+        }
+        
+        // Wake up by the earliest deadline, so a worker that stalls without
+        // closing its socket is dropped instead of hanging the search
+        const Clock::time_point now = Clock::now();
+        Clock::time_point deadline = Clock::time_point::max();
+        for (const Worker* worker : polled) {
+            deadline = std::min(deadline, worker->lastProgress + timeout);
+        }
+        const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+        if (::poll(waiting.data(), waiting.size(), static_cast<int>(std::max<long long>(0, wait))) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Could not wait for workers");
+        }
+
+        for (std::size_t w = 0; w < waiting.size(); ++w) {
+            Worker& worker = *polled[w];
+            if (waiting[w].revents == 0) {
+                if (Clock::now() - worker.lastProgress >= timeout) {
+                    disconnect(worker);
+                }
+                continue;
+            }
+            if (!receiveMessage(worker.socket, type, message) || type != kResult || message.size() != 2) {
+                disconnect(worker);
+                continue;
+            }
+            auto sent = std::find(worker.outstanding.begin(), worker.outstanding.end(), message[0]);
+            if (sent == worker.outstanding.end()) {
+                disconnect(worker);
+                continue;
+            }
+            worker.outstanding.erase(sent);
+            worker.lastProgress = Clock::now();
+            counts[static_cast<std::size_t>(message[0]) / blocks] += static_cast<std::size_t>(message[1]);
+            remaining--;
+        }
+    }
+    return counts;
+}
+
+#else // FEATURE_SELECTION_HAVE_SOCKETS
+
+namespace {
+
+[[noreturn]] void unsupported() {
+    throw std::runtime_error("Distributed evaluation needs Unix sockets");
+}
+
+} // namespace
+
+DistributedWorker::DistributedWorker(const std::string& datasetPath)
+    : dataset_(datasetPath, false) { unsupported(); }
+int DistributedWorker::connect(const std::string&) { unsupported(); }
+void DistributedWorker::serve(int) const { unsupported(); }
+std::size_t DistributedWorker::countCorrect(const FeatureIndex*, std::size_t, std::size_t, std::size_t) const {
+    unsupported();
+}
+
+DistributedCoordinator::DistributedCoordinator(const std::string&, const std::string&) { unsupported(); }
+DistributedCoordinator::~DistributedCoordinator() = default;
+void DistributedCoordinator::spawnWorkers(const std::string&, std::size_t) { unsupported(); }
+void DistributedCoordinator::acceptWorkers(std::size_t) { unsupported(); }
+void DistributedCoordinator::addWorker(int) { unsupported(); }
+std::size_t DistributedCoordinator::workerCount() const { return 0; }
+std::vector<std::size_t> DistributedCoordinator::countCorrect(const std::vector<std::vector<FeatureIndex>>&) {
+    unsupported();
+}
+
+#endif // FEATURE_SELECTION_HAVE_SOCKETS
+
+} // namespace feature_selection
@@ -0,0 +1,71 @@
+#include "feature_selection/early_termination.h"
+#include "feature_selection/work_scheduler.h"
+#include <algorithm>
+
+namespace feature_selection {
+
+EarlyTermination::Level::Level(std::size_t rows, std::size_t candidates, std::size_t keep)
+    : rows_(rows),
+      keep_(std::max<std::size_t>(1, keep)),
+      errors_(candidates),
+      scored_(candidates) {}
+
+void EarlyTermination::Level::finish(std::size_t correct) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    best_.push(correct);
+    if (best_.size() > keep_) {
+        best_.pop();
+    }
+    if (best_.size() == keep_) {
+        threshold_.store(best_.top(), std::memory_order_relaxed);
+    }
+}
+
+void EarlyTermination::Level::record(std::size_t candidate, std::size_t blockRows, std::size_t blockCorrect) {
+    // Sequentially consistent, so the unit that scores the last block sees
+    // the errors of every other block of the candidate
+    errors_[candidate].fetch_add(blockRows - blockCorrect);
+    const std::size_t scored = scored_[candidate].fetch_add(blockRows) + blockRows;
+    const std::size_t errors = errors_[candidate].load();
+    if (scored == rows_) {
+        finish(rows_ - errors);
+    }
+}
+
+EarlyTermination::EarlyTermination(std::size_t rows)
+    : rows_(rows),
+      blockRows_(std::max(
+          WorkScheduler::kMinBlockRows,
+          (rows / kBlocksPerCandidate + WorkScheduler::kMinBlockRows - 1) /
+              WorkScheduler::kMinBlockRows * WorkScheduler::kMinBlockRows
+      )),
+      errors_(WorkScheduler::blockCount(rows, blockRows_)) {}
+
+std::vector<std::size_t> EarlyTermination::blockOrder() const {
+    std::vector<std::uint64_t> errors(errors_.size());
+    std::vector<std::size_t> order(errors_.size());
+    for (std::size_t b = 0; b < errors_.size(); ++b) {
+        // Per row, so a short last block is not ranked down for its size
+        const std::size_t begin = b * blockRows_;
+        const std::size_t size = std::min(blockRows_, rows_ - begin);
+        errors[b] = errors_[b].load(std::memory_order_relaxed) * blockRows_ / size;
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return errors[a] > errors[b];
+    });
+    return order;
+}
+
+void EarlyTermination::countLevel(const Level& level, std::size_t candidates) {
+    stats_.candidates += candidates;
+    stats_.rowsPossible += static_cast<std::uint64_t>(candidates) * rows_;
+    for (std::size_t c = 0; c < candidates; ++c) {
+        stats_.rowsScored += level.rowsScored(c);
+        if (!level.complete(c)) {
+            stats_.stopped++;
+        }
+    }
+}
+
+} // namespace feature_selection
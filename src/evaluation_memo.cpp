@@ -0,0 +1,196 @@
+#include "feature_selection/evaluation_memo.h"
+#include "feature_selection/binary_dataset.h"
+#include "feature_selection/search_checkpoint.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace feature_selection {
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'S', 'M', 'E', 'M', 'O', '\0', '\0'};
+constexpr std::uint32_t kEndianMarker = 0x01020304u;
+
+// splitmix64 finalizer: every input bit reaches the top bits that pick the shard
+std::uint64_t mix(std::uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 31;
+    return value;
+}
+
+std::uint64_t headerChecksum(const EvaluationMemo::Header& header) {
+    EvaluationMemo::Header copy = header;
+    copy.headerChecksum = 0;
+    return BinaryDataset::checksum(reinterpret_cast<const char*>(&copy), sizeof(copy));
+}
+
+} // namespace
+
+EvaluationMemo::EvaluationMemo(const DataMatrix& data, const LabelVector& labels)
+    : rows_(data.rows()),
+      cols_(data.cols()),
+      datasetHash_(SearchCheckpoint::hashDataset(data, labels)),
+      shards_(kShards) {}
+
+bool EvaluationMemo::matches(const DataMatrix& data, const LabelVector& labels) const {
+    return data.rows() == rows_ && data.cols() == cols_ &&
+           SearchCheckpoint::hashDataset(data, labels) == datasetHash_;
+}
+
+EvaluationMemo::Key EvaluationMemo::makeKey(const std::vector<std::uint64_t>& words) {
+    std::uint64_t hash = mix(words.size());
+    for (std::uint64_t word : words) {
+        hash = mix(hash ^ word);
+    }
+    return Key{hash, words};
+}
+
+bool EvaluationMemo::lookup(const FeatureBitset& subset, double& accuracy) const {
+    lookups_.fetch_add(1, std::memory_order_relaxed);
+    Key key = makeKey(subset.words());
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.entries.find(key);
+    if (found == shard.entries.end()) {
+        return false;
+    }
+    accuracy = found->second;
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void EvaluationMemo::insert(const FeatureBitset& subset, double accuracy) {
+    if (subset.capacity() != cols_) {
+        throw std::invalid_argument("Subset does not belong to the memo's dataset");
+    }
+    store(makeKey(subset.words()), accuracy);
+    inserts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EvaluationMemo::store(Key key, double accuracy) {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries[std::move(key)] = accuracy;
+}
+
+std::size_t EvaluationMemo::size() const {
+    std::size_t total = 0;
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+MemoStats EvaluationMemo::stats() const {
+    MemoStats stats;
+    stats.lookups = lookups_.load(std::memory_order_relaxed);
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.inserts = inserts_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void EvaluationMemo::save(const std::string& path) const {
+    const std::size_t words = (cols_ + 63) / 64;
+    std::vector<std::uint64_t> payload;
+    std::uint64_t entries = 0;
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& [key, accuracy] : shard.entries) {
+            payload.insert(payload.end(), key.words.begin(), key.words.end());
+            std::uint64_t bits;
+            std::memcpy(&bits, &accuracy, sizeof(bits));
+            payload.push_back(bits);
+            ++entries;
+        }
+    }
+
+    Header header {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.endianMarker = kEndianMarker;
+    header.rows = rows_;
+    header.cols = cols_;
+    header.datasetHash = datasetHash_;
+    header.words = words;
+    header.entries = entries;
+    header.payloadChecksum = BinaryDataset::checksum(
+        reinterpret_cast<const char*>(payload.data()), payload.size() * sizeof(std::uint64_t)
+    );
+    header.headerChecksum = headerChecksum(header);
+
+    // Write to a temporary name first so an interrupted save keeps the old file
+    std::string tempPath = BinaryDataset::temporaryPath(path);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not create evaluation memo: " + tempPath);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(payload.data()),
+                   static_cast<std::streamsize>(payload.size() * sizeof(std::uint64_t)));
+        if (!file) {
+            throw std::runtime_error("Could not write evaluation memo: " + tempPath);
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        throw std::runtime_error("Could not replace evaluation memo: " + path);
+    }
+}
+
+void EvaluationMemo::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open evaluation memo: " + path);
+    }
+
+    Header header {};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Evaluation memo is truncated: " + path);
+    }
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not an evaluation memo: " + path);
+    }
+    if (header.endianMarker != kEndianMarker) {
+        throw std::runtime_error("Evaluation memo has foreign byte order: " + path);
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("Unsupported evaluation memo version " + std::to_string(header.version) + ": " + path);
+    }
+    if (header.headerChecksum != headerChecksum(header)) {
+        throw std::runtime_error("Evaluation memo header is corrupted: " + path);
+    }
+    const std::size_t words = (cols_ + 63) / 64;
+    if (header.rows != rows_ || header.cols != cols_ || header.datasetHash != datasetHash_ || header.words != words) {
+        throw std::runtime_error("Evaluation memo belongs to a different dataset: " + path);
+    }
+
+    const std::size_t record = words + 1;
+    std::vector<std::uint64_t> payload(static_cast<std::size_t>(header.entries) * record);
+    if (!file.read(reinterpret_cast<char*>(payload.data()),
+                   static_cast<std::streamsize>(payload.size() * sizeof(std::uint64_t)))) {
+        throw std::runtime_error("Evaluation memo is truncated: " + path);
+    }
+    if (BinaryDataset::checksum(reinterpret_cast<const char*>(payload.data()),
+                                payload.size() * sizeof(std::uint64_t)) != header.payloadChecksum) {
+        throw std::runtime_error("Evaluation memo checksum mismatch: " + path);
+    }
+
+    std::vector<std::uint64_t> keyWords(words);
+    for (std::size_t e = 0; e < header.entries; ++e) {
+        const std::uint64_t* entry = payload.data() + e * record;
+        keyWords.assign(entry, entry + words);
+        double accuracy;
+        std::memcpy(&accuracy, entry + words, sizeof(accuracy));
+        store(makeKey(keyWords), accuracy);
+    }
+}
+
+} // namespace feature_selection
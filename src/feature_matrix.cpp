@@ -0,0 +1,138 @@
+#include "feature_selection/feature_matrix.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <omp.h>
+
+namespace feature_selection {
+
+namespace {
+
+// Edge length of the square blocks used when transposing between views
+constexpr std::size_t kTransposeBlock = 32;
+
+// Doubles per first-touch chunk (one 4 KB page)
+constexpr std::size_t kPageDoubles = 4096 / sizeof(double);
+
+std::size_t roundUpToPadding(std::size_t value) {
+    return (value + FeatureMatrix::kPadding - 1) / FeatureMatrix::kPadding * FeatureMatrix::kPadding;
+}
+
+// Blocked transpose of a rows x cols region from src (stride srcStride) into
+// dst (stride dstStride); the blocks keep both sides resident in L1
+void blockedTranspose(
+    const double* src, std::size_t srcStride,
+    double* dst, std::size_t dstStride,
+    std::size_t rows, std::size_t cols
+) {
+    const long long rowBlocks = static_cast<long long>((rows + kTransposeBlock - 1) / kTransposeBlock);
+
+    #pragma omp parallel for schedule(static) if(rows * cols > (1u << 16))
+    for (long long rb = 0; rb < rowBlocks; ++rb) {
+        std::size_t r0 = static_cast<std::size_t>(rb) * kTransposeBlock;
+        std::size_t r1 = std::min(rows, r0 + kTransposeBlock);
+        for (std::size_t c0 = 0; c0 < cols; c0 += kTransposeBlock) {
+            std::size_t c1 = std::min(cols, c0 + kTransposeBlock);
+            for (std::size_t r = r0; r < r1; ++r) {
+                for (std::size_t c = c0; c < c1; ++c) {
+                    dst[c * dstStride + r] = src[r * srcStride + c];
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+void FeatureMatrix::AlignedDeleter::operator()(double* ptr) const {
+    ::operator delete[](ptr, std::align_val_t(kAlignment));
+}
+
+FeatureMatrix::Buffer FeatureMatrix::allocate(std::size_t count) {
+    if (count == 0) {
+        return Buffer();
+    }
+    auto* ptr = static_cast<double*>(
+        ::operator new[](count * sizeof(double), std::align_val_t(kAlignment))
+    );
+    
+    // Zero page by page from every thread: the OS places a page on the node of
+    // the thread that first writes it, so the buffer spreads over all NUMA
+    // nodes instead of landing on the allocating thread's. Inside a parallel
+    // region (e.g. when building a per-node replica) the calling thread
+    // touches everything itself
+    const long long pages = static_cast<long long>((count + kPageDoubles - 1) / kPageDoubles);
+    #pragma omp parallel for schedule(static) if(pages > 64 && !omp_in_parallel())
+    for (long long p = 0; p < pages; ++p) {
+        std::size_t begin = static_cast<std::size_t>(p) * kPageDoubles;
+        std::memset(ptr + begin, 0, (std::min(count, begin + kPageDoubles) - begin) * sizeof(double));
+    }
+    return Buffer(ptr);
+}
+
+FeatureMatrix::FeatureMatrix(std::size_t rows, std::size_t cols)
+    : rows_(rows),
+      cols_(cols),
+      rowStride_(roundUpToPadding(cols)),
+      columnStride_(roundUpToPadding(rows)),
+      rowMajor_(allocate(rows_ * rowStride_)),
+      columnMajor_(allocate(cols_ * columnStride_)) {}
+
+FeatureMatrix::FeatureMatrix(const FeatureMatrix& other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      rowStride_(other.rowStride_),
+      columnStride_(other.columnStride_),
+      rowMajor_(allocate(rows_ * rowStride_)),
+      columnMajor_(allocate(cols_ * columnStride_)) {
+    if (rowMajor_) {
+        std::memcpy(rowMajor_.get(), other.rowMajor_.get(), rows_ * rowStride_ * sizeof(double));
+    }
+    if (columnMajor_) {
+        std::memcpy(columnMajor_.get(), other.columnMajor_.get(), cols_ * columnStride_ * sizeof(double));
+    }
+}
+
+FeatureMatrix& FeatureMatrix::operator=(const FeatureMatrix& other) {
+    if (this != &other) {
+        FeatureMatrix copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+FeatureMatrix FeatureMatrix::fromRows(const std::vector<std::vector<double>>& rows) {
+    if (rows.empty()) {
+        return FeatureMatrix();
+    }
+
+    const std::size_t cols = rows[0].size();
+    FeatureMatrix matrix(rows.size(), cols);
+
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i].size() != cols) {
+            throw std::runtime_error("Inconsistent feature count in dataset");
+        }
+        std::copy(rows[i].begin(), rows[i].end(), matrix.mutableRowData(i));
+    }
+
+    matrix.syncColumnsFromRows();
+    return matrix;
+}
+
+void FeatureMatrix::syncColumnsFromRows() {
+    if (rows_ == 0 || cols_ == 0) {
+        return;
+    }
+    blockedTranspose(rowMajor_.get(), rowStride_, columnMajor_.get(), columnStride_, rows_, cols_);
+}
+
+void FeatureMatrix::syncRowsFromColumns() {
+    if (rows_ == 0 || cols_ == 0) {
+        return;
+    }
+    blockedTranspose(columnMajor_.get(), columnStride_, rowMajor_.get(), rowStride_, cols_, rows_);
+}
+
+} // namespace feature_selection
@@ -1,20 +1,1120 @@
 #include "feature_selection/feature_selection.h"
 #include "feature_selection/nearest_neighbor.h"
+#include "feature_selection/candidate_screen.h"
+#include "feature_selection/compact_matrix.h"
+#include "feature_selection/distance_cache.h"
+#include "feature_selection/early_termination.h"
+#include "feature_selection/evaluation_memo.h"
+#include "feature_selection/metrics.h"
+#include "feature_selection/numa_topology.h"
+#include "feature_selection/partial_distance_search.h"
+#include "feature_selection/search_checkpoint.h"
+#include "feature_selection/sorted_sweep.h"
+#include "feature_selection/streaming_evaluator.h"
+#include "feature_selection/successive_halving.h"
+#include "feature_selection/spatial_index.h"
+#include "feature_selection/tiled_nearest_neighbor.h"
+#include "feature_selection/work_scheduler.h"
+#include "feature_selection/feature_bitset.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <filesystem>
 #include <vector>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
 #include <omp.h>  // Include OpenMP header
 
 namespace feature_selection {
 
+namespace {
+
+// Running argmax over candidate slots: the highest accuracy wins, and ties
+// go to the lowest feature index so the result does not depend on scheduling
+struct BestCandidate {
+    double accuracy = -1.0;
+    FeatureIndex feature = 0;
+    bool valid = false;
+};
+
+inline BestCandidate betterCandidate(const BestCandidate& a, const BestCandidate& b) {
+    if (!a.valid) {
+        return b;
+    }
+    if (!b.valid) {
+        return a;
+    }
+    if (b.accuracy > a.accuracy || (b.accuracy == a.accuracy && b.feature < a.feature)) {
+        return b;
+    }
+    return a;
+}
+
+#pragma omp declare reduction(bestCandidate : BestCandidate : \
+    omp_out = betterCandidate(omp_out, omp_in)) initializer(omp_priv = BestCandidate())
+
+// Argmax over the preallocated accuracy slots of one level
+BestCandidate selectBest(
+    const std::vector<FeatureIndex>& candidates,
+    const std::vector<double>& accuracies,
+    std::size_t candidateCount
+) {
+    BestCandidate best;
+    const long long count = static_cast<long long>(candidateCount);
+    
+    #pragma omp parallel for reduction(bestCandidate:best) if(count > 1024)
+    for (long long c = 0; c < count; ++c) {
+        best = betterCandidate(best, {accuracies[c], candidates[c], true});
+    }
+    
+    return best;
+}
+
+// Sorted-sweep neighbors or spatial index of one subset, built by the first
+// of its row blocks to run, queried by all of them and freed after the last
+class SharedNeighbors {
+public:
+    // Correct predictions among queries [begin, end) of a one-feature subset
+    // or one that chooseStrategy() gives an index
+    std::size_t correct(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        const std::vector<FeatureIndex>& features,
+        std::size_t begin,
+        std::size_t end
+    ) {
+        std::call_once(built_, [&] {
+            if (features.size() == 1) {
+                SortedSweep::findAllNearest(data.columnData(features[0]), data.rows(), nearest_);
+            } else {
+                index_ = SpatialIndex::build(
+                    SpatialIndex::chooseStrategy(data.rows(), features.size()), data, features.data(), features.size()
+                );
+            }
+        });
+        return index_ ? index_->countCorrect(labels, begin, end)
+                      : SortedSweep::countCorrect(nearest_, labels, begin, end);
+    }
+    
+    // Mark one of the subset's `blocks` row blocks counted (or skipped)
+    void finishBlock(std::size_t blocks) {
+        if (finished_.fetch_add(1) + 1 == blocks) {
+            index_.reset();
+            std::vector<std::size_t>().swap(nearest_);
+        }
+    }
+
+private:
+    std::once_flag built_;
+    std::atomic<std::size_t> finished_{0};
+    std::unique_ptr<SpatialIndex> index_;
+    std::vector<std::size_t> nearest_;
+};
+
+// Scores candidates that neither the cache nor screening handles: on the
+// compact reduced-precision copy, with early abandoning, or exactly.
+// Engines are set by name and left null when unused
+struct CandidateScorer {
+    CandidateScorer(const DataMatrix& data, const LabelVector& labels) : data(data), labels(labels) {}
+    
+    const DataMatrix& data;
+    const LabelVector& labels;
+    const CompactMatrix* compact = nullptr;
+    const PartialDistanceSearch* pruned = nullptr;
+    const NumaReplicas* replicas = nullptr;
+    DistributedCoordinator* remote = nullptr;
+    EvaluationMemo* memo = nullptr;
+    EarlyTermination* termination = nullptr;
+    const StreamingEvaluator* streaming = nullptr;
+    
+    // The copy of the data on the calling thread's NUMA node
+    const DataMatrix& local() const {
+        return replicas != nullptr ? replicas->local() : data;
+    }
+    
+    // Correct predictions among queries [begin, end); subsets for the sorted
+    // sweep or a spatial index share `neighbors` between their row blocks
+    std::size_t correct(
+        const std::vector<FeatureIndex>& features,
+        std::size_t begin,
+        std::size_t end,
+        PruningStats& pruning,
+        SharedNeighbors& neighbors
+    ) const {
+        if (streaming != nullptr) {
+            return streaming->leaveOneOutCorrect(features.data(), features.size(), begin, end);
+        }
+        if (compact != nullptr) {
+            return compact->leaveOneOutCorrect(labels, features.data(), features.size(), begin, end);
+        }
+        if (pruned != nullptr) {
+            return pruned->leaveOneOutCorrect(labels, features.data(), features.size(), begin, end, &pruning);
+        }
+        if (features.size() == 1 ||
+            SpatialIndex::chooseStrategy(data.size(), features.size()) != NeighborStrategy::BruteForce) {
+            return neighbors.correct(local(), labels, features, begin, end);
+        }
+        return TiledNearestNeighbor::countCorrect(
+            TiledNearestNeighbor::columns(local()), labels, features.data(), features.size(), begin, end
+        );
+    }
+};
+
+// Ascending list of `current` with `feature` added, written into `out`
+// (which has enough capacity reserved, so nothing is allocated)
+void listWithFeature(
+    const std::vector<FeatureIndex>& current,
+    FeatureIndex feature,
+    std::vector<FeatureIndex>& out
+) {
+    out.clear();
+    auto split = std::lower_bound(current.begin(), current.end(), feature);
+    out.insert(out.end(), current.begin(), split);
+    out.push_back(feature);
+    out.insert(out.end(), split, current.end());
+}
+
+// Ascending list of `current` without `feature`, written into `out`
+void listWithoutFeature(
+    const std::vector<FeatureIndex>& current,
+    FeatureIndex feature,
+    std::vector<FeatureIndex>& out
+) {
+    out.clear();
+    for (FeatureIndex f : current) {
+        if (f != feature) {
+            out.push_back(f);
+        }
+    }
+}
+
+// One subset to score: a parent feature list with one feature added or
+// removed. Batches may mix parents, e.g. every expansion of a beam
+struct Expansion {
+    const std::vector<FeatureIndex>* parent;
+    FeatureIndex feature;
+    bool adding;
+    
+    std::size_t size() const { return adding ? parent->size() + 1 : parent->size() - 1; }
+    
+    // Ascending feature list of the subset, written into `out`
+    void listInto(std::vector<FeatureIndex>& out) const {
+        if (adding) {
+            listWithFeature(*parent, feature, out);
+        } else {
+            listWithoutFeature(*parent, feature, out);
+        }
+    }
+};
+
+// Expansions of one parent by the candidates in the given slots
+std::vector<Expansion> expansionsOf(
+    const std::vector<FeatureIndex>& parent,
+    const std::vector<FeatureIndex>& candidates,
+    const std::vector<std::size_t>& slots,
+    bool adding
+) {
+    std::vector<Expansion> expansions(slots.size());
+    for (std::size_t t = 0; t < slots.size(); ++t) {
+        expansions[t] = {&parent, candidates[slots[t]], adding};
+    }
+    return expansions;
+}
+
+// Bitset of each expansion in turn; the parent's bits are set once and
+// each expansion toggles a single feature
+class ExpansionKeys {
+public:
+    explicit ExpansionKeys(std::size_t featureCount) : subset_(featureCount) {}
+    
+    const FeatureBitset& of(const Expansion& expansion) {
+        if (toggled_ != nullptr) {
+            toggled_->adding ? subset_.erase(toggled_->feature) : subset_.insert(toggled_->feature);
+        }
+        if (expansion.parent != parent_) {
+            subset_ = FeatureBitset(subset_.capacity());
+            for (FeatureIndex feature : *expansion.parent) {
+                subset_.insert(feature);
+            }
+            parent_ = expansion.parent;
+        }
+        expansion.adding ? subset_.insert(expansion.feature) : subset_.erase(expansion.feature);
+        toggled_ = &expansion;
+        return subset_;
+    }
+    
+private:
+    FeatureBitset subset_;
+    const std::vector<FeatureIndex>* parent_ = nullptr;
+    const Expansion* toggled_ = nullptr;
+};
+
+// Fill the accuracy of every expansion whose subset the memo already holds
+// and return the indices of the expansions that still need scoring
+std::vector<std::size_t> recallExpansions(
+    const EvaluationMemo* memo,
+    const std::vector<Expansion>& expansions,
+    std::vector<double>& accuracies
+) {
+    std::vector<std::size_t> pending;
+    if (memo == nullptr) {
+        pending.resize(expansions.size());
+        for (std::size_t t = 0; t < expansions.size(); ++t) {
+            pending[t] = t;
+        }
+        return pending;
+    }
+    ExpansionKeys keys(memo->featureCount());
+    for (std::size_t t = 0; t < expansions.size(); ++t) {
+        if (!memo->lookup(keys.of(expansions[t]), accuracies[t])) {
+            pending.push_back(t);
+        }
+    }
+    return pending;
+}
+
+// Store the scored accuracies of the given expansions in the memo; stopped
+// candidates (accuracy -1) are skipped
+void rememberExpansions(
+    EvaluationMemo* memo,
+    const std::vector<Expansion>& expansions,
+    const std::vector<std::size_t>& scored,
+    const std::vector<double>& accuracies
+) {
+    if (memo == nullptr) {
+        return;
+    }
+    ExpansionKeys keys(memo->featureCount());
+    for (std::size_t t : scored) {
+        if (accuracies[t] >= 0.0) {
+            memo->insert(keys.of(expansions[t]), accuracies[t]);
+        }
+    }
+}
+
+// Leave-one-out accuracy of a whole subset, from the memo when it has it
+double memoizedAccuracy(
+    EvaluationMemo* memo,
+    const DataMatrix& data,
+    const LabelVector& labels,
+    const FeatureSet& features
+) {
+    double accuracy = 0.0;
+    if (memo != nullptr && memo->lookup(FeatureBitset(data.cols(), features), accuracy)) {
+        return accuracy;
+    }
+    accuracy = NearestNeighbor::leaveOneOutCrossValidation(data, labels, features, false);
+    if (memo != nullptr) {
+        memo->insert(FeatureBitset(data.cols(), features), accuracy);
+    }
+    return accuracy;
+}
+
+std::string listToString(const std::vector<FeatureIndex>& features) {
+    return featureSetToString(FeatureSet(features.begin(), features.end()));
+}
+
+void printCandidates(
+    const std::vector<FeatureIndex>& current,
+    const std::vector<FeatureIndex>& candidates,
+    const std::vector<double>& accuracies,
+    std::size_t candidateCount,
+    bool adding,
+    const std::vector<double>* screened = nullptr
+) {
+    std::vector<FeatureIndex> candidateList;
+    for (std::size_t c = 0; c < candidateCount; ++c) {
+        if (adding) {
+            listWithFeature(current, candidates[c], candidateList);
+        } else {
+            listWithoutFeature(current, candidates[c], candidateList);
+        }
+        std::cout << "Using feature(s) " << listToString(candidateList) << std::fixed << std::setprecision(1);
+        if (screened != nullptr && accuracies[c] < 0.0) {
+            std::cout << " screened accuracy is " << ((*screened)[c] * 100.0) << "%" << std::endl;
+            continue;
+        }
+        if (accuracies[c] < 0.0) {
+            std::cout << " stopped early" << std::endl;
+            continue;
+        }
+        std::cout << " accuracy is " << (accuracies[c] * 100.0) << "%";
+        if (screened != nullptr) {
+            std::cout << " (screened " << ((*screened)[c] * 100.0) << "%)";
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Bind the threads and, for NumaPlacement::Replicate, copy the data onto
+// every node; the report is stored in the result. Callers hold a
+// ThreadAffinityGuard so the binding ends with the search
+std::unique_ptr<NumaReplicas> placeData(
+    const DataMatrix& data,
+    const NumaTopology& topology,
+    const SearchOptions& options,
+    PlacementReport& report
+) {
+    report = topology.pinThreads(options.threadAffinity);
+    report.placement = options.numaPlacement;
+    
+    std::unique_ptr<NumaReplicas> replicas;
+    if (options.numaPlacement == NumaPlacement::Replicate && !data.empty()) {
+        replicas = std::make_unique<NumaReplicas>(data, topology);
+        report.replicas = replicas->replicaCount();
+    }
+    return replicas;
+}
+
+// Workers must serve the dataset being searched, values and labels alike;
+// returns the coordinator's counters so the search can report its own share
+DistributedStats checkCoordinator(const SearchOptions& options, const DataMatrix& data, const LabelVector& labels) {
+    if (options.coordinator == nullptr) {
+        return DistributedStats();
+    }
+    if (options.coordinator->rows() != data.rows() || options.coordinator->cols() != data.cols() ||
+        options.coordinator->datasetHash() != SearchCheckpoint::hashDataset(data, labels)) {
+        throw std::runtime_error("Distributed workers serve a different dataset than the one searched");
+    }
+    return options.coordinator->stats();
+}
+
+DistributedStats distributedSince(const DistributedStats& before, const DistributedStats& after) {
+    DistributedStats delta;
+    delta.unitsSent = after.unitsSent - before.unitsSent;
+    delta.unitsRequeued = after.unitsRequeued - before.unitsRequeued;
+    delta.workersLost = after.workersLost - before.workersLost;
+    return delta;
+}
+
+// A shared memo must hold accuracies of the dataset being searched; returns
+// its counters so the search can report its own lookups
+MemoStats checkMemo(const SearchOptions& options, const DataMatrix& data, const LabelVector& labels) {
+    if (options.memo == nullptr) {
+        return MemoStats();
+    }
+    if (!options.memo->matches(data, labels)) {
+        throw std::runtime_error("Evaluation memo belongs to a different dataset than the one searched");
+    }
+    return options.memo->stats();
+}
+
+MemoStats memoSince(const MemoStats& before, const MemoStats& after) {
+    MemoStats delta;
+    delta.lookups = after.lookups - before.lookups;
+    delta.hits = after.hits - before.hits;
+    delta.inserts = after.inserts - before.inserts;
+    return delta;
+}
+
+// Checkpoint to continue from, when resuming and the file exists; it must
+// come from the same kind of search over the same data
+std::unique_ptr<SearchCheckpoint> resumeCheckpoint(
+    const SearchOptions& options,
+    SearchDirection direction,
+    const DataMatrix& data,
+    std::uint64_t datasetHash
+) {
+    if (!options.resume || options.checkpointPath.empty() || !std::filesystem::exists(options.checkpointPath)) {
+        return nullptr;
+    }
+    auto checkpoint = std::make_unique<SearchCheckpoint>(SearchCheckpoint::read(options.checkpointPath));
+    if (checkpoint->direction != direction) {
+        throw std::runtime_error("Checkpoint was written by the other search direction: " + options.checkpointPath);
+    }
+    if (checkpoint->rows != data.rows() || checkpoint->cols != data.cols() || checkpoint->datasetHash != datasetHash) {
+        throw std::runtime_error("Checkpoint belongs to a different dataset: " + options.checkpointPath);
+    }
+    return checkpoint;
+}
+
+// Save the search state after `levels` completed levels, every
+// options.checkpointInterval levels
+void saveCheckpoint(
+    const SearchOptions& options,
+    SearchDirection direction,
+    const DataMatrix& data,
+    std::uint64_t datasetHash,
+    std::size_t levels,
+    const std::vector<FeatureIndex>& current,
+    const SearchResult& result,
+    const DistanceCache* cache
+) {
+    if (options.checkpointPath.empty() || levels % std::max<std::size_t>(1, options.checkpointInterval) != 0) {
+        return;
+    }
+    SearchCheckpoint checkpoint;
+    checkpoint.direction = direction;
+    checkpoint.rows = data.rows();
+    checkpoint.cols = data.cols();
+    checkpoint.datasetHash = datasetHash;
+    checkpoint.levelsCompleted = levels;
+    checkpoint.current = current;
+    checkpoint.bestFeatureSet = result.bestFeatureSet;
+    checkpoint.bestAccuracy = result.bestAccuracy;
+    checkpoint.allResults = result.allResults;
+    checkpoint.write(options.checkpointPath, cache);
+}
+
+// Whether options.maxLevels levels have run since the search started or resumed
+bool levelLimitReached(const SearchOptions& options, std::size_t levelsRun) {
+    return options.maxLevels != 0 && levelsRun >= options.maxLevels;
+}
+
+// Slots 0..count-1
+std::vector<std::size_t> allSlots(std::size_t count) {
+    std::vector<std::size_t> slots(count);
+    for (std::size_t c = 0; c < count; ++c) {
+        slots[c] = c;
+    }
+    return slots;
+}
+
+// Score a batch of expansions as (expansion × row block) units of one
+// parallel region, so a level keeps every thread busy whether it has a few
+// candidates or thousands. Each expansion's accuracy is written once all of
+// its blocks are counted. With scorer.termination, expansions that cannot
+// make the best `keep` of the batch are stopped and get an accuracy of -1
+void scoreExpansions(
+    const CandidateScorer& scorer,
+    const std::vector<Expansion>& expansions,
+    std::vector<std::vector<FeatureIndex>>& threadLists,
+    std::vector<PruningStats>& threadPruning,
+    std::vector<double>& accuracies,
+    std::size_t keep = 1
+) {
+    const std::size_t rows = scorer.labels.size();
+    if (expansions.empty() || rows == 0) {
+        return;
+    }
+    const std::vector<std::size_t> pending = recallExpansions(scorer.memo, expansions, accuracies);
+    if (pending.empty()) {
+        return;
+    }
+    Metrics::add(Counter::LeaveOneOutCalls, pending.size());
+    
+    const std::size_t blockRows = WorkScheduler::blockRows(pending.size(), rows, threadLists.size());
+    
+    std::vector<std::size_t> correct(pending.size(), 0);
+    std::vector<SharedNeighbors> neighbors(pending.size());
+    std::size_t blocks = WorkScheduler::blockCount(rows, blockRows);
+    auto scoreUnit = [&](std::size_t task, std::size_t begin, std::size_t end) {
+        const std::size_t thread = static_cast<std::size_t>(omp_get_thread_num());
+        auto& candidateList = threadLists[thread];
+        expansions[pending[task]].listInto(candidateList);
+        
+        std::size_t blockCorrect = scorer.correct(candidateList, begin, end, threadPruning[thread], neighbors[task]);
+        neighbors[task].finishBlock(blocks);
+        Metrics::add(Counter::DistanceEvaluations, static_cast<std::uint64_t>(end - begin) * (rows - 1));
+        #pragma omp atomic
+        correct[task] += blockCorrect;
+        return blockCorrect;
+    };
+    
+    EarlyTermination* termination = scorer.termination;
+    std::optional<EarlyTermination::Level> level;
+    if (scorer.remote != nullptr) {
+        std::vector<std::vector<FeatureIndex>> subsets(pending.size());
+        for (std::size_t t = 0; t < pending.size(); ++t) {
+            expansions[pending[t]].listInto(subsets[t]);
+        }
+        correct = scorer.remote->countCorrect(subsets);
+        Metrics::add(Counter::DistanceEvaluations, static_cast<std::uint64_t>(pending.size()) * rows * (rows - 1));
+    } else if (termination != nullptr) {
+        // Subsets answered by the memo already set the bar
+        level.emplace(rows, pending.size(), keep);
+        std::vector<char> isPending(expansions.size(), 0);
+        for (std::size_t t : pending) {
+            isPending[t] = 1;
+        }
+        for (std::size_t t = 0; t < expansions.size(); ++t) {
+            if (!isPending[t]) {
+                level->finish(static_cast<std::size_t>(std::llround(accuracies[t] * static_cast<double>(rows))));
+            }
+        }
+        
+        const std::size_t termRows = termination->blockRows();
+        blocks = WorkScheduler::blockCount(rows, termRows);
+        WorkScheduler::run(pending.size(), rows, termRows, termination->blockOrder(),
+                           [&](std::size_t task, std::size_t begin, std::size_t end) {
+            if (level->stopped(task)) {
+                neighbors[task].finishBlock(blocks);
+                return;
+            }
+            const std::size_t blockCorrect = scoreUnit(task, begin, end);
+            level->record(task, end - begin, blockCorrect);
+            termination->addErrors(begin / termRows, end - begin - blockCorrect);
+        });
+        termination->countLevel(*level, pending.size());
+    } else {
+        WorkScheduler::run(pending.size(), rows, blockRows, scoreUnit);
+    }
+    
+    for (std::size_t t = 0; t < pending.size(); ++t) {
+        accuracies[pending[t]] = level && !level->complete(t)
+            ? -1.0
+            : static_cast<double>(correct[t]) / static_cast<double>(rows);
+    }
+    rememberExpansions(scorer.memo, expansions, pending, accuracies);
+}
+
+// Score the given candidate slots of one level through scoreExpansions
+void scoreCandidates(
+    const CandidateScorer& scorer,
+    const std::vector<FeatureIndex>& current,
+    const std::vector<FeatureIndex>& candidates,
+    const std::vector<std::size_t>& slots,
+    bool adding,
+    std::vector<std::vector<FeatureIndex>>& threadLists,
+    std::vector<PruningStats>& threadPruning,
+    std::vector<double>& accuracies
+) {
+    const std::vector<Expansion> expansions = expansionsOf(current, candidates, slots, adding);
+    std::vector<double> scored(expansions.size(), 0.0);
+    scoreExpansions(scorer, expansions, threadLists, threadPruning, scored);
+    for (std::size_t t = 0; t < slots.size(); ++t) {
+        accuracies[slots[t]] = scored[t];
+    }
+}
+
+// Score the candidates the memo does not hold with an evaluator that counts
+// correct predictions for a whole list of candidate features in one pass
+// (the sorted sweep or the distance cache)
+template <typename Evaluate>
+void scoreLevel(
+    EvaluationMemo* memo,
+    const std::vector<FeatureIndex>& current,
+    const std::vector<FeatureIndex>& candidates,
+    std::size_t candidateCount,
+    bool adding,
+    double instanceCount,
+    std::vector<double>& accuracies,
+    Evaluate evaluate
+) {
+    const std::vector<Expansion> expansions = expansionsOf(current, candidates, allSlots(candidateCount), adding);
+    const std::vector<std::size_t> pending = recallExpansions(memo, expansions, accuracies);
+    if (pending.empty()) {
+        return;
+    }
+    
+    const auto rows = static_cast<std::uint64_t>(instanceCount);
+    Metrics::add(Counter::LeaveOneOutCalls, pending.size());
+    Metrics::add(Counter::DistanceEvaluations, pending.size() * rows * (rows - 1));
+    
+    std::vector<FeatureIndex> features(pending.size());
+    for (std::size_t t = 0; t < pending.size(); ++t) {
+        features[t] = candidates[pending[t]];
+    }
+    auto correct = evaluate(features);
+    for (std::size_t t = 0; t < pending.size(); ++t) {
+        accuracies[pending[t]] = static_cast<double>(correct[t]) / instanceCount;
+    }
+    rememberExpansions(memo, expansions, pending, accuracies);
+}
+
+// Score every candidate on the screening sample, then re-score the best
+// options.screeningTopK exactly. Candidates that were not re-scored get an
+// accuracy of -1 so they are never selected
+void screenCandidates(
+    const CandidateScreen& screen,
+    const CandidateScorer& levelScorer,
+    const std::vector<FeatureIndex>& current,
+    const std::vector<FeatureIndex>& candidates,
+    std::size_t candidateCount,
+    bool adding,
+    const SearchOptions& options,
+    std::vector<std::vector<FeatureIndex>>& threadLists,
+    std::vector<PruningStats>& threadPruning,
+    std::vector<double>& screened,
+    std::vector<double>& accuracies,
+    ScreeningStats& stats
+) {
+    // Screening keeps a ranking and the re-scored accuracies feed its error
+    // statistics, so neither stops candidates early
+    const CandidateScorer sampleScorer(screen.sample(), screen.labels());
+    CandidateScorer scorer = levelScorer;
+    scorer.termination = nullptr;
+    const std::vector<std::size_t> slots = allSlots(candidateCount);
+    scoreCandidates(sampleScorer, current, candidates, slots, adding, threadLists, threadPruning, screened);
+    
+    auto top = CandidateScreen::topCandidates(
+        screened, candidateCount, std::max<std::size_t>(1, options.screeningTopK)
+    );
+    std::fill(accuracies.begin(), accuracies.begin() + candidateCount, -1.0);
+    scoreCandidates(scorer, current, candidates, top, adding, threadLists, threadPruning, accuracies);
+    
+    BestCandidate rescoredBest;
+    for (std::size_t slot : top) {
+        rescoredBest = betterCandidate(rescoredBest, {accuracies[slot], candidates[slot], true});
+        stats.absoluteErrorSum += std::abs(screened[slot] - accuracies[slot]);
+    }
+    stats.levels++;
+    stats.candidatesScreened += candidateCount;
+    stats.candidatesRescored += top.size();
+    if (!top.empty() && rescoredBest.feature == candidates[top[0]]) {
+        stats.topAgreements++;
+    }
+    
+    if (options.screeningAudit) {
+        std::vector<std::size_t> remaining;
+        for (std::size_t c = 0; c < candidateCount; ++c) {
+            if (accuracies[c] < 0.0) {
+                remaining.push_back(c);
+            }
+        }
+        std::vector<double> exact(accuracies.begin(), accuracies.begin() + candidateCount);
+        scoreCandidates(scorer, current, candidates, remaining, adding, threadLists, threadPruning, exact);
+        
+        // A hit means screening lost nothing: the exact best is re-scored
+        BestCandidate exactBest = selectBest(candidates, exact, candidateCount);
+        stats.auditedLevels++;
+        if (exactBest.accuracy == rescoredBest.accuracy) {
+            stats.auditHits++;
+        }
+    }
+}
+
+// Successive halving of a level's candidates: score the survivors on each
+// round's sample and keep the best, then score the finalists exactly.
+// Dropped candidates get an accuracy of -1 and keep their last sampled
+// score in `sampled`
+void halveCandidates(
+    const SuccessiveHalving& halving,
+    const CandidateScorer& scorer,
+    const std::vector<FeatureIndex>& current,
+    const std::vector<FeatureIndex>& candidates,
+    std::size_t candidateCount,
+    bool adding,
+    std::vector<std::vector<FeatureIndex>>& threadLists,
+    std::vector<PruningStats>& threadPruning,
+    std::vector<double>& sampled,
+    std::vector<double>& accuracies,
+    HalvingStats& stats
+) {
+    HalvingLevel level;
+    std::vector<std::size_t> survivors = allSlots(candidateCount);
+    for (std::size_t r = 0; r < halving.roundCount() && survivors.size() > halving.finalists(); ++r) {
+        const CandidateScreen& round = halving.round(r);
+        const CandidateScorer sampleScorer(round.sample(), round.labels());
+        scoreCandidates(sampleScorer, current, candidates, survivors, adding, threadLists, threadPruning, sampled);
+        level.rounds.push_back({round.sampleRows(), survivors.size()});
+        stats.distanceComputations += survivors.size() * SuccessiveHalving::distanceComputations(round.sampleRows());
+        
+        // Best sampled scores first; survivors are ascending, so ties keep the lower slot
+        const std::size_t kept = halving.survivors(survivors.size());
+        std::stable_sort(survivors.begin(), survivors.end(), [&](std::size_t a, std::size_t b) {
+            return sampled[a] > sampled[b];
+        });
+        survivors.resize(kept);
+        std::sort(survivors.begin(), survivors.end());
+    }
+    
+    std::fill(accuracies.begin(), accuracies.begin() + candidateCount, -1.0);
+    scoreCandidates(scorer, current, candidates, survivors, adding, threadLists, threadPruning, accuracies);
+    level.finalists = survivors.size();
+    
+    const std::uint64_t full = SuccessiveHalving::distanceComputations(scorer.labels.size());
+    stats.distanceComputations += survivors.size() * full;
+    stats.distanceComputationsFull += candidateCount * full;
+    stats.levels.push_back(std::move(level));
+}
+
+// Scoring state of the strategies that evaluate arbitrary subsets (beam and
+// floating search): NUMA placement, the coordinator, the compact copy or the
+// early-abandoning search, the memo, and per-thread scratch lists. There is
+// no incremental cache or screening: those follow a single current set
+class ExpansionEngine {
+public:
+    ExpansionEngine(
+        const DataMatrix& data,
+        const LabelVector& labels,
+        const SearchOptions& options,
+        SearchResult& result,
+        bool verbose
+    ) : data_(data), labels_(labels), options_(options), affinity_(options.threadAffinity) {
+        const NumaTopology& topology = NumaTopology::detect();
+        replicas_ = placeData(data, topology, options, result.placement);
+        if (verbose) {
+            std::cout << "Data placement: " << result.placement.toString() << std::endl;
+        }
+        distributedBefore_ = checkCoordinator(options, data, labels);
+        memoBefore_ = checkMemo(options, data, labels);
+        
+        if (options.coordinator != nullptr) {
+            // Every subset the memo does not hold goes to the workers
+        } else if (options.storagePrecision != StoragePrecision::Float64 && !data.empty()) {
+            compact_ = std::make_unique<CompactMatrix>(data, options.storagePrecision);
+        } else if (options.partialDistanceSearch) {
+            pruned_ = std::make_unique<PartialDistanceSearch>(data);
+        }
+        if (options.earlyTermination && !data.empty()) {
+            termination_ = std::make_unique<EarlyTermination>(data.size());
+        }
+        
+        threadLists_.resize(static_cast<std::size_t>(omp_get_max_threads()));
+        for (auto& list : threadLists_) {
+            list.reserve(data.cols());
+        }
+        threadPruning_.resize(threadLists_.size());
+    }
+    
+    // Exact accuracy of a whole subset, e.g. a starting point
+    double accuracy(const FeatureSet& features) const {
+        return memoizedAccuracy(options_.memo, data_, labels_, features);
+    }
+    
+    // Accuracies of a batch; with early termination only the best `keep`
+    // are certain to be scored, the others may be -1
+    void score(const std::vector<Expansion>& expansions, std::vector<double>& accuracies, std::size_t keep = 1) {
+        // Reduced-precision accuracies are approximate and never enter the memo
+        CandidateScorer scorer(data_, labels_);
+        scorer.compact = compact_.get();
+        scorer.pruned = pruned_.get();
+        scorer.replicas = replicas_.get();
+        scorer.remote = options_.coordinator;
+        scorer.memo = compact_ ? nullptr : options_.memo;
+        scorer.termination = termination_.get();
+        accuracies.assign(expansions.size(), 0.0);
+        scoreExpansions(scorer, expansions, threadLists_, threadPruning_, accuracies, keep);
+    }
+    
+    // Add the engine's counters to a finished search
+    void finish(SearchResult& result) const {
+        for (const auto& stats : threadPruning_) {
+            result.pruning.merge(stats);
+        }
+        if (options_.coordinator != nullptr) {
+            result.distributed = distributedSince(distributedBefore_, options_.coordinator->stats());
+        }
+        if (options_.memo != nullptr) {
+            result.memo = memoSince(memoBefore_, options_.memo->stats());
+        }
+        if (termination_) {
+            result.termination = termination_->stats();
+        }
+    }
+    
+private:
+    const DataMatrix& data_;
+    const LabelVector& labels_;
+    const SearchOptions& options_;
+    ThreadAffinityGuard affinity_;
+    std::unique_ptr<NumaReplicas> replicas_;
+    std::unique_ptr<CompactMatrix> compact_;
+    std::unique_ptr<PartialDistanceSearch> pruned_;
+    std::unique_ptr<EarlyTermination> termination_;
+    std::vector<std::vector<FeatureIndex>> threadLists_;
+    std::vector<PruningStats> threadPruning_;
+    DistributedStats distributedBefore_;
+    MemoStats memoBefore_;
+};
+
+void printSubset(const std::vector<FeatureIndex>& features, double accuracy) {
+    std::cout << "Using feature(s) " << listToString(features);
+    if (accuracy < 0.0) {
+        std::cout << " stopped early" << std::endl;
+        return;
+    }
+    std::cout << " accuracy is " << std::fixed << std::setprecision(1) << (accuracy * 100.0) << "%" << std::endl;
+}
+
+void printOpenMP() {
+    #ifdef _OPENMP
+    std::cout << "Using OpenMP version " << _OPENMP
+              << " with a maximum of " << omp_get_max_threads()
+              << " threads." << std::endl;
+    #else
+    std::cout << "OpenMP is not enabled." << std::endl;
+    #endif
+}
+
+// Record a step of the search trace and keep the best subset seen
+void recordStep(SearchResult& result, const std::vector<FeatureIndex>& features, double accuracy) {
+    FeatureSet subset(features.begin(), features.end());
+    result.allResults.push_back({subset, accuracy});
+    if (accuracy > result.bestAccuracy) {
+        result.bestAccuracy = accuracy;
+        result.bestFeatureSet = subset;
+    }
+}
+
+// Sequential floating selection (Pudil et al.): each step adds (forward) or
+// removes (backward) the best feature, then keeps taking the best step in
+// the opposite direction while that beats the best subset of its size seen
+// so far. Strict improvement bounds the number of backtracking steps
+SearchResult floatingSelection(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    bool verbose,
+    const SearchOptions& options,
+    bool forward
+) {
+    SearchResult result;
+    result.bestAccuracy = -1.0;
+    const std::size_t numFeatures = data.cols();
+    
+    if (verbose) {
+        std::cout << "Beginning Sequential Floating " << (forward ? "Forward" : "Backward")
+                  << " Selection search." << std::endl;
+        printOpenMP();
+    }
+    ExpansionEngine engine(data, labels, options, result, verbose);
+    
+    std::vector<FeatureIndex> current;
+    if (!forward) {
+        for (FeatureIndex f = 0; f < numFeatures; ++f) {
+            current.push_back(f);
+        }
+    }
+    
+    // Best accuracy reached by a subset of each size
+    std::vector<double> bestOfSize(numFeatures + 1, -1.0);
+    double startAccuracy = engine.accuracy(FeatureSet(current.begin(), current.end()));
+    bestOfSize[current.size()] = startAccuracy;
+    if (verbose) {
+        printSubset(current, startAccuracy);
+    }
+    recordStep(result, current, startAccuracy);
+    
+    std::vector<FeatureIndex> candidates;
+    std::vector<double> accuracies;
+    std::size_t steps = 0;
+    
+    // Best single step from current in one direction
+    auto bestStep = [&](bool adding) {
+        candidates.clear();
+        std::size_t next = 0;
+        for (FeatureIndex f = 0; f < numFeatures; ++f) {
+            const bool member = next < current.size() && current[next] == f;
+            next += member ? 1 : 0;
+            if (member != adding) {
+                candidates.push_back(f);
+            }
+        }
+        Metrics::LevelTimer levelTimer(forward ? "sffs" : "sbfs", ++steps, candidates.size());
+        engine.score(expansionsOf(current, candidates, allSlots(candidates.size()), adding), accuracies);
+        if (verbose) {
+            printCandidates(current, candidates, accuracies, candidates.size(), adding);
+        }
+        return selectBest(candidates, accuracies, candidates.size());
+    };
+    
+    auto apply = [&](FeatureIndex feature, bool adding, double accuracy) {
+        if (adding) {
+            current.insert(std::lower_bound(current.begin(), current.end(), feature), feature);
+        } else {
+            current.erase(std::find(current.begin(), current.end(), feature));
+        }
+        bestOfSize[current.size()] = std::max(bestOfSize[current.size()], accuracy);
+        if (verbose) {
+            std::cout << (adding ? "Added" : "Removed") << " feature " << (feature + 1)
+                      << ", feature set " << listToString(current) << " accuracy is "
+                      << std::fixed << std::setprecision(1) << (accuracy * 100.0) << "%" << std::endl;
+        }
+        recordStep(result, current, accuracy);
+    };
+    
+    // A forward search ends with every feature; a backward one keeps at
+    // least one, like backwardElimination
+    const std::size_t stopSize = forward ? numFeatures : std::min<std::size_t>(1, numFeatures);
+    while (current.size() != stopSize) {
+        BestCandidate step = bestStep(forward);
+        apply(step.feature, forward, step.accuracy);
+        
+        // Conditional steps back never undo the first level, which is exhaustive
+        while (forward ? current.size() > 2 : current.size() + 2 < numFeatures) {
+            BestCandidate back = bestStep(!forward);
+            const std::size_t size = forward ? current.size() - 1 : current.size() + 1;
+            if (!(back.accuracy > bestOfSize[size])) {
+                break;
+            }
+            apply(back.feature, !forward, back.accuracy);
+        }
+    }
+    
+    // Like backwardElimination, also consider the empty set
+    if (!forward && !current.empty()) {
+        double emptyAccuracy = engine.accuracy(FeatureSet());
+        if (verbose) {
+            printSubset({}, emptyAccuracy);
+        }
+        recordStep(result, {}, emptyAccuracy);
+    }
+    
+    engine.finish(result);
+    if (verbose) {
+        std::cout << "Finished search!! The best feature subset is "
+                  << featureSetToString(result.bestFeatureSet)
+                  << ", which has an accuracy of " << std::fixed << std::setprecision(1)
+                  << (result.bestAccuracy * 100.0) << "%" << std::endl;
+    }
+    return result;
+}
+
+// Greedy forward selection or backward elimination with a scorer that has
+// no double matrix: a StreamingEvaluator over a mapped dataset, or a
+// CompactMatrix on its own. Candidates are scored as (candidate x row block)
+// units; `accuracy` scores a whole subset, with the empty set meaning every
+// feature as in the in-memory searches. Early termination and maxLevels
+// apply; the options that need the double matrix (distance cache,
+// screening, halving, precision checks, partial distance search, NUMA
+// placement, workers, memo and checkpoints) do not
+template <typename Accuracy>
+SearchResult scorerSelection(
+    CandidateScorer scorer,
+    std::size_t numFeatures,
+    Accuracy accuracy,
+    const char* description,
+    bool verbose,
+    const SearchOptions& options,
+    bool forward
+) {
+    SearchResult result;
+    result.bestAccuracy = -1.0;
+    
+    if (verbose) {
+        std::cout << "Beginning " << description << " search." << std::endl;
+        printOpenMP();
+    }
+    
+    std::vector<FeatureIndex> current;
+    if (!forward) {
+        for (FeatureIndex f = 0; f < numFeatures; ++f) {
+            current.push_back(f);
+        }
+    }
+    
+    Metrics::add(Counter::LeaveOneOutCalls);
+    double startAccuracy = accuracy(FeatureSet(current.begin(), current.end()));
+    if (verbose) {
+        printSubset(current, startAccuracy);
+    }
+    recordStep(result, current, startAccuracy);
+    
+    std::unique_ptr<EarlyTermination> termination;
+    if (options.earlyTermination && !scorer.labels.empty()) {
+        termination = std::make_unique<EarlyTermination>(scorer.labels.size());
+    }
+    scorer.termination = termination.get();
+    
+    std::vector<FeatureIndex> candidates;
+    std::vector<double> accuracies;
+    std::vector<std::vector<FeatureIndex>> threadLists(static_cast<std::size_t>(omp_get_max_threads()));
+    for (auto& list : threadLists) {
+        list.reserve(numFeatures);
+    }
+    std::vector<PruningStats> threadPruning(threadLists.size());
+    
+    // Backward elimination keeps at least one feature, then adds the empty set
+    const std::size_t stopSize = forward ? numFeatures : std::min<std::size_t>(1, numFeatures);
+    for (std::size_t level = 0; current.size() != stopSize && !levelLimitReached(options, level); ++level) {
+        candidates.clear();
+        for (FeatureIndex f = 0; f < numFeatures; ++f) {
+            if (std::binary_search(current.begin(), current.end(), f) != forward) {
+                candidates.push_back(f);
+            }
+        }
+        Metrics::LevelTimer levelTimer(forward ? "forward" : "backward", level + 1, candidates.size());
+        
+        accuracies.assign(candidates.size(), 0.0);
+        scoreCandidates(
+            scorer, current, candidates, allSlots(candidates.size()), forward,
+            threadLists, threadPruning, accuracies
+        );
+        if (verbose) {
+            printCandidates(current, candidates, accuracies, candidates.size(), forward);
+        }
+        
+        BestCandidate best = selectBest(candidates, accuracies, candidates.size());
+        if (forward) {
+            current.insert(std::lower_bound(current.begin(), current.end(), best.feature), best.feature);
+        } else {
+            current.erase(std::find(current.begin(), current.end(), best.feature));
+        }
+        if (verbose) {
+            std::cout << "Feature set " << listToString(current)
+                      << " was best, accuracy is " << std::fixed << std::setprecision(1)
+                      << (best.accuracy * 100.0) << "%" << std::endl;
+        }
+        recordStep(result, current, best.accuracy);
+    }
+    
+    if (!forward && current.size() == 1) {
+        Metrics::add(Counter::LeaveOneOutCalls);
+        double emptyAccuracy = accuracy(FeatureSet());
+        if (verbose) {
+            printSubset({}, emptyAccuracy);
+        }
+        recordStep(result, {}, emptyAccuracy);
+    }
+    
+    if (termination) {
+        result.termination = termination->stats();
+    }
+    if (verbose) {
+        std::cout << "Finished search!! The best feature subset is "
+                  << featureSetToString(result.bestFeatureSet)
+                  << ", which has an accuracy of " << std::fixed << std::setprecision(1)
+                  << (result.bestAccuracy * 100.0) << "%" << std::endl;
+    }
+    return result;
+}
+
+// scorerSelection reading the mapped columns of a StreamingEvaluator
+SearchResult streamingSelection(
+    const StreamingEvaluator& evaluator,
+    bool verbose,
+    const SearchOptions& options,
+    bool forward
+) {
+    const DataMatrix none;
+    CandidateScorer scorer(none, evaluator.labels());
+    scorer.streaming = &evaluator;
+    return scorerSelection(
+        scorer, evaluator.cols(),
+        [&](const FeatureSet& subset) { return evaluator.leaveOneOutCrossValidation(subset); },
+        forward ? "streamed Forward Selection" : "streamed Backward Elimination",
+        verbose, options, forward
+    );
+}
+
+// scorerSelection on reduced-precision storage alone
+SearchResult compactSelection(
+    const CompactMatrix& data,
+    const LabelVector& labels,
+    bool verbose,
+    const SearchOptions& options,
+    bool forward
+) {
+    if (data.rows() != labels.size()) {
+        throw std::invalid_argument("Mismatch between number of labels and data points");
+    }
+    const DataMatrix none;
+    CandidateScorer scorer(none, labels);
+    scorer.compact = &data;
+    return scorerSelection(
+        scorer, data.cols(),
+        [&](const FeatureSet& subset) { return data.leaveOneOutCrossValidation(labels, subset); },
+        forward ? "compact Forward Selection" : "compact Backward Elimination",
+        verbose, options, forward
+    );
+}
+
+} // namespace
+
 SearchResult FeatureSelection::forwardSelection(
     const DataMatrix& data,
     const LabelVector& labels,
-    bool verbose
+    bool verbose,
+    const SearchOptions& options
 ) {
     Timer timer("Forward Selection");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
     
     SearchResult result;
     result.bestAccuracy = 0.0;
@@ -26,119 +1126,221 @@ SearchResult FeatureSelection::forwardSelection(
     
     if (verbose) {
         std::cout << "Beginning Forward Selection search." << std::endl;
-        
-        // Print OpenMP information if available
-        #ifdef _OPENMP
-        std::cout << "Using OpenMP version " << _OPENMP 
-                  << " with a maximum of " << omp_get_max_threads() 
-                  << " threads." << std::endl;
-        #else
-        std::cout << "OpenMP is not enabled." << std::endl;
-        #endif
+        printOpenMP();
     }
     
-    // Start with empty feature set
-    FeatureSet currentSet;
+    const NumaTopology& topology = NumaTopology::detect();
+    const ThreadAffinityGuard affinityGuard(options.threadAffinity);
+    auto replicas = placeData(data, topology, options, result.placement);
+    if (verbose) {
+        std::cout << "Data placement: " << result.placement.toString() << std::endl;
+    }
+    const DistributedStats distributedBefore = checkCoordinator(options, data, labels);
+    const MemoStats memoBefore = checkMemo(options, data, labels);
     
-    // First evaluate with no features (default rate)
-    double baselineAccuracy = NearestNeighbor::leaveOneOutCrossValidation(
-        data, labels, currentSet, false
-    );
+    // A resumed search takes its trace from the checkpoint and continues
+    // after the last completed level
+    const std::uint64_t datasetHash = options.checkpointPath.empty()
+        ? 0 : SearchCheckpoint::hashDataset(data, labels);
+    auto checkpoint = resumeCheckpoint(options, SearchDirection::Forward, data, datasetHash);
+    if (checkpoint) {
+        result.allResults = checkpoint->allResults;
+        result.bestFeatureSet = checkpoint->bestFeatureSet;
+        result.bestAccuracy = checkpoint->bestAccuracy;
+        result.resumedLevels = checkpoint->levelsCompleted;
+        if (verbose) {
+            std::cout << "Resuming from " << options.checkpointPath << " after "
+                      << checkpoint->levelsCompleted << " levels" << std::endl;
+        }
+    } else {
+        // Start with empty feature set
+        FeatureSet emptySet;
+        
+        // First evaluate with no features (default rate)
+        double baselineAccuracy = memoizedAccuracy(options.memo, data, labels, emptySet);
+        
+        if (verbose) {
+            std::cout << "Using feature(s) " << featureSetToString(emptySet)
+                      << " accuracy is " << std::fixed << std::setprecision(1)
+                      << (baselineAccuracy * 100.0) << "%" << std::endl;
+        }
+        
+        result.allResults.push_back({emptySet, baselineAccuracy});
+        result.bestFeatureSet = emptySet;
+        result.bestAccuracy = baselineAccuracy;
+    }
     
-    if (verbose) {
-        std::cout << "Using feature(s) " << featureSetToString(currentSet) 
-                  << " accuracy is " << std::fixed << std::setprecision(1) 
-                  << (baselineAccuracy * 100.0) << "%" << std::endl;
+    // Screening or successive halving on row samples, distributed workers or
+    // reduced-precision storage replace the cache, as does early termination
+    // (it stops candidates scored per row block, which the cache does not
+    // do); otherwise keep incremental distances over the current set when
+    // they fit the budget
+    std::unique_ptr<CandidateScreen> screen;
+    std::unique_ptr<SuccessiveHalving> halving;
+    std::unique_ptr<DistanceCache> cache;
+    std::unique_ptr<CompactMatrix> compact;
+    if (options.screeningRows > 0 && options.screeningRows < data.size()) {
+        screen = std::make_unique<CandidateScreen>(data, labels, options.screeningRows, options.screeningSeed);
+    } else if (options.halvingRows > 0 && options.halvingRows < data.size()) {
+        halving = std::make_unique<SuccessiveHalving>(
+            data, labels, options.halvingRows, options.halvingKeep, options.halvingFinalists, options.halvingSeed
+        );
+    } else if (options.coordinator != nullptr) {
+        // Every uncached candidate goes to the workers
+    } else if (options.storagePrecision != StoragePrecision::Float64 && !data.empty()) {
+        compact = std::make_unique<CompactMatrix>(data, options.storagePrecision);
+    } else if (!options.earlyTermination && !data.empty() &&
+               DistanceCache::requiredBytes(data.size()) <= options.distanceCacheBudget) {
+        cache = std::make_unique<DistanceCache>(data, labels);
+        if (checkpoint && !checkpoint->restoreCache(*cache)) {
+            cache->reset(FeatureSet(checkpoint->current.begin(), checkpoint->current.end()));
+        }
+    }
+    std::unique_ptr<PartialDistanceSearch> pruned;
+    if (!cache && !compact && !options.coordinator && options.partialDistanceSearch) {
+        pruned = std::make_unique<PartialDistanceSearch>(data);
+    }
+    // Reduced-precision accuracies are approximate and never enter the memo
+    EvaluationMemo* memo = compact ? nullptr : options.memo;
+    std::unique_ptr<EarlyTermination> termination;
+    if (options.earlyTermination && !cache && !data.empty()) {
+        termination = std::make_unique<EarlyTermination>(data.size());
     }
+    CandidateScorer scorer(data, labels);
+    scorer.compact = compact.get();
+    scorer.pruned = pruned.get();
+    scorer.replicas = replicas.get();
+    scorer.remote = options.coordinator;
+    scorer.memo = memo;
+    scorer.termination = termination.get();
     
-    result.allResults.push_back({currentSet, baselineAccuracy});
-    result.bestFeatureSet = currentSet;
-    result.bestAccuracy = baselineAccuracy;
+    // Working state, allocated once for the whole search: the current set as
+    // a bitset plus its ascending list, one accuracy slot per candidate, and
+    // a scratch feature list per thread
+    const double instanceCount = static_cast<double>(data.size());
+    FeatureBitset currentSet(numFeatures);
+    std::vector<FeatureIndex> currentList;
+    currentList.reserve(numFeatures);
+    std::vector<FeatureIndex> candidates;
+    candidates.reserve(numFeatures);
+    std::vector<double> accuracies(numFeatures, 0.0);
+    std::vector<double> screened(numFeatures, 0.0);
+    std::vector<std::vector<FeatureIndex>> threadLists(static_cast<std::size_t>(omp_get_max_threads()));
+    for (auto& list : threadLists) {
+        list.reserve(numFeatures);
+    }
+    std::vector<PruningStats> threadPruning(threadLists.size());
+    if (checkpoint) {
+        currentList = checkpoint->current;
+        for (FeatureIndex feature : currentList) {
+            currentSet.insert(feature);
+        }
+    }
     
     // At each level, add the feature that gives the best accuracy
-    for (std::size_t i = 0; i < numFeatures; ++i) {
-        FeatureIndex bestFeatureToAdd = 0;
-        double bestNewAccuracy = 0.0;
-        bool foundBetter = false;
-        
-        // Store results from each candidate evaluation
-        struct CandidateResult {
-            FeatureIndex feature;
-            double accuracy;
-            FeatureSet featureSet;
-        };
-        
-        std::vector<CandidateResult> candidateResults;
-        candidateResults.reserve(numFeatures - currentSet.size());
-        
-        // For thread safety during results collection
-        std::mutex resultsMutex;
-        
-        // Process features in parallel
-        #pragma omp parallel for schedule(dynamic) if(numFeatures > 8)
+    const std::size_t firstLevel = currentList.size();
+    for (std::size_t i = firstLevel; i < numFeatures && !levelLimitReached(options, i - firstLevel); ++i) {
+        candidates.clear();
         for (FeatureIndex featureToAdd = 0; featureToAdd < numFeatures; ++featureToAdd) {
-            // Skip if this feature is already in the set
-            if (currentSet.find(featureToAdd) != currentSet.end()) {
-                continue;
+            if (!currentSet.contains(featureToAdd)) {
+                candidates.push_back(featureToAdd);
             }
-            
-            // Create a candidate set with the new feature
-            FeatureSet candidateSet = currentSet;
-            candidateSet.insert(featureToAdd);
-            
-            // Evaluate the candidate set
-            double accuracy = NearestNeighbor::leaveOneOutCrossValidation(
-                data, labels, candidateSet, false
+        }
+        const std::size_t candidateCount = candidates.size();
+        Metrics::LevelTimer levelTimer("forward", i + 1, candidateCount);
+        
+        if (currentList.empty()) {
+            // Single-feature candidates are scored exactly by sorting each column
+            scoreLevel(memo, currentList, candidates, candidateCount, true, instanceCount, accuracies,
+                       [&](const std::vector<FeatureIndex>& features) {
+                           return SortedSweep::evaluateFeatures(data, labels, features);
+                       });
+        } else if (screen) {
+            screenCandidates(
+                *screen, scorer, currentList, candidates, candidateCount, true,
+                options, threadLists, threadPruning, screened, accuracies, result.screening
+            );
+        } else if (halving) {
+            halveCandidates(
+                *halving, scorer, currentList, candidates, candidateCount, true,
+                threadLists, threadPruning, screened, accuracies, result.halving
+            );
+        } else if (cache) {
+            // Score every addition in one pass over the cached distances
+            scoreLevel(memo, currentList, candidates, candidateCount, true, instanceCount, accuracies,
+                       [&](const std::vector<FeatureIndex>& features) {
+                           return cache->evaluateAdditions(features);
+                       });
+        } else {
+            scoreCandidates(
+                scorer, currentList, candidates, allSlots(candidateCount), true,
+                threadLists, threadPruning, accuracies
             );
-            
-            // Store result (thread-safe)
-            {
-                std::lock_guard<std::mutex> lock(resultsMutex);
-                candidateResults.push_back({featureToAdd, accuracy, candidateSet});
-            }
-            
-            // Verbose output (thread-safe)
-            if (verbose) {
-                #pragma omp critical
-                {
-                    std::cout << "Using feature(s) " << featureSetToString(candidateSet) 
-                              << " accuracy is " << std::fixed << std::setprecision(1) 
-                              << (accuracy * 100.0) << "%" << std::endl;
-                }
-            }
         }
         
-        // Find the best candidate
-        for (const auto& candidate : candidateResults) {
-            if (!foundBetter || candidate.accuracy > bestNewAccuracy) {
-                bestNewAccuracy = candidate.accuracy;
-                bestFeatureToAdd = candidate.feature;
-                foundBetter = true;
-            }
+        if (verbose) {
+            printCandidates(
+                currentList, candidates, accuracies, candidateCount, true,
+                (screen || halving) && !currentList.empty() ? &screened : nullptr
+            );
         }
         
+        // Find the best candidate
+        BestCandidate best = selectBest(candidates, accuracies, candidateCount);
+        
         // If we couldn't find a better feature, break
-        if (!foundBetter) {
+        if (!best.valid) {
             break;
         }
         
         // Add the best feature to our current set
-        currentSet.insert(bestFeatureToAdd);
+        currentSet.insert(best.feature);
+        currentList.insert(
+            std::lower_bound(currentList.begin(), currentList.end(), best.feature),
+            best.feature
+        );
+        if (cache) {
+            cache->commitAddition(best.feature);
+        }
+        
+        FeatureSet levelSet(currentList.begin(), currentList.end());
+        if (compact && options.validatePrecision) {
+            // Scored on both paths here: the level's own accuracy may come
+            // from the double sorted sweep or the memo
+            result.precisionChecks.push_back(compact->validate(data, labels, {levelSet}).front());
+        }
         
         if (verbose) {
-            std::cout << "Feature set " << featureSetToString(currentSet) 
+            std::cout << "Feature set " << featureSetToString(levelSet)
                       << " was best, accuracy is " << std::fixed << std::setprecision(1) 
-                      << (bestNewAccuracy * 100.0) << "%" << std::endl;
+                      << (best.accuracy * 100.0) << "%" << std::endl;
         }
         
         // Record result
-        result.allResults.push_back({currentSet, bestNewAccuracy});
+        result.allResults.push_back({levelSet, best.accuracy});
         
         // Update overall best result if applicable
-        if (bestNewAccuracy > result.bestAccuracy) {
-            result.bestAccuracy = bestNewAccuracy;
-            result.bestFeatureSet = currentSet;
+        if (best.accuracy > result.bestAccuracy) {
+            result.bestAccuracy = best.accuracy;
+            result.bestFeatureSet = levelSet;
         }
+        
+        saveCheckpoint(
+            options, SearchDirection::Forward, data, datasetHash, i + 1, currentList, result, cache.get()
+        );
+    }
+    
+    for (const auto& stats : threadPruning) {
+        result.pruning.merge(stats);
+    }
+    if (options.coordinator != nullptr) {
+        result.distributed = distributedSince(distributedBefore, options.coordinator->stats());
+    }
+    if (options.memo != nullptr) {
+        result.memo = memoSince(memoBefore, options.memo->stats());
+    }
+    if (termination) {
+        result.termination = termination->stats();
     }
     
     if (verbose) {
@@ -154,9 +1356,11 @@ SearchResult FeatureSelection::forwardSelection(
 SearchResult FeatureSelection::backwardElimination(
     const DataMatrix& data,
     const LabelVector& labels,
-    bool verbose
+    bool verbose,
+    const SearchOptions& options
 ) {
     Timer timer("Backward Elimination");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
     
     SearchResult result;
     result.bestAccuracy = 0.0;
@@ -168,139 +1372,189 @@ SearchResult FeatureSelection::backwardElimination(
     
     if (verbose) {
         std::cout << "Beginning Backward Elimination search." << std::endl;
-        
-        // Print OpenMP information if available
-        #ifdef _OPENMP
-        std::cout << "Using OpenMP version " << _OPENMP 
-                  << " with a maximum of " << omp_get_max_threads() 
-                  << " threads." << std::endl;
-        #else
-        std::cout << "OpenMP is not enabled." << std::endl;
-        #endif
+        printOpenMP();
     }
     
+    const NumaTopology& topology = NumaTopology::detect();
+    const ThreadAffinityGuard affinityGuard(options.threadAffinity);
+    auto replicas = placeData(data, topology, options, result.placement);
+    if (verbose) {
+        std::cout << "Data placement: " << result.placement.toString() << std::endl;
+    }
+    const DistributedStats distributedBefore = checkCoordinator(options, data, labels);
+    const MemoStats memoBefore = checkMemo(options, data, labels);
+    
     // Start with all features
-    FeatureSet currentSet;
+    FeatureSet fullSet;
     for (FeatureIndex i = 0; i < numFeatures; ++i) {
-        currentSet.insert(i);
+        fullSet.insert(i);
     }
     
-    // First evaluate with all features
-    double baselineAccuracy = NearestNeighbor::leaveOneOutCrossValidation(
-        data, labels, currentSet, false
-    );
+    // Ascending list of the remaining features; each level's candidates
+    std::vector<FeatureIndex> allFeatures(fullSet.begin(), fullSet.end());
     
-    if (verbose) {
-        std::cout << "Using feature(s) " << featureSetToString(currentSet) 
-                  << " accuracy is " << std::fixed << std::setprecision(1) 
-                  << (baselineAccuracy * 100.0) << "%" << std::endl;
-    }
-    
-    result.allResults.push_back({currentSet, baselineAccuracy});
-    result.bestFeatureSet = currentSet;
-    result.bestAccuracy = baselineAccuracy;
-    
-    // Store all features in a vector for parallel processing
-    std::vector<FeatureIndex> allFeatures(currentSet.begin(), currentSet.end());
-    
-    // At each level, remove the feature that gives the least reduction in accuracy
-    for (std::size_t i = 0; i < numFeatures && allFeatures.size() > 1; ++i) {
-        // Store results from each candidate evaluation
-        struct CandidateResult {
-            FeatureIndex feature;
-            double accuracy;
-            FeatureSet featureSet;
-        };
-        
-        std::vector<CandidateResult> candidateResults;
-        candidateResults.reserve(allFeatures.size());
-        
-        // For thread safety during results collection
-        std::mutex resultsMutex;
-        
-        // Process features in parallel
-        #pragma omp parallel for schedule(dynamic) if(allFeatures.size() > 8)
-        for (std::size_t j = 0; j < allFeatures.size(); ++j) {
-            FeatureIndex featureToRemove = allFeatures[j];
-            
-            // Create a candidate set without the feature
-            FeatureSet candidateSet = currentSet;
-            candidateSet.erase(featureToRemove);
-            
-            // Skip if we'd be removing the last feature
-            if (candidateSet.empty()) {
-                continue;
-            }
-            
-            // Evaluate the candidate set
-            double accuracy = NearestNeighbor::leaveOneOutCrossValidation(
-                data, labels, candidateSet, false
-            );
-            
-            // Store result (thread-safe)
-            {
-                std::lock_guard<std::mutex> lock(resultsMutex);
-                candidateResults.push_back({featureToRemove, accuracy, candidateSet});
-            }
-            
-            // Verbose output (thread-safe)
-            if (verbose) {
-                #pragma omp critical
-                {
-                    std::cout << "Using feature(s) " << featureSetToString(candidateSet) 
-                              << " accuracy is " << std::fixed << std::setprecision(1) 
-                              << (accuracy * 100.0) << "%" << std::endl;
-                }
-            }
+    // A resumed search takes its trace from the checkpoint and continues
+    // after the last completed level
+    const std::uint64_t datasetHash = options.checkpointPath.empty()
+        ? 0 : SearchCheckpoint::hashDataset(data, labels);
+    auto checkpoint = resumeCheckpoint(options, SearchDirection::Backward, data, datasetHash);
+    if (checkpoint) {
+        result.allResults = checkpoint->allResults;
+        result.bestFeatureSet = checkpoint->bestFeatureSet;
+        result.bestAccuracy = checkpoint->bestAccuracy;
+        result.resumedLevels = checkpoint->levelsCompleted;
+        allFeatures = checkpoint->current;
+        if (verbose) {
+            std::cout << "Resuming from " << options.checkpointPath << " after "
+                      << checkpoint->levelsCompleted << " levels" << std::endl;
         }
+    } else {
+        // First evaluate with all features
+        double baselineAccuracy = memoizedAccuracy(options.memo, data, labels, fullSet);
         
-        // If no candidates were evaluated, break
-        if (candidateResults.empty()) {
-            break;
+        if (verbose) {
+            std::cout << "Using feature(s) " << featureSetToString(fullSet)
+                      << " accuracy is " << std::fixed << std::setprecision(1)
+                      << (baselineAccuracy * 100.0) << "%" << std::endl;
         }
         
-        // Find the best candidate
-        FeatureIndex bestFeatureToRemove = candidateResults[0].feature;
-        double bestNewAccuracy = candidateResults[0].accuracy;
+        result.allResults.push_back({fullSet, baselineAccuracy});
+        result.bestFeatureSet = fullSet;
+        result.bestAccuracy = baselineAccuracy;
+    }
+    
+    // Screening or successive halving on row samples, distributed workers or
+    // reduced-precision storage replace the cache, as does early termination;
+    // otherwise keep the full-feature distances, updated by subtraction as
+    // features are removed
+    std::unique_ptr<CandidateScreen> screen;
+    std::unique_ptr<SuccessiveHalving> halving;
+    std::unique_ptr<DistanceCache> cache;
+    std::unique_ptr<CompactMatrix> compact;
+    if (options.screeningRows > 0 && options.screeningRows < data.size()) {
+        screen = std::make_unique<CandidateScreen>(data, labels, options.screeningRows, options.screeningSeed);
+    } else if (options.halvingRows > 0 && options.halvingRows < data.size()) {
+        halving = std::make_unique<SuccessiveHalving>(
+            data, labels, options.halvingRows, options.halvingKeep, options.halvingFinalists, options.halvingSeed
+        );
+    } else if (options.coordinator != nullptr) {
+        // Every uncached candidate goes to the workers
+    } else if (options.storagePrecision != StoragePrecision::Float64 && !data.empty()) {
+        compact = std::make_unique<CompactMatrix>(data, options.storagePrecision);
+    } else if (!options.earlyTermination && !data.empty() &&
+               DistanceCache::requiredBytes(data.size()) <= options.distanceCacheBudget) {
+        cache = std::make_unique<DistanceCache>(data, labels);
+        cache->setRefreshInterval(options.cacheRefreshInterval);
+        if (!checkpoint || !checkpoint->restoreCache(*cache)) {
+            cache->reset(FeatureSet(allFeatures.begin(), allFeatures.end()));
+        }
+    }
+    std::unique_ptr<PartialDistanceSearch> pruned;
+    if (!cache && !compact && !options.coordinator && options.partialDistanceSearch) {
+        pruned = std::make_unique<PartialDistanceSearch>(data);
+    }
+    // Reduced-precision accuracies are approximate and never enter the memo
+    EvaluationMemo* memo = compact ? nullptr : options.memo;
+    std::unique_ptr<EarlyTermination> termination;
+    if (options.earlyTermination && !cache && !data.empty()) {
+        termination = std::make_unique<EarlyTermination>(data.size());
+    }
+    CandidateScorer scorer(data, labels);
+    scorer.compact = compact.get();
+    scorer.pruned = pruned.get();
+    scorer.replicas = replicas.get();
+    scorer.remote = options.coordinator;
+    scorer.memo = memo;
+    scorer.termination = termination.get();
+
+    // Working state, allocated once for the whole search
+    const double instanceCount = static_cast<double>(data.size());
+    std::vector<double> accuracies(numFeatures, 0.0);
+    std::vector<double> screened(numFeatures, 0.0);
+    std::vector<std::vector<FeatureIndex>> threadLists(static_cast<std::size_t>(omp_get_max_threads()));
+    for (auto& list : threadLists) {
+        list.reserve(numFeatures);
+    }
+    std::vector<PruningStats> threadPruning(threadLists.size());
+    
+    // At each level, remove the feature that gives the least reduction in accuracy;
+    // removing the last feature is never a candidate
+    const std::size_t firstLevel = numFeatures - allFeatures.size();
+    for (std::size_t i = firstLevel; i < numFeatures && allFeatures.size() > 1 &&
+                                     !levelLimitReached(options, i - firstLevel); ++i) {
+        const std::size_t candidateCount = allFeatures.size();
+        Metrics::LevelTimer levelTimer("backward", i + 1, candidateCount);
         
-        for (std::size_t j = 1; j < candidateResults.size(); ++j) {
-            if (candidateResults[j].accuracy > bestNewAccuracy) {
-                bestNewAccuracy = candidateResults[j].accuracy;
-                bestFeatureToRemove = candidateResults[j].feature;
-            }
+        if (screen) {
+            screenCandidates(
+                *screen, scorer, allFeatures, allFeatures, candidateCount, false,
+                options, threadLists, threadPruning, screened, accuracies, result.screening
+            );
+        } else if (halving) {
+            halveCandidates(
+                *halving, scorer, allFeatures, allFeatures, candidateCount, false,
+                threadLists, threadPruning, screened, accuracies, result.halving
+            );
+        } else if (cache) {
+            // Score every removal in one pass over the cached distances
+            scoreLevel(memo, allFeatures, allFeatures, candidateCount, false, instanceCount, accuracies,
+                       [&](const std::vector<FeatureIndex>& features) {
+                           return cache->evaluateRemovals(features);
+                       });
+        } else {
+            scoreCandidates(
+                scorer, allFeatures, allFeatures, allSlots(candidateCount), false,
+                threadLists, threadPruning, accuracies
+            );
         }
         
+        if (verbose) {
+            printCandidates(
+                allFeatures, allFeatures, accuracies, candidateCount, false,
+                screen || halving ? &screened : nullptr
+            );
+        }
+        
+        // Find the best candidate
+        BestCandidate best = selectBest(allFeatures, accuracies, candidateCount);
+        
         // Remove the best feature from our current set
-        currentSet.erase(bestFeatureToRemove);
+        allFeatures.erase(std::find(allFeatures.begin(), allFeatures.end(), best.feature));
+        if (cache) {
+            cache->commitRemoval(best.feature);
+        }
         
-        // Update the allFeatures vector
-        allFeatures.erase(
-            std::remove(allFeatures.begin(), allFeatures.end(), bestFeatureToRemove),
-            allFeatures.end()
-        );
+        FeatureSet levelSet(allFeatures.begin(), allFeatures.end());
+        if (compact && options.validatePrecision) {
+            // Scored on both paths here: the level's own accuracy may come
+            // from the double sorted sweep or the memo
+            result.precisionChecks.push_back(compact->validate(data, labels, {levelSet}).front());
+        }
         
         if (verbose) {
-            std::cout << "Feature set " << featureSetToString(currentSet) 
+            std::cout << "Feature set " << featureSetToString(levelSet)
                       << " was best, accuracy is " << std::fixed << std::setprecision(1) 
-                      << (bestNewAccuracy * 100.0) << "%" << std::endl;
+                      << (best.accuracy * 100.0) << "%" << std::endl;
         }
         
         // Record result
-        result.allResults.push_back({currentSet, bestNewAccuracy});
+        result.allResults.push_back({levelSet, best.accuracy});
         
         // Update overall best result if applicable
-        if (bestNewAccuracy > result.bestAccuracy) {
-            result.bestAccuracy = bestNewAccuracy;
-            result.bestFeatureSet = currentSet;
+        if (best.accuracy > result.bestAccuracy) {
+            result.bestAccuracy = best.accuracy;
+            result.bestFeatureSet = levelSet;
         }
+        
+        saveCheckpoint(
+            options, SearchDirection::Backward, data, datasetHash, i + 1, allFeatures, result, cache.get()
+        );
     }
     
-    // Also consider the empty set
-    if (!allFeatures.empty()) {
+    // Also consider the empty set, unless maxLevels stopped the search first
+    if (allFeatures.size() == 1) {
         FeatureSet emptySet;
-        double emptySetAccuracy = NearestNeighbor::leaveOneOutCrossValidation(
-            data, labels, emptySet, false
-        );
+        double emptySetAccuracy = memoizedAccuracy(options.memo, data, labels, emptySet);
         
         if (verbose) {
             std::cout << "Using feature(s) " << featureSetToString(emptySet) 
@@ -316,6 +1570,19 @@ SearchResult FeatureSelection::backwardElimination(
         }
     }
     
+    for (const auto& stats : threadPruning) {
+        result.pruning.merge(stats);
+    }
+    if (options.coordinator != nullptr) {
+        result.distributed = distributedSince(distributedBefore, options.coordinator->stats());
+    }
+    if (options.memo != nullptr) {
+        result.memo = memoSince(memoBefore, options.memo->stats());
+    }
+    if (termination) {
+        result.termination = termination->stats();
+    }
+    
     if (verbose) {
         std::cout << "Finished search!! The best feature subset is " 
                   << featureSetToString(result.bestFeatureSet) 
@@ -326,6 +1593,170 @@ SearchResult FeatureSelection::backwardElimination(
     return result;
 }
 
+SearchResult FeatureSelection::beamSearch(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    bool verbose,
+    const SearchOptions& options
+) {
+    Timer timer("Beam Search");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
+    
+    SearchResult result;
+    result.bestAccuracy = -1.0;
+    const std::size_t numFeatures = data.cols();
+    const std::size_t width = std::max<std::size_t>(1, options.beamWidth);
+    
+    if (verbose) {
+        std::cout << "Beginning Beam Search with width " << width << "." << std::endl;
+        printOpenMP();
+    }
+    ExpansionEngine engine(data, labels, options, result, verbose);
+    
+    double emptyAccuracy = engine.accuracy(FeatureSet());
+    if (verbose) {
+        printSubset({}, emptyAccuracy);
+    }
+    recordStep(result, {}, emptyAccuracy);
+    
+    // Ascending feature lists of the subsets kept at the current level
+    std::vector<std::vector<FeatureIndex>> beam(1);
+    std::vector<Expansion> expansions;
+    std::vector<double> accuracies;
+    std::vector<std::vector<FeatureIndex>> children;
+    
+    for (std::size_t level = 1; level <= numFeatures; ++level) {
+        // Every distinct child of every beam subset, scored in one batch;
+        // children reached from two parents are kept once
+        expansions.clear();
+        children.clear();
+        std::set<std::vector<std::uint64_t>> seen;
+        for (const auto& parent : beam) {
+            FeatureBitset child(numFeatures);
+            for (FeatureIndex feature : parent) {
+                child.insert(feature);
+            }
+            for (FeatureIndex f = 0; f < numFeatures; ++f) {
+                if (child.contains(f)) {
+                    continue;
+                }
+                child.insert(f);
+                if (seen.insert(child.words()).second) {
+                    expansions.push_back({&parent, f, true});
+                    children.emplace_back();
+                    expansions.back().listInto(children.back());
+                }
+                child.erase(f);
+            }
+        }
+        Metrics::LevelTimer levelTimer("beam", level, expansions.size());
+        engine.score(expansions, accuracies, width);
+        
+        // Keep the best `width` children; ties go to the lexicographically
+        // smallest subset, so width 1 matches forwardSelection
+        std::vector<std::size_t> order = allSlots(children.size());
+        const std::size_t kept = std::min(width, order.size());
+        std::partial_sort(order.begin(), order.begin() + kept, order.end(), [&](std::size_t a, std::size_t b) {
+            if (accuracies[a] != accuracies[b]) {
+                return accuracies[a] > accuracies[b];
+            }
+            return children[a] < children[b];
+        });
+        
+        if (verbose) {
+            for (std::size_t c = 0; c < children.size(); ++c) {
+                printSubset(children[c], accuracies[c]);
+            }
+        }
+        
+        std::vector<std::vector<FeatureIndex>> nextBeam(kept);
+        for (std::size_t k = 0; k < kept; ++k) {
+            nextBeam[k] = children[order[k]];
+        }
+        const double levelAccuracy = accuracies[order[0]];
+        if (verbose) {
+            std::cout << "Feature set " << listToString(nextBeam[0])
+                      << " was best, accuracy is " << std::fixed << std::setprecision(1)
+                      << (levelAccuracy * 100.0) << "%" << std::endl;
+        }
+        recordStep(result, nextBeam[0], levelAccuracy);
+        beam = std::move(nextBeam);
+    }
+    
+    engine.finish(result);
+    if (verbose) {
+        std::cout << "Finished search!! The best feature subset is "
+                  << featureSetToString(result.bestFeatureSet)
+                  << ", which has an accuracy of " << std::fixed << std::setprecision(1)
+                  << (result.bestAccuracy * 100.0) << "%" << std::endl;
+    }
+    return result;
+}
+
+SearchResult FeatureSelection::floatingForwardSelection(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    bool verbose,
+    const SearchOptions& options
+) {
+    Timer timer("Floating Forward Selection");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
+    return floatingSelection(data, labels, verbose, options, true);
+}
+
+SearchResult FeatureSelection::floatingBackwardSelection(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    bool verbose,
+    const SearchOptions& options
+) {
+    Timer timer("Floating Backward Selection");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
+    return floatingSelection(data, labels, verbose, options, false);
+}
+
+SearchResult FeatureSelection::forwardSelection(
+    const StreamingEvaluator& evaluator,
+    bool verbose,
+    const SearchOptions& options
+) {
+    Timer timer("Streamed Forward Selection");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
+    return streamingSelection(evaluator, verbose, options, true);
+}
+
+SearchResult FeatureSelection::backwardElimination(
+    const StreamingEvaluator& evaluator,
+    bool verbose,
+    const SearchOptions& options
+) {
+    Timer timer("Streamed Backward Elimination");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
+    return streamingSelection(evaluator, verbose, options, false);
+}
+
+SearchResult FeatureSelection::forwardSelection(
+    const CompactMatrix& data,
+    const LabelVector& labels,
+    bool verbose,
+    const SearchOptions& options
+) {
+    Timer timer("Compact Forward Selection");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
+    return compactSelection(data, labels, verbose, options, true);
+}
+
+SearchResult FeatureSelection::backwardElimination(
+    const CompactMatrix& data,
+    const LabelVector& labels,
+    bool verbose,
+    const SearchOptions& options
+) {
+    Timer timer("Compact Backward Elimination");
+    Metrics::ScopedTimer searchTimer(Phase::Search);
+    return compactSelection(data, labels, verbose, options, false);
+}
+
 void FeatureSelection::printSearchResults(
     const SearchResult& result, 
     const std::string& algorithmName
@@ -334,12 +1765,85 @@ void FeatureSelection::printSearchResults(
     std::cout << "Best feature subset: " << featureSetToString(result.bestFeatureSet) << std::endl;
     std::cout << "Best accuracy: " << std::fixed << std::setprecision(1) 
               << (result.bestAccuracy * 100.0) << "%" << std::endl;
+    std::cout << "Data placement: " << result.placement.toString() << std::endl;
     
     std::cout << "\nFeature Sets Evaluated:" << std::endl;
     for (const auto& [featureSet, accuracy] : result.allResults) {
         std::cout << "  " << featureSetToString(featureSet) << ": " 
                   << std::fixed << std::setprecision(1) << (accuracy * 100.0) << "%" << std::endl;
     }
+    
+    if (result.pruning.candidates > 0) {
+        std::cout << "\nPartial distance search abandoned " << std::fixed << std::setprecision(1)
+                  << (result.pruning.abandonRate() * 100.0) << "% of candidates and computed "
+                  << (result.pruning.workFraction() * 100.0) << "% of distance terms" << std::endl;
+    }
+    
+    if (result.distributed.unitsSent > 0) {
+        std::cout << "\nDistributed workers scored " << result.distributed.unitsSent << " units";
+        if (result.distributed.workersLost > 0) {
+            std::cout << "; " << result.distributed.workersLost << " workers lost, "
+                      << result.distributed.unitsRequeued << " units re-sent";
+        }
+        std::cout << std::endl;
+    }
+    
+    if (!result.halving.levels.empty()) {
+        std::cout << "\nSuccessive halving schedule (candidates@rows per round, then exact finalists):" << std::endl;
+        for (std::size_t l = 0; l < result.halving.levels.size(); ++l) {
+            const HalvingLevel& level = result.halving.levels[l];
+            std::cout << "  level " << (l + 1) << ":";
+            for (const HalvingRound& round : level.rounds) {
+                std::cout << " " << round.candidates << "@" << round.sampleRows;
+            }
+            std::cout << ", " << level.finalists << " exact" << std::endl;
+        }
+        std::cout << "Successive halving computed " << result.halving.distanceComputations << " of "
+                  << result.halving.distanceComputationsFull << " distances (saved " << std::fixed
+                  << std::setprecision(1) << (result.halving.savedFraction() * 100.0) << "%)" << std::endl;
+    }
+    
+    if (result.termination.candidates > 0) {
+        std::cout << "\nEarly termination stopped " << std::fixed << std::setprecision(1)
+                  << (result.termination.stopRate() * 100.0) << "% of candidates and scored "
+                  << (result.termination.workFraction() * 100.0) << "% of rows" << std::endl;
+    }
+    
+    if (result.memo.lookups > 0) {
+        std::cout << "\nEvaluation memo answered " << result.memo.hits << " of " << result.memo.lookups
+                  << " lookups (" << std::fixed << std::setprecision(1) << (result.memo.hitRate() * 100.0)
+                  << "%)" << std::endl;
+    }
+    
+    if (result.resumedLevels > 0) {
+        std::cout << "\nResumed from a checkpoint after " << result.resumedLevels << " levels" << std::endl;
+    }
+    
+    if (!result.precisionChecks.empty()) {
+        std::size_t differing = 0;
+        double largest = 0.0;
+        for (const PrecisionCheck& check : result.precisionChecks) {
+            if (check.difference() != 0.0) {
+                ++differing;
+            }
+            largest = std::max(largest, std::abs(check.difference()));
+        }
+        std::cout << "\nReduced-precision accuracy differed from double in " << differing << " of "
+                  << result.precisionChecks.size() << " levels (largest difference "
+                  << std::fixed << std::setprecision(1) << (largest * 100.0) << "%)" << std::endl;
+    }
+    
+    if (result.screening.levels > 0) {
+        const ScreeningStats& screening = result.screening;
+        std::cout << "\nScreening re-scored " << screening.candidatesRescored << " of "
+                  << screening.candidatesScreened << " candidates; the top screened candidate was best in "
+                  << screening.topAgreements << " of " << screening.levels << " levels, mean |screened - exact| "
+                  << std::fixed << std::setprecision(1) << (screening.meanAbsoluteError() * 100.0) << "%" << std::endl;
+        if (screening.auditedLevels > 0) {
+            std::cout << "Audit: the exact best survived screening in " << screening.auditHits << " of "
+                      << screening.auditedLevels << " levels" << std::endl;
+        }
+    }
     std::cout << std::endl;
 }
 
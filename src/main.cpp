@@ -1,9 +1,36 @@
+#include "feature_selection/binary_dataset.h"
 #include "feature_selection/data_loader.h"
+#include "feature_selection/distributed_evaluator.h"
+#include "feature_selection/feature_selection.h"
+#include "feature_selection/metrics.h"
+#include "feature_selection/streaming_evaluator.h"
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
 
 using namespace feature_selection;
 
+namespace {
+
+// Value of a flag that takes a count of at least 1
+std::size_t positiveCount(const std::string& flag, const std::string& value) {
+    std::size_t end = 0;
+    unsigned long count = 0;
+    try {
+        count = value.empty() || value[0] == '-' ? 0 : std::stoul(value, &end);
+    } catch (const std::logic_error&) {
+        count = 0;
+    }
+    if (count == 0 || end != value.size()) {
+        throw std::invalid_argument(flag + " needs a positive integer, got '" + value + "'");
+    }
+    return count;
+}
+
+} // namespace
+
 int main(int argc, char** argv) {
     std::cout << "Feature Selection Data Loader Test" << std::endl;
     std::cout << "=====================================" << std::endl;
@@ -11,20 +38,173 @@ int main(int argc, char** argv) {
     // Default dataset path
     std::string datasetPath = "../P2_datasets/CS170_Large_Data__1.txt";
     
+    // Repeated runs reuse a binary copy of the dataset unless --no-cache is
+    // given; --normalize zscore|minmax|robust scales the features first
+    LoadOptions loadOptions;
+    loadOptions.useBinaryCache = true;
+    
+    // --search forward|backward|beam|sffs|sbfs runs a search after loading
+    // (--beam-width sets the beam); for forward and backward, --checkpoint
+    // saves progress after every level and --resume continues from it;
+    // --memo keeps every scored subset in a file shared between runs;
+    // --early-termination stops scoring candidates that cannot win (and
+    // turns off the distance cache, which scores them all at once);
+    // --halving <rows> halves forward and backward candidates over row
+    // samples starting at that size; --stream runs forward or backward out
+    // of core, converting a text dataset to its binary cache chunk by chunk
+    // and scoring candidates from the mapping, so the matrix is never loaded;
+    // --precision float32|int16|int8 scores on reduced-precision storage,
+    // which forward and backward load without keeping the doubles;
+    // --workers <n> scores candidates in n feature_selection_worker
+    // processes that map the dataset's binary copy
+    std::string normalization = "none";
+    std::string search;
+    std::string beamWidth;
+    std::string halvingRows;
+    std::string workers;
+    bool stream = false;
+    std::string precision = "float64";
+    std::string memoPath;
+    
+    // --metrics <path> writes counters and timings when the run ends, as
+    // JSON for a .json path and Prometheus text otherwise
+    std::string metricsPath;
+    SearchOptions searchOptions;
+    
     // If command line argument is provided, use it as the dataset path
-    if (argc > 1) {
-        datasetPath = argv[1];
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--no-cache") {
+            loadOptions.useBinaryCache = false;
+        } else if (arg == "--normalize" && i + 1 < argc) {
+            normalization = argv[++i];
+        } else if (arg == "--search" && i + 1 < argc) {
+            search = argv[++i];
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            searchOptions.checkpointPath = argv[++i];
+        } else if (arg == "--beam-width" && i + 1 < argc) {
+            beamWidth = argv[++i];
+        } else if (arg == "--early-termination") {
+            searchOptions.earlyTermination = true;
+        } else if (arg == "--halving" && i + 1 < argc) {
+            halvingRows = argv[++i];
+        } else if (arg == "--workers" && i + 1 < argc) {
+            workers = argv[++i];
+        } else if (arg == "--precision" && i + 1 < argc) {
+            precision = argv[++i];
+        } else if (arg == "--stream") {
+            stream = true;
+        } else if (arg == "--resume") {
+            searchOptions.resume = true;
+        } else if (arg == "--memo" && i + 1 < argc) {
+            memoPath = argv[++i];
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            metricsPath = argv[++i];
+        } else {
+            datasetPath = arg;
+        }
     }
     
+    auto writeMetrics = [&metricsPath]() {
+        if (!metricsPath.empty()) {
+            if (!Metrics::enabled()) {
+                std::cerr << "Warning: built without FEATURE_SELECTION_METRICS, metrics are all zero" << std::endl;
+            }
+            Metrics::write(metricsPath);
+        }
+    };
+    
     std::cout << "Loading dataset: " << datasetPath << std::endl;
     
     try {
+        loadOptions.normalization = Normalizer::parseMethod(normalization);
+        if (!beamWidth.empty()) {
+            searchOptions.beamWidth = positiveCount("--beam-width", beamWidth);
+        }
+        if (!halvingRows.empty()) {
+            searchOptions.halvingRows = positiveCount("--halving", halvingRows);
+        }
+        const std::size_t workerCount = workers.empty() ? 0 : positiveCount("--workers", workers);
+        if (workerCount > 0 && (stream || precision != "float64")) {
+            std::cerr << "--workers cannot be combined with --stream or --precision" << std::endl;
+            return 1;
+        }
+        if (workerCount > 0 && loadOptions.normalization != NormalizationMethod::None) {
+            std::cerr << "--workers cannot normalize; workers map the raw binary dataset" << std::endl;
+            return 1;
+        }
+        
+        if (stream) {
+            if (search != "forward" && search != "backward") {
+                std::cerr << "--stream needs --search forward or backward" << std::endl;
+                return 1;
+            }
+            if (loadOptions.normalization != NormalizationMethod::None) {
+                std::cerr << "--stream cannot normalize; convert a normalized dataset first" << std::endl;
+                return 1;
+            }
+            const BinaryDatasetFile binaryFile = DataLoader::binaryDatasetFor(datasetPath, loadOptions);
+            BinaryDataset dataset(binaryFile.path(), loadOptions.verifyChecksum);
+            StreamingEvaluator evaluator(dataset);
+            std::cout << "\nStreaming " << dataset.rows() << " instances with " << dataset.cols()
+                      << " features" << std::endl;
+            if (search == "forward") {
+                SearchResult result = FeatureSelection::forwardSelection(evaluator, true, searchOptions);
+                FeatureSelection::printSearchResults(result, "Streamed Forward Selection");
+            } else {
+                SearchResult result = FeatureSelection::backwardElimination(evaluator, true, searchOptions);
+                FeatureSelection::printSearchResults(result, "Streamed Backward Elimination");
+            }
+            writeMetrics();
+            return 0;
+        }
+        
+        searchOptions.storagePrecision = CompactMatrix::parsePrecision(precision);
+        if (searchOptions.storagePrecision != StoragePrecision::Float64 &&
+            (search == "forward" || search == "backward")) {
+            auto [compact, labels] = DataLoader::loadCompactDataset(
+                datasetPath, searchOptions.storagePrecision, loadOptions
+            );
+            std::cout << "\nStored as " << precision << ": " << compact.rows() << " instances with "
+                      << compact.cols() << " features in " << compact.storageBytes() << " bytes" << std::endl;
+            if (search == "forward") {
+                SearchResult result = FeatureSelection::forwardSelection(compact, labels, true, searchOptions);
+                FeatureSelection::printSearchResults(result, "Compact Forward Selection");
+            } else {
+                SearchResult result = FeatureSelection::backwardElimination(compact, labels, true, searchOptions);
+                FeatureSelection::printSearchResults(result, "Compact Backward Elimination");
+            }
+            writeMetrics();
+            return 0;
+        }
+        
+        // Workers map the binary copy, so the search loads that same file
+        std::unique_ptr<BinaryDatasetFile> binaryFile;
+        std::unique_ptr<DistributedCoordinator> coordinator;
+        if (workerCount > 0) {
+            binaryFile = std::make_unique<BinaryDatasetFile>(DataLoader::binaryDatasetFor(datasetPath, loadOptions));
+            const std::string& binaryPath = binaryFile->path();
+            const std::string socketPath = BinaryDataset::temporaryPath(
+                (std::filesystem::temp_directory_path() / "feature_selection.sock").string()
+            );
+            coordinator = std::make_unique<DistributedCoordinator>(socketPath, binaryPath);
+            coordinator->spawnWorkers(
+                (std::filesystem::path(argv[0]).parent_path() / "feature_selection_worker").string(), workerCount
+            );
+            std::cout << "Started " << coordinator->workerCount() << " workers on " << binaryPath << std::endl;
+            searchOptions.coordinator = coordinator.get();
+            datasetPath = binaryPath;
+        }
+        
         // Load dataset
-        auto [data, labels] = DataLoader::loadDataset(datasetPath);
+        auto [data, labels] = DataLoader::loadDataset(datasetPath, loadOptions);
         
         // Print dataset information
         std::cout << "\nDataset Information:" << std::endl;
         DataLoader::printDatasetInfo(data, labels);
+        if (loadOptions.normalization != NormalizationMethod::None) {
+            std::cout << "Features normalized: " << Normalizer::methodName(loadOptions.normalization) << std::endl;
+        }
         
         // Print first few data points for verification
         std::cout << "\nFirst 5 data points (showing first 3 features):" << std::endl;
@@ -40,6 +220,39 @@ int main(int argc, char** argv) {
         }
         
         std::cout << "\nData loading successful!" << std::endl;
+        
+        std::unique_ptr<EvaluationMemo> memo;
+        if (!search.empty() && !memoPath.empty()) {
+            memo = std::make_unique<EvaluationMemo>(data, labels);
+            if (std::filesystem::exists(memoPath)) {
+                memo->load(memoPath);
+            }
+            searchOptions.memo = memo.get();
+        }
+        
+        if (search == "forward") {
+            SearchResult result = FeatureSelection::forwardSelection(data, labels, true, searchOptions);
+            FeatureSelection::printSearchResults(result, "Forward Selection");
+        } else if (search == "backward") {
+            SearchResult result = FeatureSelection::backwardElimination(data, labels, true, searchOptions);
+            FeatureSelection::printSearchResults(result, "Backward Elimination");
+        } else if (search == "beam") {
+            SearchResult result = FeatureSelection::beamSearch(data, labels, true, searchOptions);
+            FeatureSelection::printSearchResults(result, "Beam Search");
+        } else if (search == "sffs") {
+            SearchResult result = FeatureSelection::floatingForwardSelection(data, labels, true, searchOptions);
+            FeatureSelection::printSearchResults(result, "Floating Forward Selection");
+        } else if (search == "sbfs") {
+            SearchResult result = FeatureSelection::floatingBackwardSelection(data, labels, true, searchOptions);
+            FeatureSelection::printSearchResults(result, "Floating Backward Selection");
+        } else if (!search.empty()) {
+            std::cerr << "Unknown search: " << search << std::endl;
+            return 1;
+        }
+        if (memo) {
+            memo->save(memoPath);
+        }
+        writeMetrics();
     }
     catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -0,0 +1,189 @@
+#include "feature_selection/metrics.h"
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace feature_selection {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<void, void (*)(void*)>> threads;
+    std::vector<LevelMetrics> levels;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+std::string number(double value) {
+    std::ostringstream out;
+    out << std::setprecision(9) << value;
+    return out.str();
+}
+
+double megabytesPerSecond(std::uint64_t bytes, double seconds) {
+    return seconds > 0.0 ? static_cast<double>(bytes) / 1e6 / seconds : 0.0;
+}
+
+} // namespace
+
+Metrics::ThreadCounters* Metrics::registerThread() {
+    auto* counters = new ThreadCounters();
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.threads.emplace_back(counters, [](void* block) { delete static_cast<ThreadCounters*>(block); });
+    return counters;
+}
+
+void Metrics::recordLevel(const LevelMetrics& level) {
+    if constexpr (kMetricsEnabled) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.levels.push_back(level);
+    }
+}
+
+MetricsSnapshot Metrics::snapshot() {
+    MetricsSnapshot snapshot;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& block : reg.threads) {
+        const auto* counters = static_cast<const ThreadCounters*>(block.get());
+        for (std::size_t c = 0; c < kCounterCount; ++c) {
+            snapshot.counters[c] += counters->counters[c].load(std::memory_order_relaxed);
+        }
+        for (std::size_t p = 0; p < kPhaseCount; ++p) {
+            snapshot.phaseNanoseconds[p] += counters->phaseNanoseconds[p].load(std::memory_order_relaxed);
+            snapshot.phaseCalls[p] += counters->phaseCalls[p].load(std::memory_order_relaxed);
+        }
+    }
+    snapshot.levels = reg.levels;
+    return snapshot;
+}
+
+void Metrics::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& block : reg.threads) {
+        auto* counters = static_cast<ThreadCounters*>(block.get());
+        for (auto& value : counters->counters) {
+            value.store(0, std::memory_order_relaxed);
+        }
+        for (std::size_t p = 0; p < kPhaseCount; ++p) {
+            counters->phaseNanoseconds[p].store(0, std::memory_order_relaxed);
+            counters->phaseCalls[p].store(0, std::memory_order_relaxed);
+        }
+    }
+    reg.levels.clear();
+}
+
+void Metrics::write(const std::string& path) {
+    const MetricsSnapshot current = snapshot();
+    const bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open metrics file: " + path);
+    }
+    file << (json ? current.toJson() : current.toPrometheus());
+    if (!file) {
+        throw std::runtime_error("Could not write metrics file: " + path);
+    }
+}
+
+const char* Metrics::counterName(Counter counter) {
+    switch (counter) {
+        case Counter::DistanceEvaluations: return "distance_evaluations";
+        case Counter::LeaveOneOutCalls: return "leave_one_out_calls";
+        case Counter::BytesLoaded: return "bytes_loaded";
+        case Counter::BytesParsed: return "bytes_parsed";
+        default: return "unknown";
+    }
+}
+
+const char* Metrics::phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Load: return "load";
+        case Phase::Parse: return "parse";
+        case Phase::Normalize: return "normalize";
+        case Phase::Search: return "search";
+        default: return "unknown";
+    }
+}
+
+double MetricsSnapshot::loadMegabytesPerSecond() const {
+    return megabytesPerSecond(counter(Counter::BytesLoaded), seconds(Phase::Load));
+}
+
+double MetricsSnapshot::parseMegabytesPerSecond() const {
+    return megabytesPerSecond(counter(Counter::BytesParsed), seconds(Phase::Parse));
+}
+
+std::string MetricsSnapshot::toJson() const {
+    std::ostringstream out;
+    out << "{\n  \"enabled\": " << (enabled ? "true" : "false") << ",\n  \"counters\": {";
+    for (std::size_t c = 0; c < kCounterCount; ++c) {
+        out << (c == 0 ? "\n" : ",\n") << "    \"" << Metrics::counterName(static_cast<Counter>(c))
+            << "\": " << counters[c];
+    }
+    out << "\n  },\n  \"phases\": {";
+    for (std::size_t p = 0; p < kPhaseCount; ++p) {
+        out << (p == 0 ? "\n" : ",\n") << "    \"" << Metrics::phaseName(static_cast<Phase>(p))
+            << "\": {\"seconds\": " << number(phaseNanoseconds[p] * 1e-9) << ", \"calls\": " << phaseCalls[p] << "}";
+    }
+    out << "\n  },\n  \"throughput\": {\n"
+        << "    \"load_mb_per_second\": " << number(loadMegabytesPerSecond()) << ",\n"
+        << "    \"parse_mb_per_second\": " << number(parseMegabytesPerSecond()) << "\n  },\n"
+        << "  \"levels\": [";
+    for (std::size_t l = 0; l < levels.size(); ++l) {
+        // Search names are fixed identifiers, so they need no escaping
+        out << (l == 0 ? "\n" : ",\n") << "    {\"search\": \"" << levels[l].search
+            << "\", \"level\": " << levels[l].level << ", \"candidates\": " << levels[l].candidates
+            << ", \"seconds\": " << number(levels[l].seconds) << "}";
+    }
+    out << (levels.empty() ? "]\n}\n" : "\n  ]\n}\n");
+    return out.str();
+}
+
+std::string MetricsSnapshot::toPrometheus() const {
+    std::ostringstream out;
+    for (std::size_t c = 0; c < kCounterCount; ++c) {
+        const std::string name = std::string("feature_selection_") + Metrics::counterName(static_cast<Counter>(c)) + "_total";
+        out << "# TYPE " << name << " counter\n" << name << " " << counters[c] << "\n";
+    }
+
+    out << "# TYPE feature_selection_phase_seconds_total counter\n";
+    for (std::size_t p = 0; p < kPhaseCount; ++p) {
+        out << "feature_selection_phase_seconds_total{phase=\"" << Metrics::phaseName(static_cast<Phase>(p))
+            << "\"} " << number(phaseNanoseconds[p] * 1e-9) << "\n";
+    }
+    out << "# TYPE feature_selection_phase_calls_total counter\n";
+    for (std::size_t p = 0; p < kPhaseCount; ++p) {
+        out << "feature_selection_phase_calls_total{phase=\"" << Metrics::phaseName(static_cast<Phase>(p))
+            << "\"} " << phaseCalls[p] << "\n";
+    }
+
+    out << "# TYPE feature_selection_load_megabytes_per_second gauge\n"
+        << "feature_selection_load_megabytes_per_second " << number(loadMegabytesPerSecond()) << "\n"
+        << "# TYPE feature_selection_parse_megabytes_per_second gauge\n"
+        << "feature_selection_parse_megabytes_per_second " << number(parseMegabytesPerSecond()) << "\n";
+
+    out << "# TYPE feature_selection_level_seconds gauge\n";
+    for (const LevelMetrics& level : levels) {
+        out << "feature_selection_level_seconds{search=\"" << level.search << "\",level=\"" << level.level
+            << "\"} " << number(level.seconds) << "\n";
+    }
+    out << "# TYPE feature_selection_level_candidates gauge\n";
+    for (const LevelMetrics& level : levels) {
+        out << "feature_selection_level_candidates{search=\"" << level.search << "\",level=\"" << level.level
+            << "\"} " << level.candidates << "\n";
+    }
+    return out.str();
+}
+
+} // namespace feature_selection
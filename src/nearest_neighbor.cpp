@@ -1,4 +1,9 @@
 #include "feature_selection/nearest_neighbor.h"
+#include "feature_selection/distance_kernels.h"
+#include "feature_selection/metrics.h"
+#include "feature_selection/sorted_sweep.h"
+#include "feature_selection/spatial_index.h"
+#include "feature_selection/tiled_nearest_neighbor.h"
 #include <cmath>
 #include <limits>
 #include <algorithm>
@@ -7,39 +12,58 @@
 
 namespace feature_selection {
 
+namespace {
+
+// Features accumulated between two early-abandon checks in findNearestNeighbor
+constexpr std::size_t kAbandonChunk = 8;
+
+} // namespace
+
+std::vector<FeatureIndex> NearestNeighbor::packFeatures(
+    const FeatureSet& featureSubset,
+    std::size_t featureCount
+) {
+    std::vector<FeatureIndex> packed;
+    packed.reserve(featureSubset.size());
+    for (FeatureIndex idx : featureSubset) {
+        if (idx < featureCount) {
+            packed.push_back(idx);
+        }
+    }
+    return packed;
+}
+
 double NearestNeighbor::calculateDistance(
-    const DataPoint& a, 
-    const DataPoint& b, 
+    RowView a, 
+    RowView b, 
     const FeatureSet& featureSubset
 ) {
-    double sum = 0.0;
+    std::size_t featureCount = std::min(a.size(), b.size());
     
     // If using a specific feature subset
     if (!featureSubset.empty()) {
-        for (FeatureIndex idx : featureSubset) {
-            if (idx < a.size() && idx < b.size()) {
-                double diff = a[idx] - b[idx];
-                sum += diff * diff;
-            }
-        }
-    } 
-    // If using all features
-    else {
-        for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
-            double diff = a[i] - b[i];
-            sum += diff * diff;
-        }
+        auto packed = packFeatures(featureSubset, featureCount);
+        return std::sqrt(DistanceKernels::squaredDistanceIndexed(
+            a.data(), b.data(), packed.data(), packed.size()
+        ));
     }
     
-    return std::sqrt(sum);
+    // If using all features
+    return std::sqrt(DistanceKernels::squaredDistance(a.data(), b.data(), featureCount));
 }
 
 std::size_t NearestNeighbor::findNearestNeighbor(
     const DataMatrix& data,
-    const DataPoint& point,
+    RowView point,
     std::size_t excludeIndex,
     const FeatureSet& featureSubset
 ) {
+    std::size_t featureCount = std::min(point.size(), data.cols());
+    bool useSubset = !featureSubset.empty();
+    auto packed = packFeatures(featureSubset, featureCount);
+    const std::size_t termCount = useSubset ? packed.size() : featureCount;
+    
+    // Squared distances order the same way as distances, so no sqrt is needed
     double minDistance = std::numeric_limits<double>::max();
     std::size_t nearestIndex = 0;
     
@@ -47,8 +71,17 @@ std::size_t NearestNeighbor::findNearestNeighbor(
         if (i == excludeIndex) {
             continue;
         }
+        const double* row = data.rowData(i);
         
-        double distance = calculateDistance(point, data[i], featureSubset);
+        // Accumulate a chunk at a time and abandon the candidate once the
+        // partial sum reaches the best distance, since it can only grow
+        double distance = 0.0;
+        for (std::size_t k = 0; k < termCount && distance < minDistance; k += kAbandonChunk) {
+            std::size_t chunk = std::min(kAbandonChunk, termCount - k);
+            distance += useSubset
+                ? DistanceKernels::squaredDistanceIndexed(point.data(), row, packed.data() + k, chunk)
+                : DistanceKernels::squaredDistance(point.data() + k, row + k, chunk);
+        }
         
         if (distance < minDistance) {
             minDistance = distance;
@@ -71,41 +104,56 @@ double NearestNeighbor::leaveOneOutCrossValidation(
     
     std::size_t totalInstances = data.size();
     std::size_t correctPredictions = 0;
+    Metrics::add(Counter::LeaveOneOutCalls);
+    Metrics::add(Counter::DistanceEvaluations, static_cast<std::uint64_t>(totalInstances) * (totalInstances - 1));
     
-    // Using OpenMP to parallelize the leave-one-out cross-validation
-    #pragma omp parallel reduction(+:correctPredictions)
-    {
-        // Get thread info for debugging/verbose mode
-        int threadId = 0;
-        int numThreads = 1;
-        
+    // The tiled engine reads the selected columns in place, so the subset is
+    // never copied out of the matrix
+    std::vector<FeatureIndex> packed;
+    if (featureSubset.empty()) {
+        for (FeatureIndex f = 0; f < data.cols(); ++f) {
+            packed.push_back(f);
+        }
+    } else {
+        packed = packFeatures(featureSubset, data.cols());
+    }
+    auto source = TiledNearestNeighbor::columns(data);
+    
+    // A single feature is answered exactly by sorting it, and other
+    // low-dimensional subsets of large datasets from a tree
+    const bool singleFeature = packed.size() == 1;
+    NeighborStrategy strategy = singleFeature
+        ? NeighborStrategy::BruteForce
+        : SpatialIndex::chooseStrategy(totalInstances, packed.size());
+    auto index = SpatialIndex::build(strategy, data, packed.data(), packed.size());
+    
+    if (!verbose) {
+        if (singleFeature) {
+            correctPredictions = SortedSweep::countCorrect(data.columnData(packed[0]), labels);
+        } else if (index) {
+            correctPredictions = index->countCorrect(labels);
+        } else {
+            correctPredictions = TiledNearestNeighbor::countCorrect(source, labels, packed.data(), packed.size());
+        }
+    } else {
         #ifdef _OPENMP
-        threadId = omp_get_thread_num();
-        numThreads = omp_get_num_threads();
+        std::cout << "Running with " << omp_get_max_threads() << " threads" << std::endl;
+        #endif
         
-        // Print thread info only from the master thread and only once
-        if (threadId == 0 && verbose) {
-            #pragma omp single
-            {
-                std::cout << "Running with " << numThreads << " threads" << std::endl;
-            }
+        std::vector<std::size_t> nearest;
+        if (singleFeature) {
+            SortedSweep::findAllNearest(data.columnData(packed[0]), totalInstances, nearest);
+        } else if (index) {
+            index->findAllNearest(nearest);
+        } else {
+            TiledNearestNeighbor::findAllNearest(source, totalInstances, packed.data(), packed.size(), nearest);
         }
-        #endif
         
-        // Parallelize the loop over all instances
-        #pragma omp for schedule(dynamic)
         for (std::size_t i = 0; i < totalInstances; ++i) {
-            std::size_t nearestIndex = findNearestNeighbor(data, data[i], i, featureSubset);
-            
-            // Thread-safe verbose output
-            if (verbose) {
-                #pragma omp critical
-                {
-                    std::cout << "Object " << i + 1 << " is class " << labels[i] << std::endl;
-                    std::cout << "Its nearest neighbor is " << nearestIndex + 1 
-                              << " which is in class " << labels[nearestIndex] << std::endl;
-                }
-            }
+            std::size_t nearestIndex = nearest[i];
+            std::cout << "Object " << i + 1 << " is class " << labels[i] << std::endl;
+            std::cout << "Its nearest neighbor is " << nearestIndex + 1 
+                      << " which is in class " << labels[nearestIndex] << std::endl;
             
             if (labels[i] == labels[nearestIndex]) {
                 correctPredictions++;
@@ -117,4 +165,26 @@ double NearestNeighbor::leaveOneOutCrossValidation(
     return accuracy;
 }
 
+std::size_t NearestNeighbor::leaveOneOutCorrect(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    const FeatureIndex* features,
+    std::size_t featureCount
+) {
+    if (data.size() != labels.size()) {
+        return 0;
+    }
+    if (featureCount == 1) {
+        return SortedSweep::countCorrect(data.columnData(features[0]), labels);
+    }
+    
+    auto index = SpatialIndex::build(
+        SpatialIndex::chooseStrategy(data.size(), featureCount), data, features, featureCount
+    );
+    if (index) {
+        return index->countCorrect(labels);
+    }
+    return TiledNearestNeighbor::countCorrect(TiledNearestNeighbor::columns(data), labels, features, featureCount);
+}
+
 } // namespace feature_selection
\ No newline at end of file
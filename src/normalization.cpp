@@ -0,0 +1,195 @@
+#include "feature_selection/normalization.h"
+#include "feature_selection/metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace feature_selection {
+
+namespace {
+
+// Linearly interpolated quantile q of values; reorders them
+double quantile(std::vector<double>& values, double q) {
+    const double position = q * static_cast<double>(values.size() - 1);
+    const auto lower = static_cast<std::size_t>(position);
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    const double low = values[lower];
+    if (lower + 1 >= values.size()) {
+        return low;
+    }
+    const double high = *std::min_element(values.begin() + lower + 1, values.end());
+    return low + (high - low) * (position - static_cast<double>(lower));
+}
+
+// Scales of constant (or empty) columns would divide by zero
+double usableScale(double scale) {
+    return scale > 0.0 && std::isfinite(scale) ? scale : 1.0;
+}
+
+// Statistics of one non-empty column in a single vectorized pass
+ColumnStats statsOf(const double* column, std::size_t rows) {
+    const double shift = column[0];
+    double sum = 0.0;
+    double squares = 0.0;
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -std::numeric_limits<double>::infinity();
+
+    #pragma omp simd reduction(+:sum, squares) reduction(min:lo) reduction(max:hi)
+    for (std::size_t i = 0; i < rows; ++i) {
+        const double d = column[i] - shift;
+        sum += d;
+        squares += d * d;
+        lo = std::min(lo, column[i]);
+        hi = std::max(hi, column[i]);
+    }
+
+    ColumnStats stats;
+    const double n = static_cast<double>(rows);
+    const double meanShift = sum / n;
+    stats.mean = shift + meanShift;
+    stats.stddev = std::sqrt(std::max(0.0, squares / n - meanShift * meanShift));
+    stats.min = lo;
+    stats.max = hi;
+    return stats;
+}
+
+// Center and scale of one column; None leaves the identity transform
+void fitColumn(const double* column, std::size_t rows, NormalizationMethod method, double& center, double& scale) {
+    center = 0.0;
+    scale = 1.0;
+    if (rows == 0 || method == NormalizationMethod::None) {
+        return;
+    }
+    if (method == NormalizationMethod::Robust) {
+        std::vector<double> values(column, column + rows);
+        center = quantile(values, 0.5);
+        scale = usableScale(quantile(values, 0.75) - quantile(values, 0.25));
+        return;
+    }
+    const ColumnStats stats = statsOf(column, rows);
+    if (method == NormalizationMethod::ZScore) {
+        center = stats.mean;
+        scale = usableScale(stats.stddev);
+    } else {
+        center = stats.min;
+        scale = usableScale(stats.max - stats.min);
+    }
+}
+
+void applyColumn(double* column, std::size_t rows, double center, double scale) {
+    #pragma omp simd
+    for (std::size_t i = 0; i < rows; ++i) {
+        column[i] = (column[i] - center) / scale;
+    }
+}
+
+} // namespace
+
+std::vector<ColumnStats> Normalizer::columnStats(const DataMatrix& data) {
+    std::vector<ColumnStats> stats(data.cols());
+    const std::size_t rows = data.rows();
+    if (rows == 0) {
+        return stats;
+    }
+
+    const long long cols = static_cast<long long>(data.cols());
+    #pragma omp parallel for schedule(static) if(rows * data.cols() > (1u << 16))
+    for (long long jj = 0; jj < cols; ++jj) {
+        const std::size_t j = static_cast<std::size_t>(jj);
+        stats[j] = statsOf(data.columnData(j), rows);
+    }
+    return stats;
+}
+
+NormalizationParams Normalizer::fit(const DataMatrix& data, NormalizationMethod method) {
+    NormalizationParams params;
+    params.method = method;
+    if (method == NormalizationMethod::None) {
+        return params;
+    }
+    params.centers.assign(data.cols(), 0.0);
+    params.scales.assign(data.cols(), 1.0);
+
+    const long long cols = static_cast<long long>(data.cols());
+    #pragma omp parallel for schedule(dynamic) if(data.rows() * data.cols() > (1u << 16))
+    for (long long jj = 0; jj < cols; ++jj) {
+        const std::size_t j = static_cast<std::size_t>(jj);
+        fitColumn(data.columnData(j), data.rows(), method, params.centers[j], params.scales[j]);
+    }
+    return params;
+}
+
+void Normalizer::apply(DataMatrix& data, const NormalizationParams& params) {
+    if (params.empty()) {
+        return;
+    }
+    if (params.centers.size() != data.cols() || params.scales.size() != data.cols()) {
+        throw std::invalid_argument("Normalization parameters do not match the dataset's features");
+    }
+
+    // Both views are rewritten with the same arithmetic, so they stay
+    // identical without a transpose
+    const std::size_t rows = data.rows();
+    const std::size_t cols = data.cols();
+    const double* centers = params.centers.data();
+    const double* scales = params.scales.data();
+
+    const long long columnCount = static_cast<long long>(cols);
+    #pragma omp parallel for schedule(static) if(rows * cols > (1u << 16))
+    for (long long jj = 0; jj < columnCount; ++jj) {
+        const std::size_t j = static_cast<std::size_t>(jj);
+        applyColumn(data.mutableColumnData(j), rows, centers[j], scales[j]);
+    }
+
+    const long long rowCount = static_cast<long long>(rows);
+    #pragma omp parallel for schedule(static) if(rows * cols > (1u << 16))
+    for (long long ii = 0; ii < rowCount; ++ii) {
+        double* row = data.mutableRowData(static_cast<std::size_t>(ii));
+        #pragma omp simd
+        for (std::size_t j = 0; j < cols; ++j) {
+            row[j] = (row[j] - centers[j]) / scales[j];
+        }
+    }
+}
+
+void Normalizer::normalizeColumn(
+    double* column,
+    std::size_t rows,
+    NormalizationMethod method,
+    double& center,
+    double& scale
+) {
+    fitColumn(column, rows, method, center, scale);
+    if (method != NormalizationMethod::None) {
+        applyColumn(column, rows, center, scale);
+    }
+}
+
+NormalizationParams Normalizer::normalize(DataMatrix& data, NormalizationMethod method) {
+    Metrics::ScopedTimer timer(Phase::Normalize);
+    NormalizationParams params = fit(data, method);
+    apply(data, params);
+    return params;
+}
+
+const char* Normalizer::methodName(NormalizationMethod method) {
+    switch (method) {
+        case NormalizationMethod::ZScore: return "zscore";
+        case NormalizationMethod::MinMax: return "minmax";
+        case NormalizationMethod::Robust: return "robust";
+        default: return "none";
+    }
+}
+
+NormalizationMethod Normalizer::parseMethod(const std::string& name) {
+    for (NormalizationMethod method : {NormalizationMethod::None, NormalizationMethod::ZScore,
+                                       NormalizationMethod::MinMax, NormalizationMethod::Robust}) {
+        if (name == methodName(method)) {
+            return method;
+        }
+    }
+    throw std::invalid_argument("Unknown normalization '" + name + "'");
+}
+
+} // namespace feature_selection
@@ -0,0 +1,308 @@
+#include "feature_selection/numa_topology.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <omp.h>
+
+#if defined(__linux__)
+#define FEATURE_SELECTION_HAVE_AFFINITY 1
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace feature_selection {
+
+namespace {
+
+const char* kNodeDirectory = "/sys/devices/system/node/";
+
+bool readLine(const std::string& path, std::string& line) {
+    std::ifstream file(path);
+    return static_cast<bool>(std::getline(file, line));
+}
+
+#ifdef FEATURE_SELECTION_HAVE_AFFINITY
+// Bind the calling thread to a set of CPUs; false if the OS refused
+bool bindCurrentThread(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// CPUs the calling thread may run on; empty if the OS would not say
+std::vector<int> currentThreadCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+#endif
+
+} // namespace
+
+std::string PlacementReport::toString() const {
+    std::ostringstream out;
+    out << NumaTopology::placementName(placement) << " on " << nodes << (nodes == 1 ? " node" : " nodes");
+    if (replicas > 0) {
+        out << " (" << replicas << " replicas)";
+    }
+    if (affinity == ThreadAffinity::None) {
+        out << ", threads unpinned";
+        return out.str();
+    }
+    out << ", " << NumaTopology::affinityName(affinity) << " " << threadCpus.size() << " threads (";
+    for (std::size_t n = 0; n < threadsPerNode.size(); ++n) {
+        out << (n > 0 ? "+" : "") << threadsPerNode[n];
+    }
+    out << ")";
+    return out.str();
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) {
+            continue;
+        }
+        try {
+            std::size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            if (first < 0 || last < first) {
+                throw std::invalid_argument(range);
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Malformed CPU list: " + list);
+        }
+    }
+    return cpus;
+}
+
+NumaTopology NumaTopology::fromCpuLists(const std::vector<std::string>& cpuLists) {
+    NumaTopology topology;
+    for (std::size_t id = 0; id < cpuLists.size(); ++id) {
+        NumaNode node;
+        node.id = id;
+        node.cpus = parseCpuList(cpuLists[id]);
+        // Memory-only nodes have no CPU to touch or run on
+        if (!node.cpus.empty()) {
+            topology.nodes_.push_back(node);
+        }
+    }
+    return topology;
+}
+
+const NumaTopology& NumaTopology::detect() {
+    static const NumaTopology detected = [] {
+        NumaTopology topology;
+        std::string online;
+        if (readLine(std::string(kNodeDirectory) + "online", online)) {
+            for (int id : parseCpuList(online)) {
+                std::string cpulist;
+                if (!readLine(kNodeDirectory + ("node" + std::to_string(id)) + "/cpulist", cpulist)) {
+                    continue;
+                }
+                NumaNode node;
+                node.id = static_cast<std::size_t>(id);
+                node.cpus = parseCpuList(cpulist);
+                if (!node.cpus.empty()) {
+                    topology.nodes_.push_back(node);
+                }
+            }
+        }
+
+        if (topology.nodes_.empty()) {
+            NumaNode node;
+            for (int cpu = 0; cpu < omp_get_num_procs(); ++cpu) {
+                node.cpus.push_back(cpu);
+            }
+            topology.nodes_.push_back(node);
+        }
+        return topology;
+    }();
+    return detected;
+}
+
+std::size_t NumaTopology::nodeOfCpu(int cpu) const {
+    for (std::size_t n = 0; n < nodes_.size(); ++n) {
+        const auto& cpus = nodes_[n].cpus;
+        if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) {
+            return n;
+        }
+    }
+    return 0;
+}
+
+std::size_t NumaTopology::currentNode() const {
+#ifdef FEATURE_SELECTION_HAVE_AFFINITY
+    if (nodes_.size() > 1) {
+        return nodeOfCpu(sched_getcpu());
+    }
+#endif
+    return 0;
+}
+
+int NumaTopology::cpuForThread(ThreadAffinity affinity, std::size_t thread) const {
+    if (nodes_.empty()) {
+        return -1;
+    }
+    switch (affinity) {
+        case ThreadAffinity::Compact: {
+            std::size_t total = 0;
+            for (const auto& node : nodes_) {
+                total += node.cpus.size();
+            }
+            std::size_t position = thread % total;
+            for (const auto& node : nodes_) {
+                if (position < node.cpus.size()) {
+                    return node.cpus[position];
+                }
+                position -= node.cpus.size();
+            }
+            return -1;
+        }
+        case ThreadAffinity::Spread: {
+            const NumaNode& node = nodes_[thread % nodes_.size()];
+            return node.cpus[(thread / nodes_.size()) % node.cpus.size()];
+        }
+        default:
+            return -1;
+    }
+}
+
+PlacementReport NumaTopology::pinThreads(ThreadAffinity affinity) const {
+    PlacementReport report;
+    report.affinity = affinity;
+    report.nodes = nodes_.size();
+    report.threadsPerNode.assign(nodes_.size(), 0);
+    if (affinity == ThreadAffinity::None) {
+        return report;
+    }
+
+    report.threadCpus.assign(static_cast<std::size_t>(omp_get_max_threads()), -1);
+    #pragma omp parallel
+    {
+        const std::size_t thread = static_cast<std::size_t>(omp_get_thread_num());
+        int cpu = cpuForThread(affinity, thread);
+#ifdef FEATURE_SELECTION_HAVE_AFFINITY
+        if (cpu >= 0 && bindCurrentThread({cpu})) {
+            report.threadCpus[thread] = cpu;
+        }
+#else
+        (void)cpu;
+#endif
+    }
+
+    for (int cpu : report.threadCpus) {
+        if (cpu >= 0) {
+            report.threadsPerNode[nodeOfCpu(cpu)]++;
+        }
+    }
+    return report;
+}
+
+const char* NumaTopology::placementName(NumaPlacement placement) {
+    switch (placement) {
+        case NumaPlacement::Replicate: return "replicate";
+        default: return "first-touch";
+    }
+}
+
+const char* NumaTopology::affinityName(ThreadAffinity affinity) {
+    switch (affinity) {
+        case ThreadAffinity::Compact: return "compact";
+        case ThreadAffinity::Spread: return "spread";
+        default: return "none";
+    }
+}
+
+ThreadAffinityGuard::ThreadAffinityGuard(ThreadAffinity affinity) {
+#ifdef FEATURE_SELECTION_HAVE_AFFINITY
+    if (affinity == ThreadAffinity::None) {
+        return;
+    }
+    previous_.resize(static_cast<std::size_t>(omp_get_max_threads()));
+    #pragma omp parallel num_threads(static_cast<int>(previous_.size()))
+    {
+        previous_[static_cast<std::size_t>(omp_get_thread_num())] = currentThreadCpus();
+    }
+#else
+    (void)affinity;
+#endif
+}
+
+ThreadAffinityGuard::~ThreadAffinityGuard() {
+#ifdef FEATURE_SELECTION_HAVE_AFFINITY
+    if (previous_.empty()) {
+        return;
+    }
+    // libgomp hands thread numbers of a same-sized team to the same threads,
+    // so each one gets back the mask it had before
+    #pragma omp parallel num_threads(static_cast<int>(previous_.size()))
+    {
+        const auto& cpus = previous_[static_cast<std::size_t>(omp_get_thread_num())];
+        if (!cpus.empty()) {
+            bindCurrentThread(cpus);
+        }
+    }
+#endif
+}
+
+NumaReplicas::NumaReplicas(const DataMatrix& data, const NumaTopology& topology)
+    : data_(data), topology_(topology) {
+    const std::size_t nodes = topology.nodeCount();
+    if (nodes < 2) {
+        return;
+    }
+    replicas_.resize(nodes);
+
+    // One thread per node moves onto that node, copies the matrix (the copy's
+    // allocation is first touched serially inside this region), then returns
+    // to the CPUs it was allowed before
+    #pragma omp parallel for schedule(static, 1) num_threads(static_cast<int>(nodes))
+    for (long long n = 0; n < static_cast<long long>(nodes); ++n) {
+#ifdef FEATURE_SELECTION_HAVE_AFFINITY
+        cpu_set_t previous;
+        bool restore = pthread_getaffinity_np(pthread_self(), sizeof(previous), &previous) == 0;
+        bindCurrentThread(topology.nodes()[static_cast<std::size_t>(n)].cpus);
+#endif
+        replicas_[static_cast<std::size_t>(n)] = data;
+#ifdef FEATURE_SELECTION_HAVE_AFFINITY
+        if (restore) {
+            pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+        }
+#endif
+    }
+}
+
+const DataMatrix& NumaReplicas::local() const {
+    return replica(topology_.currentNode());
+}
+
+const DataMatrix& NumaReplicas::replica(std::size_t node) const {
+    if (replicas_.empty()) {
+        return data_;
+    }
+    return replicas_[std::min(node, replicas_.size() - 1)];
+}
+
+} // namespace feature_selection
@@ -0,0 +1,158 @@
+#include "feature_selection/partial_distance_search.h"
+#include <algorithm>
+#include <limits>
+
+namespace feature_selection {
+
+PartialDistanceSearch::PartialDistanceSearch(const DataMatrix& data)
+    : data_(data),
+      variances_(data.cols(), 0.0) {
+    const std::size_t rows = data.rows();
+    if (rows == 0) {
+        return;
+    }
+    
+    // Two passes per contiguous column: mean, then squared deviations
+    const long long cols = static_cast<long long>(data.cols());
+    #pragma omp parallel for schedule(static)
+    for (long long jj = 0; jj < cols; ++jj) {
+        const double* column = data.columnData(static_cast<std::size_t>(jj));
+        double sum = 0.0;
+        #pragma omp simd reduction(+:sum)
+        for (std::size_t i = 0; i < rows; ++i) {
+            sum += column[i];
+        }
+        const double mean = sum / static_cast<double>(rows);
+        
+        double deviation = 0.0;
+        #pragma omp simd reduction(+:deviation)
+        for (std::size_t i = 0; i < rows; ++i) {
+            double d = column[i] - mean;
+            deviation += d * d;
+        }
+        variances_[static_cast<std::size_t>(jj)] = deviation / static_cast<double>(rows);
+    }
+}
+
+void PartialDistanceSearch::orderByVariance(
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::vector<FeatureIndex>& ordered
+) const {
+    ordered.assign(features, features + featureCount);
+    std::sort(ordered.begin(), ordered.end(), [this](FeatureIndex a, FeatureIndex b) {
+        if (variances_[a] != variances_[b]) {
+            return variances_[a] > variances_[b];
+        }
+        return a < b;
+    });
+}
+
+std::size_t PartialDistanceSearch::findNearest(
+    const double* query,
+    std::size_t excludeIndex,
+    const FeatureIndex* ordered,
+    std::size_t featureCount,
+    PruningStats* stats
+) const {
+    double minDistance = std::numeric_limits<double>::max();
+    std::size_t nearestIndex = 0;
+    PruningStats local;
+    
+    for (std::size_t j = 0; j < data_.rows(); ++j) {
+        if (j == excludeIndex) {
+            continue;
+        }
+        const double* row = data_.rowData(j);
+        
+        double distance = 0.0;
+        std::size_t k = 0;
+        bool abandoned = false;
+        while (k < featureCount) {
+            const std::size_t blockEnd = std::min(featureCount, k + kCheckInterval);
+            for (; k < blockEnd; ++k) {
+                double diff = row[ordered[k]] - query[ordered[k]];
+                distance += diff * diff;
+            }
+            // Terms are non-negative, so the sum can only grow from here
+            if (distance >= minDistance && k < featureCount) {
+                abandoned = true;
+                break;
+            }
+        }
+        
+        local.candidates++;
+        local.termsComputed += k;
+        local.termsPossible += featureCount;
+        if (abandoned) {
+            local.abandoned++;
+        } else if (distance < minDistance) {
+            minDistance = distance;
+            nearestIndex = j;
+        }
+    }
+    
+    if (stats != nullptr) {
+        stats->merge(local);
+    }
+    return nearestIndex;
+}
+
+std::size_t PartialDistanceSearch::leaveOneOutCorrect(
+    const LabelVector& labels,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    PruningStats* stats
+) const {
+    std::vector<FeatureIndex> ordered;
+    orderByVariance(features, featureCount, ordered);
+    
+    const long long totalInstances = static_cast<long long>(data_.rows());
+    std::size_t correctPredictions = 0;
+    PruningStats total;
+    
+    #pragma omp parallel reduction(+:correctPredictions)
+    {
+        PruningStats local;
+        
+        #pragma omp for schedule(dynamic, 16)
+        for (long long ii = 0; ii < totalInstances; ++ii) {
+            std::size_t i = static_cast<std::size_t>(ii);
+            std::size_t nearestIndex = findNearest(data_.rowData(i), i, ordered.data(), ordered.size(), &local);
+            if (labels[i] == labels[nearestIndex]) {
+                correctPredictions++;
+            }
+        }
+        
+        #pragma omp critical
+        total.merge(local);
+    }
+    
+    if (stats != nullptr) {
+        stats->merge(total);
+    }
+    return correctPredictions;
+}
+
+std::size_t PartialDistanceSearch::leaveOneOutCorrect(
+    const LabelVector& labels,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t queryBegin,
+    std::size_t queryEnd,
+    PruningStats* stats
+) const {
+    std::vector<FeatureIndex> ordered;
+    orderByVariance(features, featureCount, ordered);
+    
+    std::size_t correctPredictions = 0;
+    for (std::size_t i = queryBegin; i < queryEnd; ++i) {
+        std::size_t nearestIndex = findNearest(data_.rowData(i), i, ordered.data(), ordered.size(), stats);
+        if (labels[i] == labels[nearestIndex]) {
+            correctPredictions++;
+        }
+    }
+    return correctPredictions;
+}
+
+} // namespace feature_selection
@@ -0,0 +1,241 @@
+#include "feature_selection/search_checkpoint.h"
+#include "feature_selection/binary_dataset.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace feature_selection {
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'S', 'C', 'K', 'P', 'T', '\0', '\0'};
+constexpr std::uint32_t kEndianMarker = 0x01020304u;
+constexpr std::uint64_t kPrime = 0x100000001b3ull;
+
+std::uint64_t headerChecksum(const SearchCheckpoint::Header& header) {
+    SearchCheckpoint::Header copy = header;
+    copy.headerChecksum = 0;
+    return BinaryDataset::checksum(reinterpret_cast<const char*>(&copy), sizeof(copy));
+}
+
+std::uint64_t doubleBits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template <typename Features>
+void putFeatures(std::vector<std::uint64_t>& words, const Features& features) {
+    words.push_back(features.size());
+    words.insert(words.end(), features.begin(), features.end());
+}
+
+// Bounds-checked reader over the state words
+class WordReader {
+public:
+    explicit WordReader(const std::vector<std::uint64_t>& words) : words_(words) {}
+
+    std::uint64_t next() {
+        if (position_ >= words_.size()) {
+            throw std::runtime_error("Checkpoint state is truncated");
+        }
+        return words_[position_++];
+    }
+
+    std::vector<FeatureIndex> features(std::size_t cols) {
+        std::uint64_t count = next();
+        if (count > cols) {
+            throw std::runtime_error("Checkpoint state is corrupted");
+        }
+        std::vector<FeatureIndex> list(static_cast<std::size_t>(count));
+        for (auto& feature : list) {
+            feature = static_cast<FeatureIndex>(next());
+            if (feature >= cols) {
+                throw std::runtime_error("Checkpoint state is corrupted");
+            }
+        }
+        return list;
+    }
+
+    bool finished() const { return position_ == words_.size(); }
+
+private:
+    const std::vector<std::uint64_t>& words_;
+    std::size_t position_ = 0;
+};
+
+FeatureSet toSet(const std::vector<FeatureIndex>& list) {
+    return FeatureSet(list.begin(), list.end());
+}
+
+} // namespace
+
+namespace {
+
+// Shared by both hashDataset overloads; column(j) points at rows values
+template <typename Column>
+std::uint64_t hashColumns(std::size_t rows, std::size_t cols, Column column, const LabelVector& labels) {
+    std::uint64_t hash = (rows * kPrime) ^ cols;
+    for (std::size_t j = 0; j < cols; ++j) {
+        std::uint64_t columnHash = BinaryDataset::checksum(
+            reinterpret_cast<const char*>(column(j)), rows * sizeof(double)
+        );
+        hash = (hash ^ columnHash) * kPrime;
+    }
+    std::uint64_t labelHash = BinaryDataset::checksum(
+        reinterpret_cast<const char*>(labels.data()), labels.size() * sizeof(Label)
+    );
+    return (hash ^ labelHash) * kPrime;
+}
+
+} // namespace
+
+std::uint64_t SearchCheckpoint::hashDataset(const DataMatrix& data, const LabelVector& labels) {
+    return hashColumns(data.rows(), data.cols(), [&](std::size_t j) { return data.columnData(j); }, labels);
+}
+
+std::uint64_t SearchCheckpoint::hashDataset(const BinaryDataset& dataset) {
+    return hashColumns(
+        dataset.rows(), dataset.cols(), [&](std::size_t j) { return dataset.columnData(j); }, dataset.labels()
+    );
+}
+
+void SearchCheckpoint::write(const std::string& path, const DistanceCache* cache) const {
+    std::vector<std::uint64_t> state;
+    putFeatures(state, current);
+    state.push_back(doubleBits(bestAccuracy));
+    putFeatures(state, bestFeatureSet);
+    state.push_back(allResults.size());
+    for (const auto& [features, accuracy] : allResults) {
+        state.push_back(doubleBits(accuracy));
+        putFeatures(state, features);
+    }
+    putFeatures(state, cache != nullptr ? cache->features() : FeatureSet());
+
+    const std::vector<double> none;
+    const std::vector<double>& distances = cache != nullptr ? cache->distances() : none;
+
+    Header header {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.endianMarker = kEndianMarker;
+    header.direction = static_cast<std::uint32_t>(direction);
+    header.hasCache = cache != nullptr ? 1 : 0;
+    header.rows = rows;
+    header.cols = cols;
+    header.datasetHash = datasetHash;
+    header.levelsCompleted = levelsCompleted;
+    header.cacheRemovals = cache != nullptr ? cache->removalsSinceRefresh() : 0;
+    header.stateWords = state.size();
+    header.cacheValues = distances.size();
+    header.stateChecksum = BinaryDataset::checksum(
+        reinterpret_cast<const char*>(state.data()), state.size() * sizeof(std::uint64_t)
+    );
+    header.cacheChecksum = BinaryDataset::checksum(
+        reinterpret_cast<const char*>(distances.data()), distances.size() * sizeof(double)
+    );
+    header.headerChecksum = headerChecksum(header);
+
+    // Write to a temporary name first so a kill mid-write keeps the old checkpoint
+    std::string tempPath = BinaryDataset::temporaryPath(path);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not create checkpoint: " + tempPath);
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(state.data()),
+                   static_cast<std::streamsize>(state.size() * sizeof(std::uint64_t)));
+        file.write(reinterpret_cast<const char*>(distances.data()),
+                   static_cast<std::streamsize>(distances.size() * sizeof(double)));
+        if (!file) {
+            throw std::runtime_error("Could not write checkpoint: " + tempPath);
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        throw std::runtime_error("Could not replace checkpoint: " + path);
+    }
+}
+
+SearchCheckpoint SearchCheckpoint::read(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open checkpoint: " + path);
+    }
+
+    Header header {};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Checkpoint is truncated: " + path);
+    }
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a search checkpoint: " + path);
+    }
+    if (header.endianMarker != kEndianMarker) {
+        throw std::runtime_error("Checkpoint has foreign byte order: " + path);
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("Unsupported checkpoint version " + std::to_string(header.version) + ": " + path);
+    }
+    if (header.headerChecksum != headerChecksum(header)) {
+        throw std::runtime_error("Checkpoint header is corrupted: " + path);
+    }
+
+    std::vector<std::uint64_t> state(static_cast<std::size_t>(header.stateWords));
+    SearchCheckpoint checkpoint;
+    checkpoint.cacheDistances.resize(static_cast<std::size_t>(header.cacheValues));
+    if (!file.read(reinterpret_cast<char*>(state.data()),
+                   static_cast<std::streamsize>(state.size() * sizeof(std::uint64_t))) ||
+        !file.read(reinterpret_cast<char*>(checkpoint.cacheDistances.data()),
+                   static_cast<std::streamsize>(checkpoint.cacheDistances.size() * sizeof(double)))) {
+        throw std::runtime_error("Checkpoint is truncated: " + path);
+    }
+    if (BinaryDataset::checksum(reinterpret_cast<const char*>(state.data()),
+                                state.size() * sizeof(std::uint64_t)) != header.stateChecksum ||
+        BinaryDataset::checksum(reinterpret_cast<const char*>(checkpoint.cacheDistances.data()),
+                                checkpoint.cacheDistances.size() * sizeof(double)) != header.cacheChecksum) {
+        throw std::runtime_error("Checkpoint checksum mismatch: " + path);
+    }
+
+    checkpoint.direction = static_cast<SearchDirection>(header.direction);
+    checkpoint.rows = static_cast<std::size_t>(header.rows);
+    checkpoint.cols = static_cast<std::size_t>(header.cols);
+    checkpoint.datasetHash = header.datasetHash;
+    checkpoint.levelsCompleted = static_cast<std::size_t>(header.levelsCompleted);
+    checkpoint.hasCache = header.hasCache != 0;
+    checkpoint.cacheRemovals = static_cast<std::size_t>(header.cacheRemovals);
+
+    WordReader reader(state);
+    checkpoint.current = reader.features(checkpoint.cols);
+    checkpoint.bestAccuracy = bitsDouble(reader.next());
+    checkpoint.bestFeatureSet = toSet(reader.features(checkpoint.cols));
+    const std::uint64_t resultCount = reader.next();
+    for (std::uint64_t r = 0; r < resultCount; ++r) {
+        double accuracy = bitsDouble(reader.next());
+        checkpoint.allResults.push_back({toSet(reader.features(checkpoint.cols)), accuracy});
+    }
+    checkpoint.cacheFeatures = toSet(reader.features(checkpoint.cols));
+    if (!reader.finished()) {
+        throw std::runtime_error("Checkpoint state is corrupted: " + path);
+    }
+    return checkpoint;
+}
+
+bool SearchCheckpoint::restoreCache(DistanceCache& cache) {
+    if (!hasCache) {
+        return false;
+    }
+    cache.restore(cacheFeatures, std::move(cacheDistances), cacheRemovals);
+    cacheDistances.clear();
+    hasCache = false;
+    return true;
+}
+
+} // namespace feature_selection
@@ -0,0 +1,175 @@
+#include "feature_selection/sorted_sweep.h"
+#include <algorithm>
+
+namespace feature_selection {
+
+namespace {
+
+struct SortedValue {
+    double value;
+    std::size_t row;
+};
+
+// Squared distance exactly as the brute-force paths compute it for one feature
+inline double squaredGap(double a, double b) {
+    double diff = a - b;
+    return diff * diff;
+}
+
+void sortColumn(const double* column, std::size_t rows, std::vector<SortedValue>& sorted) {
+    sorted.resize(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        sorted[i] = {column[i], i};
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const SortedValue& a, const SortedValue& b) {
+        return a.value < b.value || (a.value == b.value && a.row < b.row);
+    });
+}
+
+// Nearest neighbor of every row from the sorted column; groupBegin is scratch
+void sweep(
+    const std::vector<SortedValue>& sorted,
+    std::vector<std::size_t>& groupBegin,
+    std::vector<std::size_t>& nearest
+) {
+    const std::size_t rows = sorted.size();
+    nearest.assign(rows, 0);
+    if (rows < 2) {
+        return;
+    }
+    
+    // First sorted position of each position's group of equal values
+    groupBegin.resize(rows);
+    groupBegin[0] = 0;
+    for (std::size_t p = 1; p < rows; ++p) {
+        groupBegin[p] = sorted[p].value == sorted[p - 1].value ? groupBegin[p - 1] : p;
+    }
+    
+    std::size_t p = 0;
+    while (p < rows) {
+        const std::size_t begin = p;
+        std::size_t end = p + 1;
+        while (end < rows && groupBegin[end] == begin) {
+            ++end;
+        }
+        const double value = sorted[begin].value;
+        
+        // Smallest squared distance to a different group on either side
+        const bool hasLeft = begin > 0;
+        const bool hasRight = end < rows;
+        const double leftGap = hasLeft ? squaredGap(sorted[begin - 1].value, value) : 0.0;
+        const double rightGap = hasRight ? squaredGap(sorted[end].value, value) : 0.0;
+        double minimum = hasLeft ? leftGap : rightGap;
+        if (hasLeft && hasRight) {
+            minimum = std::min(leftGap, rightGap);
+        }
+        
+        // Lowest row among the other groups at exactly that distance; the
+        // distance never shrinks moving outward, so the walks stop early
+        std::size_t outside = rows;
+        const bool outsideExists = hasLeft || hasRight;
+        for (std::size_t q = begin; q > 0;) {
+            std::size_t first = groupBegin[q - 1];
+            if (squaredGap(sorted[first].value, value) != minimum) {
+                break;
+            }
+            outside = std::min(outside, sorted[first].row);
+            q = first;
+        }
+        for (std::size_t q = end; q < rows;) {
+            if (squaredGap(sorted[q].value, value) != minimum) {
+                break;
+            }
+            outside = std::min(outside, sorted[q].row);
+            ++q;
+            while (q < rows && groupBegin[q] != q) {
+                ++q;
+            }
+        }
+        
+        for (std::size_t member = begin; member < end; ++member) {
+            const std::size_t row = sorted[member].row;
+            
+            // Another row with the same value is at distance zero
+            std::size_t best = rows;
+            if (end - begin > 1) {
+                best = sorted[member == begin ? begin + 1 : begin].row;
+                if (minimum == 0.0 && outsideExists) {
+                    best = std::min(best, outside);
+                }
+            } else if (outsideExists) {
+                best = outside;
+            }
+            nearest[row] = best == rows ? 0 : best;
+        }
+        
+        p = end;
+    }
+}
+
+std::size_t countMatches(
+    const std::vector<std::size_t>& nearest,
+    const LabelVector& labels,
+    std::size_t begin,
+    std::size_t end
+) {
+    std::size_t correct = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (labels[i] == labels[nearest[i]]) {
+            ++correct;
+        }
+    }
+    return correct;
+}
+
+} // namespace
+
+void SortedSweep::findAllNearest(const double* column, std::size_t rows, std::vector<std::size_t>& nearest) {
+    std::vector<SortedValue> sorted;
+    std::vector<std::size_t> groupBegin;
+    sortColumn(column, rows, sorted);
+    sweep(sorted, groupBegin, nearest);
+}
+
+std::size_t SortedSweep::countCorrect(const double* column, const LabelVector& labels) {
+    std::vector<std::size_t> nearest;
+    findAllNearest(column, labels.size(), nearest);
+    return countMatches(nearest, labels, 0, nearest.size());
+}
+
+std::size_t SortedSweep::countCorrect(
+    const std::vector<std::size_t>& nearest,
+    const LabelVector& labels,
+    std::size_t begin,
+    std::size_t end
+) {
+    return countMatches(nearest, labels, begin, end);
+}
+
+std::vector<std::size_t> SortedSweep::evaluateFeatures(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    const std::vector<FeatureIndex>& features
+) {
+    std::vector<std::size_t> correct(features.size(), 0);
+    const long long count = static_cast<long long>(features.size());
+    
+    #pragma omp parallel
+    {
+        // Scratch buffers reused by every feature this thread sorts
+        std::vector<SortedValue> sorted;
+        std::vector<std::size_t> groupBegin;
+        std::vector<std::size_t> nearest;
+        
+        #pragma omp for schedule(dynamic)
+        for (long long c = 0; c < count; ++c) {
+            sortColumn(data.columnData(features[c]), data.rows(), sorted);
+            sweep(sorted, groupBegin, nearest);
+            correct[c] = countMatches(nearest, labels, 0, nearest.size());
+        }
+    }
+    
+    return correct;
+}
+
+} // namespace feature_selection
@@ -0,0 +1,370 @@
+#include "feature_selection/spatial_index.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace feature_selection {
+
+namespace {
+
+// Deepest traversal stack a query can need; median splits keep trees far
+// shallower than this
+constexpr std::size_t kMaxStack = 128;
+
+// Relative slack on the ball-tree bound, which goes through a square root
+constexpr double kBallSlack = 1e-9;
+
+struct StackEntry {
+    std::size_t node;
+    double bound;
+};
+
+double squaredDistance(const double* a, const double* b, std::size_t count) {
+    double distance = 0.0;
+    for (std::size_t k = 0; k < count; ++k) {
+        double diff = b[k] - a[k];
+        distance += diff * diff;
+    }
+    return distance;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// SpatialIndex
+// ---------------------------------------------------------------------------
+
+SpatialIndex::SpatialIndex(const DataMatrix& data, const FeatureIndex* features, std::size_t featureCount)
+    : dimensions_(featureCount),
+      points_(data.rows() * featureCount),
+      indices_(data.rows()) {
+    std::iota(indices_.begin(), indices_.end(), std::size_t(0));
+    for (std::size_t k = 0; k < featureCount; ++k) {
+        const double* column = data.columnData(features[k]);
+        for (std::size_t i = 0; i < data.rows(); ++i) {
+            points_[i * featureCount + k] = column[i];
+        }
+    }
+}
+
+NeighborStrategy SpatialIndex::chooseStrategy(std::size_t rows, std::size_t featureCount) {
+    if (featureCount == 0 || featureCount > kMaxDimensions || rows < kMinRows) {
+        return NeighborStrategy::BruteForce;
+    }
+    
+    // Estimated feature terms evaluated for all n queries. A KD-tree query
+    // visits about 2^k leaves; a ball tree fewer as k grows, but each node
+    // visited also costs a centroid distance
+    const double n = static_cast<double>(rows);
+    const double k = static_cast<double>(featureCount);
+    const double leaf = static_cast<double>(kLeafSize);
+    const double depth = std::log2(std::max(2.0, n / leaf));
+    
+    const double bruteCost = n * (n - 1.0) * k;
+    const double kdCost = n * k * (leaf * std::pow(2.0, k) + 2.0 * depth);
+    const double ballCost = n * k * (1.5 * leaf * std::pow(2.0, 0.75 * k) + 4.0 * depth);
+    
+    if (bruteCost <= kdCost && bruteCost <= ballCost) {
+        return NeighborStrategy::BruteForce;
+    }
+    return kdCost <= ballCost ? NeighborStrategy::KDTree : NeighborStrategy::BallTree;
+}
+
+std::unique_ptr<SpatialIndex> SpatialIndex::build(
+    NeighborStrategy strategy,
+    const DataMatrix& data,
+    const FeatureIndex* features,
+    std::size_t featureCount
+) {
+    switch (strategy) {
+        case NeighborStrategy::KDTree: return std::make_unique<KDTree>(data, features, featureCount);
+        case NeighborStrategy::BallTree: return std::make_unique<BallTree>(data, features, featureCount);
+        default: return nullptr;
+    }
+}
+
+const char* SpatialIndex::strategyName(NeighborStrategy strategy) {
+    switch (strategy) {
+        case NeighborStrategy::KDTree: return "KD-tree";
+        case NeighborStrategy::BallTree: return "ball tree";
+        default: return "brute force";
+    }
+}
+
+void SpatialIndex::findAllNearest(std::vector<std::size_t>& nearest) const {
+    nearest.assign(rows(), 0);
+    const long long count = static_cast<long long>(rows());
+    
+    // Queries run in tree order so neighboring queries share visited nodes
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long long pp = 0; pp < count; ++pp) {
+        std::size_t position = static_cast<std::size_t>(pp);
+        nearest[indices_[position]] = this->nearest(point(position), indices_[position]);
+    }
+}
+
+std::size_t SpatialIndex::countCorrect(const LabelVector& labels) const {
+    const long long count = static_cast<long long>(rows());
+    std::size_t correct = 0;
+    
+    #pragma omp parallel for schedule(dynamic, 64) reduction(+:correct)
+    for (long long pp = 0; pp < count; ++pp) {
+        std::size_t position = static_cast<std::size_t>(pp);
+        std::size_t row = indices_[position];
+        if (labels[row] == labels[nearest(point(position), row)]) {
+            correct++;
+        }
+    }
+    
+    return correct;
+}
+
+std::size_t SpatialIndex::countCorrect(const LabelVector& labels, std::size_t begin, std::size_t end) const {
+    std::size_t correct = 0;
+    for (std::size_t row = begin; row < end; ++row) {
+        if (labels[row] == labels[nearest(point(positions_[row]), row)]) {
+            correct++;
+        }
+    }
+    return correct;
+}
+
+void SpatialIndex::scanLeaf(
+    const double* query,
+    std::size_t excludeIndex,
+    std::size_t begin,
+    std::size_t end,
+    double& bestDistance,
+    std::size_t& bestIndex
+) const {
+    for (std::size_t position = begin; position < end; ++position) {
+        std::size_t row = indices_[position];
+        if (row == excludeIndex) {
+            continue;
+        }
+        double distance = squaredDistance(query, point(position), dimensions_);
+        if (distance < bestDistance || (distance == bestDistance && row < bestIndex)) {
+            bestDistance = distance;
+            bestIndex = row;
+        }
+    }
+}
+
+std::size_t SpatialIndex::splitRange(
+    std::size_t begin,
+    std::size_t end,
+    std::size_t& splitDimension,
+    double& splitValue
+) {
+    // Split along the feature with the widest spread in this range
+    splitDimension = 0;
+    double widest = -1.0;
+    for (std::size_t k = 0; k < dimensions_; ++k) {
+        double low = std::numeric_limits<double>::max();
+        double high = std::numeric_limits<double>::lowest();
+        for (std::size_t position = begin; position < end; ++position) {
+            low = std::min(low, coordinate(position, k));
+            high = std::max(high, coordinate(position, k));
+        }
+        if (high - low > widest) {
+            widest = high - low;
+            splitDimension = k;
+        }
+    }
+    
+    const std::size_t middle = begin + (end - begin) / 2;
+    const std::size_t k = splitDimension;
+    const std::size_t stride = dimensions_;
+    const double* values = points_.data();
+    std::nth_element(
+        indices_.begin() + static_cast<std::ptrdiff_t>(begin),
+        indices_.begin() + static_cast<std::ptrdiff_t>(middle),
+        indices_.begin() + static_cast<std::ptrdiff_t>(end),
+        [values, stride, k](std::size_t a, std::size_t b) {
+            return values[a * stride + k] < values[b * stride + k];
+        }
+    );
+    splitValue = coordinate(middle, splitDimension);
+    return middle;
+}
+
+void SpatialIndex::packInTreeOrder() {
+    std::vector<double> packed(points_.size());
+    positions_.resize(indices_.size());
+    for (std::size_t position = 0; position < indices_.size(); ++position) {
+        positions_[indices_[position]] = position;
+        std::copy_n(
+            points_.data() + indices_[position] * dimensions_,
+            dimensions_,
+            packed.data() + position * dimensions_
+        );
+    }
+    points_.swap(packed);
+}
+
+// ---------------------------------------------------------------------------
+// KDTree
+// ---------------------------------------------------------------------------
+
+KDTree::KDTree(const DataMatrix& data, const FeatureIndex* features, std::size_t featureCount)
+    : SpatialIndex(data, features, featureCount) {
+    if (rows() > 0) {
+        nodes_.reserve(2 * rows() / kLeafSize + 1);
+        buildNode(0, rows());
+    }
+    packInTreeOrder();
+}
+
+std::size_t KDTree::buildNode(std::size_t begin, std::size_t end) {
+    const std::size_t id = nodes_.size();
+    nodes_.push_back({begin, end, 0, 0.0, 0, 0, true});
+    if (end - begin <= kLeafSize) {
+        return id;
+    }
+    
+    std::size_t splitDimension = 0;
+    double splitValue = 0.0;
+    std::size_t middle = splitRange(begin, end, splitDimension, splitValue);
+    std::size_t left = buildNode(begin, middle);
+    std::size_t right = buildNode(middle, end);
+    nodes_[id] = {begin, end, splitDimension, splitValue, left, right, false};
+    return id;
+}
+
+std::size_t KDTree::nearest(const double* query, std::size_t excludeIndex) const {
+    double bestDistance = std::numeric_limits<double>::max();
+    std::size_t bestIndex = 0;
+    if (nodes_.empty()) {
+        return bestIndex;
+    }
+    
+    StackEntry stack[kMaxStack];
+    std::size_t top = 0;
+    stack[top++] = {0, 0.0};
+    
+    while (top > 0) {
+        StackEntry entry = stack[--top];
+        // Equal bounds are still visited: a tie may have a lower index
+        if (entry.bound > bestDistance) {
+            continue;
+        }
+        
+        const Node& node = nodes_[entry.node];
+        if (node.leaf) {
+            scanLeaf(query, excludeIndex, node.begin, node.end, bestDistance, bestIndex);
+            continue;
+        }
+        
+        // Left holds values <= the split and right values >= it, so the
+        // plane distance bounds every point on the far side
+        double diff = query[node.splitDimension] - node.splitValue;
+        std::size_t nearChild = diff < 0.0 ? node.left : node.right;
+        std::size_t farChild = diff < 0.0 ? node.right : node.left;
+        stack[top++] = {farChild, std::max(entry.bound, diff * diff)};
+        stack[top++] = {nearChild, entry.bound};
+    }
+    
+    return bestIndex;
+}
+
+// ---------------------------------------------------------------------------
+// BallTree
+// ---------------------------------------------------------------------------
+
+BallTree::BallTree(const DataMatrix& data, const FeatureIndex* features, std::size_t featureCount)
+    : SpatialIndex(data, features, featureCount) {
+    if (rows() > 0) {
+        nodes_.reserve(2 * rows() / kLeafSize + 1);
+        centroids_.reserve((2 * rows() / kLeafSize + 1) * dimensions());
+        buildNode(0, rows());
+    }
+    packInTreeOrder();
+}
+
+std::size_t BallTree::buildNode(std::size_t begin, std::size_t end) {
+    const std::size_t id = nodes_.size();
+    const std::size_t k = dimensions();
+    const double count = static_cast<double>(end - begin);
+    
+    std::vector<double> centroid(k, 0.0);
+    for (std::size_t position = begin; position < end; ++position) {
+        for (std::size_t d = 0; d < k; ++d) {
+            centroid[d] += coordinate(position, d);
+        }
+    }
+    for (double& value : centroid) {
+        value /= count;
+    }
+    
+    double radius = 0.0;
+    for (std::size_t position = begin; position < end; ++position) {
+        double distance = 0.0;
+        for (std::size_t d = 0; d < k; ++d) {
+            double diff = coordinate(position, d) - centroid[d];
+            distance += diff * diff;
+        }
+        radius = std::max(radius, distance);
+    }
+    
+    nodes_.push_back({begin, end, std::sqrt(radius), 0, 0, true});
+    centroids_.insert(centroids_.end(), centroid.begin(), centroid.end());
+    if (end - begin <= kLeafSize) {
+        return id;
+    }
+    
+    std::size_t splitDimension = 0;
+    double splitValue = 0.0;
+    std::size_t middle = splitRange(begin, end, splitDimension, splitValue);
+    std::size_t left = buildNode(begin, middle);
+    std::size_t right = buildNode(middle, end);
+    nodes_[id].left = left;
+    nodes_[id].right = right;
+    nodes_[id].leaf = false;
+    return id;
+}
+
+double BallTree::centroidDistance(const double* query, std::size_t node) const {
+    return std::sqrt(squaredDistance(query, centroids_.data() + node * dimensions(), dimensions()));
+}
+
+std::size_t BallTree::nearest(const double* query, std::size_t excludeIndex) const {
+    double bestDistance = std::numeric_limits<double>::max();
+    std::size_t bestIndex = 0;
+    if (nodes_.empty()) {
+        return bestIndex;
+    }
+    
+    StackEntry stack[kMaxStack];
+    std::size_t top = 0;
+    stack[top++] = {0, 0.0};
+    
+    while (top > 0) {
+        StackEntry entry = stack[--top];
+        if (entry.bound > bestDistance * (1.0 + kBallSlack)) {
+            continue;
+        }
+        
+        const Node& node = nodes_[entry.node];
+        if (node.leaf) {
+            scanLeaf(query, excludeIndex, node.begin, node.end, bestDistance, bestIndex);
+            continue;
+        }
+        
+        // Squared distance from the query to each child's ball; the closer
+        // child is pushed last so it is searched first
+        double bounds[2];
+        const std::size_t children[2] = {node.left, node.right};
+        for (int c = 0; c < 2; ++c) {
+            double gap = centroidDistance(query, children[c]) - nodes_[children[c]].radius;
+            bounds[c] = gap > 0.0 ? gap * gap : 0.0;
+        }
+        int nearChild = bounds[0] <= bounds[1] ? 0 : 1;
+        stack[top++] = {children[1 - nearChild], bounds[1 - nearChild]};
+        stack[top++] = {children[nearChild], bounds[nearChild]};
+    }
+    
+    return bestIndex;
+}
+
+} // namespace feature_selection
@@ -0,0 +1,129 @@
+#include "feature_selection/streaming_evaluator.h"
+#include "feature_selection/tiled_nearest_neighbor.h"
+#include <algorithm>
+#include <limits>
+
+namespace feature_selection {
+
+namespace {
+
+// Smallest block worth streaming; below this the per-block overhead dominates
+constexpr std::size_t kMinBlockRows = 64;
+
+std::size_t paddedWidth(std::size_t featureCount) {
+    return (featureCount + FeatureMatrix::kPadding - 1) / FeatureMatrix::kPadding * FeatureMatrix::kPadding;
+}
+
+} // namespace
+
+StreamingEvaluator::StreamingEvaluator(const BinaryDataset& dataset, std::size_t memoryBudget)
+    : dataset_(dataset),
+      labels_(dataset.labels()),
+      memoryBudget_(memoryBudget) {}
+
+std::size_t StreamingEvaluator::blockRows(std::size_t featureCount) const {
+    // The budget is split evenly between the query and the reference block
+    std::size_t rowBytes = std::max<std::size_t>(1, paddedWidth(featureCount)) * sizeof(double);
+    std::size_t rows = memoryBudget_ / 2 / rowBytes;
+    return std::max(kMinBlockRows, std::min(rows, dataset_.rows()));
+}
+
+std::size_t StreamingEvaluator::leaveOneOutCorrect(
+    const FeatureIndex* features,
+    std::size_t featureCount
+) const {
+    const std::size_t n = dataset_.rows();
+    if (n == 0) {
+        return 0;
+    }
+    
+    const std::size_t block = blockRows(featureCount);
+    const auto source = TiledNearestNeighbor::columns(dataset_);
+    
+    std::vector<double> bestDistance(n, std::numeric_limits<double>::max());
+    std::vector<std::size_t> bestIndex(n, 0);
+    
+    // Columns are read in place from the mapping; only one query block and
+    // one reference block of them are touched per step, so the working set
+    // stays within the budget however large the file is
+    for (std::size_t q0 = 0; q0 < n; q0 += block) {
+        const std::size_t q1 = std::min(n, q0 + block);
+        for (std::size_t r0 = 0; r0 < n; r0 += block) {
+            const std::size_t r1 = std::min(n, r0 + block);
+            TiledNearestNeighbor::updateNearest(
+                source, features, featureCount, q0, q1, r0, r1,
+                bestDistance.data(), bestIndex.data()
+            );
+        }
+    }
+    
+    std::size_t correct = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (labels_[i] == labels_[bestIndex[i]]) {
+            ++correct;
+        }
+    }
+    return correct;
+}
+
+std::size_t StreamingEvaluator::leaveOneOutCorrect(
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t queryBegin,
+    std::size_t queryEnd
+) const {
+    const std::size_t n = dataset_.rows();
+    queryEnd = std::min(queryEnd, n);
+    if (queryBegin >= queryEnd) {
+        return 0;
+    }
+    
+    const std::size_t block = blockRows(featureCount);
+    const auto source = TiledNearestNeighbor::columns(dataset_);
+    std::vector<double> bestDistance(std::min(block, queryEnd - queryBegin));
+    std::vector<std::size_t> bestIndex(bestDistance.size());
+    
+    std::size_t correct = 0;
+    for (std::size_t q0 = queryBegin; q0 < queryEnd; q0 += block) {
+        const std::size_t q1 = std::min(queryEnd, q0 + block);
+        std::fill(bestDistance.begin(), bestDistance.end(), std::numeric_limits<double>::max());
+        std::fill(bestIndex.begin(), bestIndex.end(), std::size_t(0));
+        for (std::size_t r0 = 0; r0 < n; r0 += block) {
+            TiledNearestNeighbor::updateNearestBlock(
+                source, features, featureCount, q0, q1, r0, std::min(n, r0 + block),
+                bestDistance.data(), bestIndex.data()
+            );
+        }
+        for (std::size_t q = q0; q < q1; ++q) {
+            if (labels_[q] == labels_[bestIndex[q - q0]]) {
+                ++correct;
+            }
+        }
+    }
+    return correct;
+}
+
+double StreamingEvaluator::leaveOneOutCrossValidation(const FeatureSet& featureSubset) const {
+    const std::size_t n = dataset_.rows();
+    if (n == 0) {
+        return 0.0;
+    }
+    
+    std::vector<FeatureIndex> features;
+    if (featureSubset.empty()) {
+        for (FeatureIndex f = 0; f < dataset_.cols(); ++f) {
+            features.push_back(f);
+        }
+    } else {
+        for (FeatureIndex f : featureSubset) {
+            if (f < dataset_.cols()) {
+                features.push_back(f);
+            }
+        }
+    }
+    
+    std::size_t correct = leaveOneOutCorrect(features.data(), features.size());
+    return static_cast<double>(correct) / static_cast<double>(n);
+}
+
+} // namespace feature_selection
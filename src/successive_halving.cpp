@@ -0,0 +1,27 @@
+#include "feature_selection/successive_halving.h"
+#include <algorithm>
+#include <cmath>
+
+namespace feature_selection {
+
+SuccessiveHalving::SuccessiveHalving(
+    const DataMatrix& data,
+    const LabelVector& labels,
+    std::size_t initialRows,
+    double keepFraction,
+    std::size_t finalists,
+    std::uint64_t seed
+)
+    : keepFraction_(std::min(1.0, std::max(0.0, keepFraction))),
+      finalists_(std::max<std::size_t>(1, finalists)) {
+    for (std::size_t rows = std::max<std::size_t>(1, initialRows); rows < data.rows(); rows *= 2) {
+        rounds_.push_back(std::make_unique<CandidateScreen>(data, labels, rows, seed + rounds_.size()));
+    }
+}
+
+std::size_t SuccessiveHalving::survivors(std::size_t candidates) const {
+    const auto kept = static_cast<std::size_t>(std::ceil(static_cast<double>(candidates) * keepFraction_));
+    return std::min(candidates, std::max(finalists_, kept));
+}
+
+} // namespace feature_selection
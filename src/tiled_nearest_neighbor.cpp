@@ -0,0 +1,222 @@
+#include "feature_selection/tiled_nearest_neighbor.h"
+#include "feature_selection/binary_dataset.h"
+#include <algorithm>
+#include <limits>
+
+// The tile loops are written to auto-vectorize; on x86 GCC they are compiled
+// for several instruction sets and the best one is picked at load time
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define FEATURE_SELECTION_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define FEATURE_SELECTION_TARGET_CLONES
+#endif
+
+namespace feature_selection {
+
+namespace {
+
+constexpr std::size_t kMaxReferenceTile = 2048;
+constexpr std::size_t kMinReferenceTile = 64;
+
+// Reference tile footprint (features x rows) targeted to stay in L2
+constexpr std::size_t kReferenceTileBytes = 256 * 1024;
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+FEATURE_SELECTION_TARGET_CLONES
+void accumulateFeature(const double* column, std::size_t count, double query, double* distances) {
+    #pragma omp simd
+    for (std::size_t j = 0; j < count; ++j) {
+        double diff = column[j] - query;
+        distances[j] += diff * diff;
+    }
+}
+
+FEATURE_SELECTION_TARGET_CLONES
+double tileMinimum(const double* distances, std::size_t count) {
+    double best = kInfinity;
+    #pragma omp simd reduction(min:best)
+    for (std::size_t j = 0; j < count; ++j) {
+        best = std::min(best, distances[j]);
+    }
+    return best;
+}
+
+inline const double* featureColumn(
+    TiledNearestNeighbor::ColumnSource source,
+    const FeatureIndex* features,
+    std::size_t k
+) {
+    return source.base + (features != nullptr ? features[k] : k) * source.stride;
+}
+
+// One tile of queries against a range of references, serially; tileBest and
+// tileIndex hold the running minima of queries [queryBegin, queryEnd)
+void processQueryTile(
+    TiledNearestNeighbor::ColumnSource source,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t queryBegin,
+    std::size_t queryEnd,
+    std::size_t referenceBegin,
+    std::size_t referenceEnd,
+    double* tileBest,
+    std::size_t* tileIndex
+) {
+    const std::size_t tileRows = TiledNearestNeighbor::referenceTileRows(featureCount);
+    alignas(64) double distances[kMaxReferenceTile];
+    
+    for (std::size_t r0 = referenceBegin; r0 < referenceEnd; r0 += tileRows) {
+        const std::size_t count = std::min(referenceEnd, r0 + tileRows) - r0;
+        
+        for (std::size_t q = queryBegin; q < queryEnd; ++q) {
+            std::fill(distances, distances + count, 0.0);
+            for (std::size_t k = 0; k < featureCount; ++k) {
+                const double* column = featureColumn(source, features, k);
+                accumulateFeature(column + r0, count, column[q], distances);
+            }
+            
+            // A query is never its own neighbor
+            if (q >= r0 && q < r0 + count) {
+                distances[q - r0] = kInfinity;
+            }
+            
+            double minimum = tileMinimum(distances, count);
+            if (minimum < tileBest[q - queryBegin]) {
+                std::size_t j = 0;
+                while (distances[j] != minimum) {
+                    ++j;
+                }
+                tileBest[q - queryBegin] = minimum;
+                tileIndex[q - queryBegin] = r0 + j;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TiledNearestNeighbor::ColumnSource TiledNearestNeighbor::columns(const DataMatrix& data) {
+    return {data.cols() > 0 ? data.columnData(0) : nullptr, data.columnStride()};
+}
+
+TiledNearestNeighbor::ColumnSource TiledNearestNeighbor::columns(const BinaryDataset& dataset) {
+    return {dataset.cols() > 0 ? dataset.columnData(0) : nullptr, dataset.columnStride()};
+}
+
+std::size_t TiledNearestNeighbor::referenceTileRows(std::size_t featureCount) {
+    std::size_t rows = kReferenceTileBytes / (std::max<std::size_t>(1, featureCount) * sizeof(double));
+    rows = std::max(kMinReferenceTile, std::min(kMaxReferenceTile, rows));
+    return rows / FeatureMatrix::kPadding * FeatureMatrix::kPadding;
+}
+
+void TiledNearestNeighbor::updateNearest(
+    ColumnSource source,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t queryBegin,
+    std::size_t queryEnd,
+    std::size_t referenceBegin,
+    std::size_t referenceEnd,
+    double* bestDistance,
+    std::size_t* bestIndex
+) {
+    if (queryBegin >= queryEnd) {
+        return;
+    }
+    const long long tiles = static_cast<long long>((queryEnd - queryBegin + kQueryTile - 1) / kQueryTile);
+    
+    #pragma omp parallel for schedule(dynamic)
+    for (long long t = 0; t < tiles; ++t) {
+        std::size_t q0 = queryBegin + static_cast<std::size_t>(t) * kQueryTile;
+        std::size_t q1 = std::min(queryEnd, q0 + kQueryTile);
+        processQueryTile(
+            source, features, featureCount, q0, q1, referenceBegin, referenceEnd,
+            bestDistance + q0, bestIndex + q0
+        );
+    }
+}
+
+void TiledNearestNeighbor::updateNearestBlock(
+    ColumnSource source,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t queryBegin,
+    std::size_t queryEnd,
+    std::size_t referenceBegin,
+    std::size_t referenceEnd,
+    double* bestDistance,
+    std::size_t* bestIndex
+) {
+    for (std::size_t q0 = queryBegin; q0 < queryEnd; q0 += kQueryTile) {
+        std::size_t q1 = std::min(queryEnd, q0 + kQueryTile);
+        processQueryTile(
+            source, features, featureCount, q0, q1, referenceBegin, referenceEnd,
+            bestDistance + (q0 - queryBegin), bestIndex + (q0 - queryBegin)
+        );
+    }
+}
+
+void TiledNearestNeighbor::findAllNearest(
+    ColumnSource source,
+    std::size_t rows,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::vector<std::size_t>& nearest
+) {
+    std::vector<double> bestDistance(rows, std::numeric_limits<double>::max());
+    nearest.assign(rows, 0);
+    updateNearest(source, features, featureCount, 0, rows, 0, rows, bestDistance.data(), nearest.data());
+}
+
+std::size_t TiledNearestNeighbor::countCorrect(
+    ColumnSource source,
+    const LabelVector& labels,
+    const FeatureIndex* features,
+    std::size_t featureCount
+) {
+    const std::size_t rows = labels.size();
+    const long long tiles = static_cast<long long>((rows + kQueryTile - 1) / kQueryTile);
+    std::size_t correct = 0;
+    
+    #pragma omp parallel for schedule(dynamic) reduction(+:correct)
+    for (long long t = 0; t < tiles; ++t) {
+        std::size_t q0 = static_cast<std::size_t>(t) * kQueryTile;
+        correct += countCorrect(source, labels, features, featureCount, q0, std::min(rows, q0 + kQueryTile));
+    }
+    
+    return correct;
+}
+
+std::size_t TiledNearestNeighbor::countCorrect(
+    ColumnSource source,
+    const LabelVector& labels,
+    const FeatureIndex* features,
+    std::size_t featureCount,
+    std::size_t queryBegin,
+    std::size_t queryEnd
+) {
+    const std::size_t rows = labels.size();
+    std::size_t correct = 0;
+    
+    for (std::size_t q0 = queryBegin; q0 < queryEnd; q0 += kQueryTile) {
+        std::size_t q1 = std::min(queryEnd, q0 + kQueryTile);
+        
+        double tileBest[kQueryTile];
+        std::size_t tileIndex[kQueryTile];
+        std::fill(tileBest, tileBest + kQueryTile, std::numeric_limits<double>::max());
+        std::fill(tileIndex, tileIndex + kQueryTile, std::size_t(0));
+        
+        processQueryTile(source, features, featureCount, q0, q1, 0, rows, tileBest, tileIndex);
+        
+        for (std::size_t q = q0; q < q1; ++q) {
+            if (labels[q] == labels[tileIndex[q - q0]]) {
+                correct++;
+            }
+        }
+    }
+    
+    return correct;
+}
+
+} // namespace feature_selection
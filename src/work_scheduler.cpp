@@ -0,0 +1,19 @@
+#include "feature_selection/work_scheduler.h"
+#include <algorithm>
+
+namespace feature_selection {
+
+std::size_t WorkScheduler::blockRows(std::size_t tasks, std::size_t rows, std::size_t threads) {
+    const std::size_t target = std::max<std::size_t>(1, threads) * kUnitsPerThread;
+    if (tasks == 0 || rows == 0 || tasks >= target) {
+        return std::max<std::size_t>(1, rows);
+    }
+
+    // Split each task into enough blocks to reach the target, rounded up to
+    // whole kMinBlockRows so a unit is never smaller than one query tile
+    const std::size_t blocksPerTask = (target + tasks - 1) / tasks;
+    const std::size_t block = (rows + blocksPerTask - 1) / blocksPerTask;
+    return (block + kMinBlockRows - 1) / kMinBlockRows * kMinBlockRows;
+}
+
+} // namespace feature_selection
@@ -0,0 +1,25 @@
+#include "feature_selection/distributed_evaluator.h"
+#include <iostream>
+#include <string>
+
+using namespace feature_selection;
+
+// Worker process for distributed feature selection: maps the binary dataset,
+// connects to the coordinator's socket and serves requests until shutdown
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <coordinator socket> <binary dataset>" << std::endl;
+        return 2;
+    }
+    
+    try {
+        DistributedWorker worker(argv[2]);
+        worker.serve(DistributedWorker::connect(argv[1]));
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Worker error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
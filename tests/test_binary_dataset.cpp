@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include "feature_selection/binary_dataset.h"
+#include "feature_selection/data_loader.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace feature_selection;
+
+// Test fixture with a small text dataset on disk
+class BinaryDatasetTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        textPath = ::testing::TempDir() + "fs_binary_source.txt";
+        binaryPath = ::testing::TempDir() + "fs_binary_source.fsbin";
+        writeText("2 1.5 -2.0 3.25\n1 0.5 4.0 -1.0\n2 7.0 8.0 9.0\n3 1e-3 2e3 0\n");
+    }
+    
+    void TearDown() override {
+        std::remove(textPath.c_str());
+        std::remove(binaryPath.c_str());
+        std::remove(DataLoader::defaultCachePath(textPath).c_str());
+        std::remove(DataLoader::defaultCachePath(textPath, NormalizationMethod::MinMax).c_str());
+    }
+    
+    void writeText(const std::string& contents) {
+        std::ofstream file(textPath, std::ios::binary | std::ios::trunc);
+        file << contents;
+    }
+    
+    static void expectSame(const DataMatrix& expected, const DataMatrix& actual) {
+        ASSERT_EQ(expected.rows(), actual.rows());
+        ASSERT_EQ(expected.cols(), actual.cols());
+        for (std::size_t i = 0; i < expected.rows(); ++i) {
+            for (std::size_t j = 0; j < expected.cols(); ++j) {
+                EXPECT_EQ(expected[i][j], actual[i][j]);
+                EXPECT_EQ(expected.columnData(j)[i], actual.columnData(j)[i]);
+            }
+        }
+    }
+    
+    std::string textPath;
+    std::string binaryPath;
+};
+
+// Writing and re-reading preserves values, labels and source information
+TEST_F(BinaryDatasetTest, RoundTrip) {
+    auto [data, labels] = DataLoader::loadDataset(textPath);
+    BinaryDataset::write(binaryPath, data, labels, 123, 456);
+    
+    EXPECT_TRUE(BinaryDataset::isBinaryDataset(binaryPath));
+    EXPECT_FALSE(BinaryDataset::isBinaryDataset(textPath));
+    
+    BinaryDataset binary(binaryPath);
+    EXPECT_EQ(4u, binary.rows());
+    EXPECT_EQ(3u, binary.cols());
+    EXPECT_EQ(123u, binary.sourceSize());
+    EXPECT_EQ(456, binary.sourceModified());
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(binary.columnData(1)) % BinaryDataset::kSectionAlignment);
+    EXPECT_EQ(labels, binary.labels());
+    expectSame(data, binary.toMatrix());
+    
+    // loadDataset recognises binary files directly
+    auto [reloaded, reloadedLabels] = DataLoader::loadDataset(binaryPath);
+    EXPECT_EQ(labels, reloadedLabels);
+    expectSame(data, reloaded);
+}
+
+// Flipped payload bytes are caught by the checksum
+TEST_F(BinaryDatasetTest, DetectsCorruption) {
+    auto [data, labels] = DataLoader::loadDataset(textPath);
+    BinaryDataset::write(binaryPath, data, labels);
+    
+    {
+        std::fstream file(binaryPath, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-8, std::ios::end);
+        file.put('\x7f');
+    }
+    
+    EXPECT_THROW(BinaryDataset(binaryPath, true), std::runtime_error);
+    EXPECT_NO_THROW(BinaryDataset(binaryPath, false));
+    
+    std::filesystem::resize_file(binaryPath, std::filesystem::file_size(binaryPath) - 64);
+    EXPECT_THROW(BinaryDataset(binaryPath, false), std::runtime_error);
+}
+
+// The cache is written on first load, reused after, and rebuilt when stale
+TEST_F(BinaryDatasetTest, CacheLifecycle) {
+    LoadOptions options;
+    options.useBinaryCache = true;
+    std::string cachePath = DataLoader::defaultCachePath(textPath);
+    
+    auto [first, firstLabels] = DataLoader::loadDataset(textPath, options);
+    ASSERT_TRUE(std::filesystem::exists(cachePath));
+    auto cacheTime = std::filesystem::last_write_time(cachePath);
+    
+    auto [second, secondLabels] = DataLoader::loadDataset(textPath, options);
+    EXPECT_EQ(cacheTime, std::filesystem::last_write_time(cachePath));
+    EXPECT_EQ(firstLabels, secondLabels);
+    expectSame(first, second);
+    
+    // Editing the text file invalidates the cache
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    writeText("1 1 2\n2 3 4\n");
+    auto [third, thirdLabels] = DataLoader::loadDataset(textPath, options);
+    EXPECT_EQ(2u, third.rows());
+    EXPECT_EQ(2u, third.cols());
+    EXPECT_EQ(LabelVector({1, 2}), thirdLabels);
+}
+
+// A cache written by an older format version is a miss, not an error
+TEST_F(BinaryDatasetTest, OldVersionCacheIsRebuilt) {
+    LoadOptions options;
+    options.useBinaryCache = true;
+    std::string cachePath = DataLoader::defaultCachePath(textPath);
+    auto [first, firstLabels] = DataLoader::loadDataset(textPath, options);
+    EXPECT_EQ(BinaryDataset::kVersion, BinaryDataset::fileVersion(cachePath));
+    EXPECT_EQ(0u, BinaryDataset::fileVersion(textPath));
+    
+    {
+        std::fstream cache(cachePath, std::ios::in | std::ios::out | std::ios::binary);
+        const std::uint32_t oldVersion = 1;
+        cache.seekp(offsetof(BinaryDataset::Header, version));
+        cache.write(reinterpret_cast<const char*>(&oldVersion), sizeof(oldVersion));
+    }
+    EXPECT_EQ(1u, BinaryDataset::fileVersion(cachePath));
+    EXPECT_THROW(BinaryDataset{cachePath}, std::runtime_error);
+    
+    auto [second, secondLabels] = DataLoader::loadDataset(textPath, options);
+    EXPECT_EQ(firstLabels, secondLabels);
+    expectSame(first, second);
+    EXPECT_EQ(BinaryDataset::kVersion, BinaryDataset::fileVersion(cachePath));
+}
+
+// A normalized cache stores its parameters and is rebuilt for another method
+TEST_F(BinaryDatasetTest, NormalizedCache) {
+    LoadOptions options;
+    options.useBinaryCache = true;
+    options.normalization = NormalizationMethod::MinMax;
+    std::string cachePath = DataLoader::defaultCachePath(textPath, NormalizationMethod::MinMax);
+    std::string plainPath = DataLoader::defaultCachePath(textPath);
+    EXPECT_EQ(textPath + ".minmax.fsbin", cachePath);
+    EXPECT_EQ(textPath + ".fsbin", plainPath);
+    
+    auto [raw, rawLabels] = DataLoader::loadDataset(textPath);
+    DataMatrix expected = raw;
+    NormalizationParams params = Normalizer::normalize(expected, NormalizationMethod::MinMax);
+    
+    auto [first, firstLabels] = DataLoader::loadDataset(textPath, options);
+    expectSame(expected, first);
+    {
+        BinaryDataset binary(cachePath);
+        EXPECT_EQ(NormalizationMethod::MinMax, binary.normalizationMethod());
+        NormalizationParams stored = binary.normalization();
+        EXPECT_EQ(params.centers, stored.centers);
+        EXPECT_EQ(params.scales, stored.scales);
+        expectSame(expected, binary.toMatrix());
+    }
+    
+    auto cacheTime = std::filesystem::last_write_time(cachePath);
+    auto [second, secondLabels] = DataLoader::loadDataset(textPath, options);
+    EXPECT_EQ(cacheTime, std::filesystem::last_write_time(cachePath));
+    expectSame(expected, second);
+    
+    // Another method has a cache of its own and leaves this one alone
+    options.normalization = NormalizationMethod::None;
+    auto [plain, plainLabels] = DataLoader::loadDataset(textPath, options);
+    expectSame(raw, plain);
+    EXPECT_EQ(NormalizationMethod::None, BinaryDataset(plainPath).normalizationMethod());
+    EXPECT_TRUE(BinaryDataset(plainPath).normalization().centers.empty());
+    EXPECT_EQ(cacheTime, std::filesystem::last_write_time(cachePath));
+    EXPECT_EQ(NormalizationMethod::MinMax, BinaryDataset(cachePath).normalizationMethod());
+    
+    // Raw binary files are normalized on load; normalized ones keep their method
+    options.normalization = NormalizationMethod::MinMax;
+    auto [fromRaw, fromRawLabels] = DataLoader::loadDataset(plainPath, options);
+    expectSame(expected, fromRaw);
+    BinaryDataset::write(binaryPath, expected, rawLabels, 0, 0, params);
+    auto [fromNormalized, fromNormalizedLabels] = DataLoader::loadDataset(binaryPath, options);
+    expectSame(expected, fromNormalized);
+    options.normalization = NormalizationMethod::ZScore;
+    EXPECT_THROW(DataLoader::loadDataset(binaryPath, options), std::runtime_error);
+}
+
+// Every write goes through its own temporary, which is gone afterwards
+TEST_F(BinaryDatasetTest, UniqueTemporaryFiles) {
+    const std::string first = BinaryDataset::temporaryPath(binaryPath);
+    const std::string second = BinaryDataset::temporaryPath(binaryPath);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(0u, first.rfind(binaryPath + ".tmp.", 0));
+    
+    auto [data, labels] = DataLoader::loadDataset(textPath);
+    BinaryDataset::write(binaryPath, data, labels);
+    
+    const std::filesystem::path directory = std::filesystem::path(binaryPath).parent_path();
+    const std::string prefix = std::filesystem::path(binaryPath).filename().string() + ".tmp";
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        EXPECT_NE(0u, entry.path().filename().string().rfind(prefix, 0)) << entry.path();
+    }
+}
+
+// Converting a text file chunk by chunk gives the file write() would
+TEST_F(BinaryDatasetTest, ChunkedConversion) {
+    std::string text;
+    for (int i = 0; i < 150; ++i) {
+        text += std::to_string(i % 3 + 1) + " " + std::to_string(i * 0.25) + " " + std::to_string(-i) + "\n";
+        if (i % 40 == 0) {
+            text += "\n";
+        }
+    }
+    writeText(text);
+    
+    // A few lines per chunk, so many column segments are appended
+    DataLoader::convertToBinary(textPath, binaryPath, 64);
+    auto [data, labels] = DataLoader::loadDataset(textPath);
+    BinaryDataset converted(binaryPath);
+    EXPECT_EQ(std::filesystem::file_size(textPath), converted.sourceSize());
+    EXPECT_EQ(labels, converted.labels());
+    expectSame(data, converted.toMatrix());
+    
+    std::string writtenPath = binaryPath + ".written";
+    BinaryDataset::write(writtenPath, data, labels, converted.sourceSize(), converted.sourceModified());
+    EXPECT_EQ(BinaryDataset(writtenPath).payloadChecksum(), converted.payloadChecksum());
+    std::remove(writtenPath.c_str());
+    
+    // The converted file serves as an up-to-date cache
+    LoadOptions options;
+    options.useBinaryCache = true;
+    options.cachePath = binaryPath;
+    auto modified = std::filesystem::last_write_time(binaryPath);
+    EXPECT_EQ(binaryPath, DataLoader::binaryDatasetFor(textPath, options).path());
+    EXPECT_EQ(modified, std::filesystem::last_write_time(binaryPath));
+    
+    // Without the cache a private copy is converted and removed afterwards
+    options.useBinaryCache = false;
+    std::string privatePath;
+    {
+        BinaryDatasetFile converted = DataLoader::binaryDatasetFor(textPath, options);
+        privatePath = converted.path();
+        EXPECT_TRUE(converted.temporary());
+        EXPECT_NE(binaryPath, privatePath);
+        EXPECT_EQ(BinaryDataset(binaryPath).payloadChecksum(), BinaryDataset(privatePath).payloadChecksum());
+    }
+    EXPECT_FALSE(std::filesystem::exists(privatePath));
+    EXPECT_EQ(modified, std::filesystem::last_write_time(binaryPath));
+    
+    writeText("1 1 2\n2 3 4 5\n");
+    EXPECT_THROW(DataLoader::convertToBinary(textPath, binaryPath, 4), std::runtime_error);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "feature_selection/candidate_screen.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+// Samples keep class shares, are ascending, distinct and reproducible
+TEST(CandidateScreenTest, StratifiedRows) {
+    LabelVector labels;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        labels.push_back(i % 10 == 0 ? 2 : (i % 100 == 7 ? 3 : 1));
+    }
+    
+    auto rows = CandidateScreen::stratifiedRows(labels, 200, 5);
+    ASSERT_EQ(200u, rows.size());
+    EXPECT_TRUE(std::is_sorted(rows.begin(), rows.end()));
+    EXPECT_EQ(rows.end(), std::adjacent_find(rows.begin(), rows.end()));
+    
+    std::size_t counts[4] = {0, 0, 0, 0};
+    for (std::size_t row : rows) {
+        counts[labels[row]]++;
+    }
+    EXPECT_EQ(178u, counts[1]);
+    EXPECT_EQ(20u, counts[2]);
+    EXPECT_EQ(2u, counts[3]);
+    
+    EXPECT_EQ(rows, CandidateScreen::stratifiedRows(labels, 200, 5));
+    EXPECT_NE(rows, CandidateScreen::stratifiedRows(labels, 200, 6));
+    
+    // Every class is represented even when its share rounds to zero
+    auto tiny = CandidateScreen::stratifiedRows(labels, 3, 1);
+    ASSERT_EQ(3u, tiny.size());
+    std::vector<Label> seen;
+    for (std::size_t row : tiny) {
+        seen.push_back(labels[row]);
+    }
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(std::vector<Label>({1, 2, 3}), seen);
+    
+    EXPECT_EQ(1000u, CandidateScreen::stratifiedRows(labels, 5000, 1).size());
+}
+
+// Best scores first, ties to the lower slot
+TEST(CandidateScreenTest, TopCandidates) {
+    std::vector<double> scores = {0.5, 0.9, 0.7, 0.9, 0.1, 123.0};
+    EXPECT_EQ(std::vector<std::size_t>({1, 3, 2}), CandidateScreen::topCandidates(scores, 5, 3));
+    EXPECT_EQ(5u, CandidateScreen::topCandidates(scores, 5, 10).size());
+    EXPECT_TRUE(CandidateScreen::topCandidates(scores, 0, 3).empty());
+}
+
+// Screened scores are exact leave-one-out accuracy within the sample
+TEST(CandidateScreenTest, ScoreOnSample) {
+    std::mt19937 rng(2);
+    std::normal_distribution<double> value(0.0, 1.0);
+    std::vector<std::vector<double>> rows(500, std::vector<double>(4));
+    LabelVector labels;
+    for (auto& row : rows) {
+        for (auto& v : row) {
+            v = value(rng);
+        }
+        labels.push_back(row[2] > 0.0 ? 1 : 2);
+    }
+    DataMatrix data = FeatureMatrix::fromRows(rows);
+    
+    CandidateScreen screen(data, labels, 120, 9);
+    ASSERT_EQ(120u, screen.sampleRows());
+    
+    std::vector<std::vector<double>> sampleRows;
+    LabelVector sampleLabels;
+    for (std::size_t row : screen.rows()) {
+        sampleRows.push_back(rows[row]);
+        sampleLabels.push_back(labels[row]);
+    }
+    DataMatrix sample = FeatureMatrix::fromRows(sampleRows);
+    
+    std::vector<FeatureIndex> features = {1, 2};
+    EXPECT_DOUBLE_EQ(
+        NearestNeighbor::leaveOneOutCrossValidation(sample, sampleLabels, {1, 2}),
+        screen.score(features.data(), features.size())
+    );
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "feature_selection/compact_matrix.h"
+#include "feature_selection/data_loader.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace feature_selection;
+
+// Test fixture with two well separated classes plus noise features
+class CompactMatrixTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(12);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        std::vector<std::vector<double>> rows(400, std::vector<double>(6));
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            Label label = i % 2 == 0 ? 1 : 2;
+            for (auto& v : rows[i]) {
+                v = 10.0 * noise(rng);
+            }
+            rows[i][1] = (label == 1 ? -4.0 : 4.0) + noise(rng);
+            rows[i][4] = (label == 1 ? 100.0 : 110.0) + 2.0 * noise(rng);
+            rows[i][5] = 7.5;
+            labels.push_back(label);
+        }
+        data = FeatureMatrix::fromRows(rows);
+    }
+    
+    DataMatrix data;
+    LabelVector labels;
+};
+
+// Stored values decode to within half a quantization step
+TEST_F(CompactMatrixTest, ValuesRoundTrip) {
+    EXPECT_THROW(CompactMatrix(data, StoragePrecision::Float64), std::runtime_error);
+    
+    for (StoragePrecision precision : {StoragePrecision::Float32, StoragePrecision::Int16, StoragePrecision::Int8}) {
+        CompactMatrix compact(data, precision);
+        EXPECT_EQ(data.rows(), compact.rows());
+        EXPECT_EQ(data.cols(), compact.cols());
+        
+        for (std::size_t j = 0; j < data.cols(); ++j) {
+            double tolerance = precision == StoragePrecision::Float32
+                ? 1e-6 * 200.0
+                : compact.scale(j) / 2.0 + 1e-9;
+            for (std::size_t i = 0; i < data.rows(); ++i) {
+                EXPECT_NEAR(data.at(i, j), compact.value(i, j), tolerance)
+                    << CompactMatrix::precisionName(precision) << " (" << i << ", " << j << ")";
+            }
+        }
+        
+        // A constant feature quantizes to a single level
+        if (precision != StoragePrecision::Float32) {
+            EXPECT_DOUBLE_EQ(0.0, compact.scale(5));
+            EXPECT_DOUBLE_EQ(7.5, compact.offset(5));
+        }
+    }
+}
+
+// Narrower types need proportionally less storage
+TEST_F(CompactMatrixTest, StorageBytes) {
+    std::size_t floats = CompactMatrix(data, StoragePrecision::Float32).storageBytes();
+    std::size_t words = CompactMatrix(data, StoragePrecision::Int16).storageBytes();
+    std::size_t bytes = CompactMatrix(data, StoragePrecision::Int8).storageBytes();
+    EXPECT_EQ(data.cols() * data.columnStride() * sizeof(float), floats);
+    EXPECT_EQ(floats / 2, words);
+    EXPECT_EQ(floats / 4, bytes);
+}
+
+// Leave-one-out accuracy tracks the double path closely
+TEST_F(CompactMatrixTest, ValidateAgainstDouble) {
+    std::vector<FeatureSet> subsets = {FeatureSet({1}), FeatureSet({1, 4}), FeatureSet({0, 2, 3}), FeatureSet()};
+    
+    for (StoragePrecision precision : {StoragePrecision::Float32, StoragePrecision::Int16, StoragePrecision::Int8}) {
+        CompactMatrix compact(data, precision);
+        auto checks = compact.validate(data, labels, subsets);
+        ASSERT_EQ(subsets.size(), checks.size());
+        for (const PrecisionCheck& check : checks) {
+            EXPECT_DOUBLE_EQ(
+                NearestNeighbor::leaveOneOutCrossValidation(data, labels, check.subset),
+                check.referenceAccuracy
+            );
+            EXPECT_DOUBLE_EQ(compact.leaveOneOutCrossValidation(labels, check.subset), check.compactAccuracy);
+            EXPECT_LE(std::abs(check.difference()), 0.05)
+                << CompactMatrix::precisionName(precision) << " " << featureSetToString(check.subset);
+        }
+        
+        // The separating features classify perfectly at any precision
+        EXPECT_DOUBLE_EQ(1.0, checks[1].compactAccuracy);
+    }
+    
+    // float32 differences are far below a single neighbor flip here
+    CompactMatrix floats(data, StoragePrecision::Float32);
+    for (const PrecisionCheck& check : floats.validate(data, labels, subsets)) {
+        EXPECT_DOUBLE_EQ(check.referenceAccuracy, check.compactAccuracy);
+    }
+}
+
+// The loader converts a text dataset straight to compact storage
+TEST_F(CompactMatrixTest, LoadCompactDataset) {
+    std::string path = ::testing::TempDir() + "fs_compact.txt";
+    {
+        std::ofstream file(path);
+        file << "1 0.5 10.0\n2 1.5 20.0\n1 0.75 30.0\n";
+    }
+    
+    auto [compact, loadedLabels] = DataLoader::loadCompactDataset(path, StoragePrecision::Int8);
+    std::remove(path.c_str());
+    
+    EXPECT_EQ(LabelVector({1, 2, 1}), loadedLabels);
+    ASSERT_EQ(3u, compact.rows());
+    ASSERT_EQ(2u, compact.cols());
+    EXPECT_EQ(StoragePrecision::Int8, compact.precision());
+    EXPECT_DOUBLE_EQ(0.5, compact.value(0, 0));
+    EXPECT_DOUBLE_EQ(1.5, compact.value(1, 0));
+    EXPECT_DOUBLE_EQ(30.0, compact.value(2, 1));
+}
+
+// Column-by-column loading normalizes and quantizes exactly like the double path
+TEST_F(CompactMatrixTest, LoadCompactDatasetMatchesDoublePath) {
+    std::string path = ::testing::TempDir() + "fs_compact_normalized.txt";
+    {
+        std::ofstream file(path);
+        file << std::setprecision(17);
+        for (std::size_t i = 0; i < data.rows(); ++i) {
+            file << labels[i];
+            for (std::size_t j = 0; j < data.cols(); ++j) {
+                file << " " << data.at(i, j);
+            }
+            file << "\n";
+        }
+    }
+    
+    for (NormalizationMethod method : {NormalizationMethod::None, NormalizationMethod::ZScore,
+                                       NormalizationMethod::Robust}) {
+        LoadOptions options;
+        options.normalization = method;
+        auto [reference, referenceLabels] = DataLoader::loadDataset(path, options);
+        auto [compact, loadedLabels] = DataLoader::loadCompactDataset(path, StoragePrecision::Int16, options);
+        CompactMatrix expected(reference, StoragePrecision::Int16);
+        
+        EXPECT_EQ(referenceLabels, loadedLabels);
+        ASSERT_EQ(expected.cols(), compact.cols());
+        for (std::size_t j = 0; j < compact.cols(); ++j) {
+            EXPECT_EQ(expected.scale(j), compact.scale(j)) << Normalizer::methodName(method);
+            for (std::size_t i = 0; i < compact.rows(); ++i) {
+                EXPECT_EQ(expected.value(i, j), compact.value(i, j));
+            }
+        }
+    }
+    std::remove(path.c_str());
+}
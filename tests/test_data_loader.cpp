@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include "feature_selection/data_loader.h"
 #include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 using namespace feature_selection;
 
@@ -143,6 +145,82 @@ TEST_F(DataLoaderTest, ErrorHandling) {
     EXPECT_THROW(DataLoader::loadDataset(nonExistentFile), std::runtime_error);
 }
 
+// Test fixture that writes small synthetic dataset files
+class DataLoaderParseTest : public ::testing::Test {
+protected:
+    std::string writeFile(const std::string& name, const std::string& contents) {
+        std::string path = ::testing::TempDir() + name;
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+        paths.push_back(path);
+        return path;
+    }
+    
+    void TearDown() override {
+        for (const auto& path : paths) {
+            std::remove(path.c_str());
+        }
+    }
+    
+    std::vector<std::string> paths;
+};
+
+// Scientific notation, explicit signs, blank lines and CRLF endings
+TEST_F(DataLoaderParseTest, ParsesTextFormats) {
+    std::string path = writeFile("fs_parse_formats.txt",
+        "  2.0000000e+000  1.5000000e-001 -3.2500000e+002\r\n"
+        "\n"
+        "1  +4e3\t-0.5\n"
+        "   \n"
+        "2.0000000e+000 7 8"
+    );
+    
+    auto [data, labels] = DataLoader::loadDataset(path);
+    ASSERT_EQ(3u, data.size());
+    ASSERT_EQ(2u, data.cols());
+    EXPECT_EQ(LabelVector({2, 1, 2}), labels);
+    EXPECT_DOUBLE_EQ(0.15, data[0][0]);
+    EXPECT_DOUBLE_EQ(-325.0, data[0][1]);
+    EXPECT_DOUBLE_EQ(4000.0, data[1][0]);
+    EXPECT_DOUBLE_EQ(-0.5, data[1][1]);
+    EXPECT_DOUBLE_EQ(8.0, data.columnData(1)[2]);
+}
+
+// Large files are split across chunks without losing or reordering rows
+TEST_F(DataLoaderParseTest, ChunkedParseKeepsRowOrder) {
+    std::ostringstream contents;
+    const std::size_t rows = 5000;
+    for (std::size_t i = 0; i < rows; ++i) {
+        contents << (i % 2 + 1) << " " << i << ".25 " << -static_cast<double>(i) << "e-1\n";
+    }
+    std::string path = writeFile("fs_parse_chunks.txt", contents.str());
+    
+    auto [data, labels] = DataLoader::loadDataset(path);
+    ASSERT_EQ(rows, data.size());
+    for (std::size_t i = 0; i < rows; ++i) {
+        ASSERT_EQ(static_cast<Label>(i % 2 + 1), labels[i]);
+        ASSERT_DOUBLE_EQ(static_cast<double>(i) + 0.25, data[i][0]);
+        ASSERT_DOUBLE_EQ(-static_cast<double>(i) / 10.0, data[i][1]);
+    }
+}
+
+// Ragged rows and malformed numbers are reported as load errors
+TEST_F(DataLoaderParseTest, RejectsMalformedInput) {
+    std::string ragged = writeFile("fs_parse_ragged.txt", "1 2 3\n2 4\n");
+    EXPECT_THROW(DataLoader::loadDataset(ragged), std::runtime_error);
+    
+    std::string tooLong = writeFile("fs_parse_long.txt", "1 2 3\n2 4 5 6\n");
+    EXPECT_THROW(DataLoader::loadDataset(tooLong), std::runtime_error);
+    
+    std::string garbage = writeFile("fs_parse_garbage.txt", "1 2 3\n2 4 x5\n");
+    EXPECT_THROW(DataLoader::loadDataset(garbage), std::runtime_error);
+    
+    std::string empty = writeFile("fs_parse_empty.txt", "");
+    auto [data, labels] = DataLoader::loadDataset(empty);
+    EXPECT_TRUE(data.empty());
+    EXPECT_TRUE(labels.empty());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
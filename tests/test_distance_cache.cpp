@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "feature_selection/distance_cache.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+// Test fixture with random data and random two-class labels
+class DistanceCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(42);
+        std::normal_distribution<double> value(0.0, 1.0);
+        std::vector<std::vector<double>> rows(90, std::vector<double>(6));
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            for (auto& v : rows[i]) {
+                v = value(rng);
+            }
+            labels.push_back(rows[i][1] + 0.5 * value(rng) > 0.0 ? 1 : 2);
+        }
+        data = FeatureMatrix::fromRows(rows);
+    }
+    
+    std::size_t exactCorrect(const FeatureSet& features) const {
+        double accuracy = NearestNeighbor::leaveOneOutCrossValidation(data, labels, features);
+        return static_cast<std::size_t>(accuracy * static_cast<double>(data.size()) + 0.5);
+    }
+    
+    DataMatrix data;
+    LabelVector labels;
+};
+
+// Incremental scores match a full LOOCV for every addition at every level
+TEST_F(DistanceCacheTest, AdditionsMatchLeaveOneOut) {
+    DistanceCache cache(data, labels);
+    std::vector<FeatureIndex> order = {3, 1, 5};
+    
+    for (FeatureIndex committed : order) {
+        std::vector<FeatureIndex> candidates;
+        for (FeatureIndex f = 0; f < data.cols(); ++f) {
+            if (!cache.features().count(f)) {
+                candidates.push_back(f);
+            }
+        }
+        
+        auto correct = cache.evaluateAdditions(candidates);
+        for (std::size_t c = 0; c < candidates.size(); ++c) {
+            FeatureSet candidateSet = cache.features();
+            candidateSet.insert(candidates[c]);
+            EXPECT_EQ(exactCorrect(candidateSet), correct[c]) << featureSetToString(candidateSet);
+        }
+        
+        cache.commitAddition(committed);
+        EXPECT_EQ(exactCorrect(cache.features()), cache.evaluateCurrent());
+    }
+}
+
+// Reset rebuilds the same state as committing features one by one
+TEST_F(DistanceCacheTest, ResetMatchesCommits) {
+    DistanceCache cache(data, labels);
+    cache.reset({0, 2, 4});
+    EXPECT_EQ(FeatureSet({0, 2, 4}), cache.features());
+    EXPECT_EQ(exactCorrect({0, 2, 4}), cache.evaluateCurrent());
+    
+    EXPECT_EQ(90u * 96u * sizeof(double), DistanceCache::requiredBytes(90));
+}
+
+// The refreshInterval()-th removal since the last rebuild rebuilds again
+TEST_F(DistanceCacheTest, RefreshEveryIntervalRemovals) {
+    DistanceCache cache(data, labels);
+    cache.setRefreshInterval(2);
+    cache.reset({0, 1, 2, 3, 4, 5});
+    
+    cache.commitRemoval(0);
+    EXPECT_EQ(1u, cache.removalsSinceRefresh());
+    cache.commitRemoval(1);
+    EXPECT_EQ(0u, cache.removalsSinceRefresh());
+    cache.commitRemoval(2);
+    EXPECT_EQ(1u, cache.removalsSinceRefresh());
+}
+
+// Decremental scores match a full LOOCV, with and without exact refreshes
+TEST_F(DistanceCacheTest, RemovalsMatchLeaveOneOut) {
+    for (std::size_t interval : {std::size_t(0), std::size_t(2), std::size_t(100)}) {
+        DistanceCache cache(data, labels);
+        cache.setRefreshInterval(interval);
+        cache.reset({0, 1, 2, 3, 4, 5});
+        
+        for (FeatureIndex removed : {2, 0, 5, 3}) {
+            std::vector<FeatureIndex> candidates(cache.features().begin(), cache.features().end());
+            auto correct = cache.evaluateRemovals(candidates);
+            for (std::size_t c = 0; c < candidates.size(); ++c) {
+                FeatureSet candidateSet = cache.features();
+                candidateSet.erase(candidates[c]);
+                EXPECT_EQ(exactCorrect(candidateSet), correct[c])
+                    << featureSetToString(candidateSet) << " interval=" << interval;
+            }
+            
+            cache.commitRemoval(removed);
+            EXPECT_EQ(exactCorrect(cache.features()), cache.evaluateCurrent());
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "feature_selection/distance_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+// Test fixture that restores the detected dispatch level after each test
+class DistanceKernelsTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        DistanceKernels::setLevel(DistanceKernels::detectLevel());
+    }
+    
+    static std::vector<double> randomVector(std::size_t size, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> dist(-10.0, 10.0);
+        std::vector<double> values(size);
+        for (auto& v : values) {
+            v = dist(rng);
+        }
+        return values;
+    }
+    
+    static const std::vector<DistanceKernels::SimdLevel>& allLevels() {
+        static const std::vector<DistanceKernels::SimdLevel> levels = {
+            DistanceKernels::SimdLevel::Scalar,
+            DistanceKernels::SimdLevel::SSE2,
+            DistanceKernels::SimdLevel::AVX2,
+            DistanceKernels::SimdLevel::AVX512,
+        };
+        return levels;
+    }
+};
+
+// Every level matches a plain reference loop for all tail lengths
+TEST_F(DistanceKernelsTest, ContiguousMatchesReference) {
+    auto a = randomVector(67, 1);
+    auto b = randomVector(67, 2);
+    
+    for (auto level : allLevels()) {
+        auto active = DistanceKernels::setLevel(level);
+        for (std::size_t count = 0; count <= a.size(); ++count) {
+            double expected = 0.0;
+            for (std::size_t i = 0; i < count; ++i) {
+                expected += (a[i] - b[i]) * (a[i] - b[i]);
+            }
+            EXPECT_NEAR(expected, DistanceKernels::squaredDistance(a.data(), b.data(), count),
+                        1e-9 * (1.0 + expected))
+                << DistanceKernels::levelName(active) << " count=" << count;
+        }
+    }
+}
+
+// Indexed kernels read only the listed features
+TEST_F(DistanceKernelsTest, IndexedMatchesReference) {
+    auto a = randomVector(64, 3);
+    auto b = randomVector(64, 4);
+    std::vector<FeatureIndex> indices = {63, 0, 7, 8, 9, 31, 2, 40, 41, 5, 17, 50, 33};
+    
+    for (auto level : allLevels()) {
+        auto active = DistanceKernels::setLevel(level);
+        for (std::size_t count = 0; count <= indices.size(); ++count) {
+            double expected = 0.0;
+            for (std::size_t i = 0; i < count; ++i) {
+                double d = a[indices[i]] - b[indices[i]];
+                expected += d * d;
+            }
+            EXPECT_NEAR(expected,
+                        DistanceKernels::squaredDistanceIndexed(a.data(), b.data(), indices.data(), count),
+                        1e-9 * (1.0 + expected))
+                << DistanceKernels::levelName(active) << " count=" << count;
+        }
+    }
+}
+
+// Every level sums in the same order, so results are bit-identical
+TEST_F(DistanceKernelsTest, LevelsAgreeExactly) {
+    auto a = randomVector(67, 5);
+    auto b = randomVector(67, 6);
+    std::vector<FeatureIndex> indices = {66, 3, 12, 1, 40, 41, 42, 0, 9, 17, 28, 64, 5, 33, 50, 21, 8, 60};
+    
+    for (std::size_t count = 0; count <= a.size(); ++count) {
+        DistanceKernels::setLevel(DistanceKernels::SimdLevel::Scalar);
+        const double contiguous = DistanceKernels::squaredDistance(a.data(), b.data(), count);
+        const std::size_t indexCount = std::min(count, indices.size());
+        const double indexed = DistanceKernels::squaredDistanceIndexed(a.data(), b.data(), indices.data(), indexCount);
+        
+        for (auto level : allLevels()) {
+            auto active = DistanceKernels::setLevel(level);
+            EXPECT_EQ(contiguous, DistanceKernels::squaredDistance(a.data(), b.data(), count))
+                << DistanceKernels::levelName(active) << " count=" << count;
+            EXPECT_EQ(indexed, DistanceKernels::squaredDistanceIndexed(a.data(), b.data(), indices.data(), indexCount))
+                << DistanceKernels::levelName(active) << " count=" << indexCount;
+        }
+    }
+}
+
+// Requests above the CPU's capability are clamped
+TEST_F(DistanceKernelsTest, SetLevelClampsToDetected) {
+    auto detected = DistanceKernels::detectLevel();
+    auto active = DistanceKernels::setLevel(DistanceKernels::SimdLevel::AVX512);
+    EXPECT_LE(static_cast<int>(active), static_cast<int>(detected));
+    EXPECT_EQ(DistanceKernels::SimdLevel::Scalar, DistanceKernels::setLevel(DistanceKernels::SimdLevel::Scalar));
+    EXPECT_EQ(DistanceKernels::SimdLevel::Scalar, DistanceKernels::activeLevel());
+}
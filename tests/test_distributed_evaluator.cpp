@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "feature_selection/distributed_evaluator.h"
+#include "feature_selection/feature_selection.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace feature_selection;
+
+// Test fixture with a binary dataset on disk where features 1 and 4 matter
+class DistributedEvaluatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(23);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        std::vector<std::vector<double>> rows(300, std::vector<double>(6));
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            Label label = i % 3 == 0 ? 1 : 2;
+            for (double& x : rows[i]) {
+                x = 2.0 * noise(rng);
+            }
+            rows[i][1] = (label == 1 ? -1.5 : 1.5) + 0.4 * noise(rng);
+            rows[i][4] = (label == 1 ? 1.5 : -1.5) + 0.4 * noise(rng);
+            labels.push_back(label);
+        }
+        rows[200] = rows[10];
+        data = FeatureMatrix::fromRows(rows);
+        
+        const std::string prefix = ::testing::TempDir() + "fs_distributed_" + std::to_string(::getpid());
+        datasetPath = prefix + ".fsbin";
+        socketPath = prefix + ".sock";
+        BinaryDataset::write(datasetPath, data, labels);
+    }
+    
+    void TearDown() override {
+        std::remove(datasetPath.c_str());
+    }
+    
+    // Run a worker on a thread over a socketpair and hand the other end to the coordinator
+    std::thread attachThreadWorker(DistributedCoordinator& coordinator, int* workerSocket = nullptr) {
+        int sockets[2];
+        EXPECT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+        std::thread thread([this, socket = sockets[0]] {
+            DistributedWorker(datasetPath).serve(socket);
+        });
+        coordinator.addWorker(sockets[1]);
+        if (workerSocket != nullptr) {
+            *workerSocket = sockets[0];
+        }
+        return thread;
+    }
+    
+    const std::vector<std::vector<FeatureIndex>> subsets = {{0}, {1, 4}, {0, 2, 3, 5}, {0, 1, 2, 3, 4, 5}};
+    DataMatrix data;
+    LabelVector labels;
+    std::string datasetPath;
+    std::string socketPath;
+};
+
+// Shard counts from a worker add up to the exact leave-one-out counts
+TEST_F(DistributedEvaluatorTest, ThreadWorkerMatchesExact) {
+    std::thread worker;
+    {
+        DistributedCoordinator coordinator(socketPath, datasetPath);
+        worker = attachThreadWorker(coordinator);
+        ASSERT_EQ(1u, coordinator.workerCount());
+        
+        auto counts = coordinator.countCorrect(subsets);
+        ASSERT_EQ(subsets.size(), counts.size());
+        for (std::size_t s = 0; s < counts.size(); ++s) {
+            const auto& subset = subsets[s];
+            EXPECT_EQ(NearestNeighbor::leaveOneOutCorrect(data, labels, subset.data(), subset.size()), counts[s]);
+        }
+        EXPECT_GE(coordinator.stats().unitsSent, subsets.size());
+    }
+    worker.join();
+}
+
+// A worker that disconnects has its units re-sent to the survivors
+TEST_F(DistributedEvaluatorTest, LostWorkerIsRequeued) {
+    std::thread lost, survivor;
+    {
+        DistributedCoordinator coordinator(socketPath, datasetPath);
+        int lostSocket = -1;
+        lost = attachThreadWorker(coordinator, &lostSocket);
+        survivor = attachThreadWorker(coordinator);
+        ::shutdown(lostSocket, SHUT_RDWR);
+        lost.join();
+        
+        auto counts = coordinator.countCorrect(subsets);
+        for (std::size_t s = 0; s < counts.size(); ++s) {
+            const auto& subset = subsets[s];
+            EXPECT_EQ(NearestNeighbor::leaveOneOutCorrect(data, labels, subset.data(), subset.size()), counts[s]);
+        }
+        EXPECT_EQ(1u, coordinator.stats().workersLost);
+        EXPECT_EQ(1u, coordinator.workerCount());
+    }
+    survivor.join();
+}
+
+// A worker that stops answering without disconnecting is dropped after the
+// timeout and its units go to the others
+TEST_F(DistributedEvaluatorTest, StalledWorkerIsRequeued) {
+    int stalled[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, stalled));
+    BinaryDataset dataset(datasetPath, false);
+    const std::uint64_t hello[] = {1, 3, dataset.rows(), dataset.cols(), dataset.payloadChecksum()};
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(hello)), ::write(stalled[0], hello, sizeof(hello)));
+    
+    std::thread survivor;
+    {
+        DistributedCoordinator coordinator(socketPath, datasetPath);
+        coordinator.setResultTimeout(1);
+        coordinator.addWorker(stalled[1]);
+        survivor = attachThreadWorker(coordinator);
+        
+        auto counts = coordinator.countCorrect(subsets);
+        for (std::size_t s = 0; s < counts.size(); ++s) {
+            const auto& subset = subsets[s];
+            EXPECT_EQ(NearestNeighbor::leaveOneOutCorrect(data, labels, subset.data(), subset.size()), counts[s]);
+        }
+        EXPECT_EQ(1u, coordinator.stats().workersLost);
+        EXPECT_GE(coordinator.stats().unitsRequeued, 1u);
+        EXPECT_EQ(1u, coordinator.workerCount());
+    }
+    survivor.join();
+    ::close(stalled[0]);
+}
+
+// Workers mapping another dataset are refused
+TEST_F(DistributedEvaluatorTest, RejectsDifferentDataset) {
+    const std::string otherPath = datasetPath + ".other";
+    BinaryDataset::write(otherPath, FeatureMatrix::fromRows({{1.0}, {2.0}}), {1, 2});
+    
+    DistributedCoordinator coordinator(socketPath, datasetPath);
+    int sockets[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+    std::thread worker([&] { DistributedWorker(otherPath).serve(sockets[0]); });
+    EXPECT_THROW(coordinator.addWorker(sockets[1]), std::runtime_error);
+    worker.join();
+    EXPECT_EQ(0u, coordinator.workerCount());
+    std::remove(otherPath.c_str());
+}
+
+// Worker processes reproduce the in-process forward and backward searches
+TEST_F(DistributedEvaluatorTest, SpawnedWorkersMatchSearch) {
+    DistributedCoordinator coordinator(socketPath, datasetPath);
+    coordinator.spawnWorkers(FEATURE_SELECTION_WORKER_PATH, 3);
+    ASSERT_EQ(3u, coordinator.workerCount());
+    
+    SearchOptions distributed;
+    distributed.coordinator = &coordinator;
+    
+    SearchResult forward = FeatureSelection::forwardSelection(data, labels, false);
+    SearchResult remoteForward = FeatureSelection::forwardSelection(data, labels, false, distributed);
+    SearchResult backward = FeatureSelection::backwardElimination(data, labels, false);
+    SearchResult remoteBackward = FeatureSelection::backwardElimination(data, labels, false, distributed);
+    
+    for (const auto& [reference, remote] : {std::make_pair(&forward, &remoteForward),
+                                            std::make_pair(&backward, &remoteBackward)}) {
+        ASSERT_EQ(reference->allResults.size(), remote->allResults.size());
+        for (std::size_t i = 0; i < reference->allResults.size(); ++i) {
+            EXPECT_EQ(reference->allResults[i].first, remote->allResults[i].first);
+            EXPECT_DOUBLE_EQ(reference->allResults[i].second, remote->allResults[i].second);
+        }
+        EXPECT_GT(remote->distributed.unitsSent, 0u);
+        EXPECT_EQ(0u, remote->distributed.workersLost);
+    }
+    
+    // The workers must hold the searched dataset, not just one of its shape
+    DataMatrix narrower = FeatureMatrix::fromRows({{1.0}, {2.0}});
+    EXPECT_THROW(FeatureSelection::forwardSelection(narrower, {1, 2}, false, distributed), std::runtime_error);
+    DataMatrix edited = data;
+    edited.set(7, 2, edited.at(7, 2) + 1.0);
+    EXPECT_THROW(FeatureSelection::forwardSelection(edited, labels, false, distributed), std::runtime_error);
+    LabelVector relabeled = labels;
+    relabeled[0] = relabeled[0] == 1 ? 2 : 1;
+    EXPECT_THROW(FeatureSelection::backwardElimination(data, relabeled, false, distributed), std::runtime_error);
+}
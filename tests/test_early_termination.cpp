@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "feature_selection/early_termination.h"
+#include "feature_selection/work_scheduler.h"
+#include <vector>
+
+using namespace feature_selection;
+
+// A candidate stops once it cannot reach the best finished count, never on a tie
+TEST(EarlyTerminationTest, LevelThreshold) {
+    EarlyTermination::Level level(100, 3, 1);
+    EXPECT_EQ(0u, level.threshold());
+
+    // Candidate 0 finishes with 90 correct
+    level.record(0, 64, 60);
+    level.record(0, 36, 30);
+    EXPECT_TRUE(level.complete(0));
+    EXPECT_EQ(90u, level.threshold());
+    EXPECT_FALSE(level.stopped(0));
+
+    // 10 errors leave candidate 1 able to tie at 90
+    level.record(1, 64, 54);
+    EXPECT_FALSE(level.stopped(1));
+
+    // 11 errors rule candidate 2 out
+    level.record(2, 64, 53);
+    EXPECT_TRUE(level.stopped(2));
+    EXPECT_FALSE(level.complete(2));
+    EXPECT_EQ(64u, level.rowsScored(2));
+}
+
+// With keep > 1 the bar is the smallest of the best `keep` finished counts
+TEST(EarlyTerminationTest, KeepSeveral) {
+    EarlyTermination::Level level(50, 4, 2);
+    level.finish(40);
+    EXPECT_EQ(0u, level.threshold());
+    level.finish(45);
+    EXPECT_EQ(40u, level.threshold());
+    level.finish(30);
+    EXPECT_EQ(40u, level.threshold());
+    level.finish(48);
+    EXPECT_EQ(45u, level.threshold());
+}
+
+// Blocks are a fixed multiple of the minimum block, hardest first
+TEST(EarlyTerminationTest, BlocksAndOrder) {
+    EarlyTermination large(10000);
+    EXPECT_EQ(640u, large.blockRows());
+    EXPECT_EQ(16u, large.blockCount());
+
+    EarlyTermination small(200);
+    EXPECT_EQ(WorkScheduler::kMinBlockRows, small.blockRows());
+    ASSERT_EQ(4u, small.blockCount());
+    EXPECT_EQ(std::vector<std::size_t>({0, 1, 2, 3}), small.blockOrder());
+
+    // The last block holds 8 rows, so 2 errors there rank as 16 per 64 rows
+    small.addErrors(1, 5);
+    small.addErrors(3, 2);
+    small.addErrors(2, 5);
+    EXPECT_EQ(std::vector<std::size_t>({3, 1, 2, 0}), small.blockOrder());
+
+    EarlyTermination::Level level(200, 2, 1);
+    level.record(0, 200, 150);
+    level.record(1, 64, 10);
+    small.countLevel(level, 2);
+    EXPECT_EQ(2u, small.stats().candidates);
+    EXPECT_EQ(1u, small.stats().stopped);
+    EXPECT_EQ(264u, small.stats().rowsScored);
+    EXPECT_EQ(400u, small.stats().rowsPossible);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "feature_selection/evaluation_memo.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+// 70 features so subsets span two bitset words
+DataMatrix wideData() {
+    std::vector<std::vector<double>> rows(4, std::vector<double>(70));
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        for (std::size_t j = 0; j < rows[i].size(); ++j) {
+            rows[i][j] = static_cast<double>((i * 31 + j * 7) % 11);
+        }
+    }
+    return FeatureMatrix::fromRows(rows);
+}
+
+const LabelVector kLabels = {1, 2, 1, 2};
+
+FeatureBitset subsetOf(std::size_t cols, const FeatureSet& features) {
+    return FeatureBitset(cols, features);
+}
+
+} // namespace
+
+// Stored accuracies come back for the same subset only, and lookups are counted
+TEST(EvaluationMemoTest, LookupAndStats) {
+    DataMatrix data = wideData();
+    EvaluationMemo memo(data, kLabels);
+    EXPECT_EQ(70u, memo.featureCount());
+
+    double accuracy = -1.0;
+    EXPECT_FALSE(memo.lookup(subsetOf(70, {1, 65}), accuracy));
+    memo.insert(subsetOf(70, {1, 65}), 0.75);
+    memo.insert(subsetOf(70, {}), 0.5);
+
+    ASSERT_TRUE(memo.lookup(subsetOf(70, {65, 1}), accuracy));
+    EXPECT_EQ(0.75, accuracy);
+    ASSERT_TRUE(memo.lookup(subsetOf(70, {}), accuracy));
+    EXPECT_EQ(0.5, accuracy);
+    EXPECT_FALSE(memo.lookup(subsetOf(70, {1}), accuracy));
+    EXPECT_EQ(2u, memo.size());
+
+    MemoStats stats = memo.stats();
+    EXPECT_EQ(4u, stats.lookups);
+    EXPECT_EQ(2u, stats.hits);
+    EXPECT_EQ(2u, stats.inserts);
+    EXPECT_DOUBLE_EQ(0.5, stats.hitRate());
+
+    EXPECT_THROW(memo.insert(subsetOf(69, {1}), 0.1), std::invalid_argument);
+}
+
+// Threads inserting and reading overlapping subsets see every value
+TEST(EvaluationMemoTest, ConcurrentInserts) {
+    DataMatrix data = wideData();
+    EvaluationMemo memo(data, kLabels);
+
+    #pragma omp parallel for
+    for (int f = 0; f < 70; ++f) {
+        for (int g = f; g < 70; ++g) {
+            memo.insert(subsetOf(70, {FeatureIndex(f), FeatureIndex(g)}), f * 100.0 + g);
+        }
+    }
+
+    EXPECT_EQ(70u * 71u / 2u, memo.size());
+    std::size_t found = 0;
+    #pragma omp parallel for reduction(+:found)
+    for (int f = 0; f < 70; ++f) {
+        for (int g = f; g < 70; ++g) {
+            double accuracy = 0.0;
+            if (memo.lookup(subsetOf(70, {FeatureIndex(f), FeatureIndex(g)}), accuracy) &&
+                accuracy == f * 100.0 + g) {
+                ++found;
+            }
+        }
+    }
+    EXPECT_EQ(70u * 71u / 2u, found);
+}
+
+// A saved memo loads into another memo of the same dataset only
+TEST(EvaluationMemoTest, SaveAndLoad) {
+    DataMatrix data = wideData();
+    const std::string path = ::testing::TempDir() + "memo.fsmemo";
+    {
+        EvaluationMemo memo(data, kLabels);
+        memo.insert(subsetOf(70, {0, 69}), 0.25);
+        memo.insert(subsetOf(70, {3}), 1.0);
+        memo.save(path);
+    }
+
+    EvaluationMemo loaded(data, kLabels);
+    loaded.load(path);
+    EXPECT_EQ(2u, loaded.size());
+    double accuracy = 0.0;
+    ASSERT_TRUE(loaded.lookup(subsetOf(70, {0, 69}), accuracy));
+    EXPECT_EQ(0.25, accuracy);
+
+    EvaluationMemo otherLabels(data, {2, 2, 1, 1});
+    EXPECT_FALSE(otherLabels.matches(data, kLabels));
+    EXPECT_THROW(otherLabels.load(path), std::runtime_error);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    bytes.back() ^= 0x5a;
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    EvaluationMemo damaged(data, kLabels);
+    EXPECT_THROW(damaged.load(path), std::runtime_error);
+
+    std::remove(path.c_str());
+    EXPECT_THROW(damaged.load(path), std::runtime_error);
+}
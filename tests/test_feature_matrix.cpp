@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "feature_selection/feature_matrix.h"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+std::vector<std::vector<double>> makeRows(std::size_t rows, std::size_t cols) {
+    std::vector<std::vector<double>> result(rows, std::vector<double>(cols));
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            result[i][j] = static_cast<double>(i * 100 + j);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+// Both views are aligned and padded to whole cache lines
+TEST(FeatureMatrixTest, AlignmentAndPadding) {
+    FeatureMatrix matrix(13, 5);
+    
+    EXPECT_EQ(13u, matrix.rows());
+    EXPECT_EQ(5u, matrix.cols());
+    EXPECT_EQ(0u, matrix.rowStride() % FeatureMatrix::kPadding);
+    EXPECT_EQ(0u, matrix.columnStride() % FeatureMatrix::kPadding);
+    EXPECT_GE(matrix.rowStride(), matrix.cols());
+    EXPECT_GE(matrix.columnStride(), matrix.rows());
+    
+    for (std::size_t i = 0; i < matrix.rows(); ++i) {
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(matrix.rowData(i)) % FeatureMatrix::kAlignment);
+    }
+    for (std::size_t j = 0; j < matrix.cols(); ++j) {
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(matrix.columnData(j)) % FeatureMatrix::kAlignment);
+    }
+}
+
+// Rows and columns expose the same values
+TEST(FeatureMatrixTest, RowAndColumnViewsAgree) {
+    auto rows = makeRows(37, 11);
+    FeatureMatrix matrix = FeatureMatrix::fromRows(rows);
+    
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        for (std::size_t j = 0; j < rows[i].size(); ++j) {
+            EXPECT_EQ(rows[i][j], matrix[i][j]);
+            EXPECT_EQ(rows[i][j], matrix.columnData(j)[i]);
+        }
+        // Padding stays zero so SIMD code can read full strides
+        for (std::size_t j = matrix.cols(); j < matrix.rowStride(); ++j) {
+            EXPECT_EQ(0.0, matrix.rowData(i)[j]);
+        }
+    }
+    
+    matrix.set(3, 4, -1.5);
+    EXPECT_EQ(-1.5, matrix.at(3, 4));
+    EXPECT_EQ(-1.5, matrix.columnData(4)[3]);
+}
+
+// Bulk writes to columns become visible in rows after a sync
+TEST(FeatureMatrixTest, SyncRowsFromColumns) {
+    FeatureMatrix matrix(50, 7);
+    for (std::size_t j = 0; j < matrix.cols(); ++j) {
+        for (std::size_t i = 0; i < matrix.rows(); ++i) {
+            matrix.mutableColumnData(j)[i] = static_cast<double>(i) - static_cast<double>(j);
+        }
+    }
+    matrix.syncRowsFromColumns();
+    
+    for (std::size_t i = 0; i < matrix.rows(); ++i) {
+        for (std::size_t j = 0; j < matrix.cols(); ++j) {
+            EXPECT_EQ(static_cast<double>(i) - static_cast<double>(j), matrix[i][j]);
+        }
+    }
+}
+
+// Copies are deep and iteration visits every row
+TEST(FeatureMatrixTest, CopyAndIterate) {
+    FeatureMatrix original = FeatureMatrix::fromRows(makeRows(4, 3));
+    FeatureMatrix copy = original;
+    copy.set(0, 0, 42.0);
+    
+    EXPECT_EQ(0.0, original[0][0]);
+    EXPECT_EQ(42.0, copy[0][0]);
+    
+    std::size_t count = 0;
+    for (const auto& row : original) {
+        EXPECT_EQ(3u, row.size());
+        ++count;
+    }
+    EXPECT_EQ(4u, count);
+}
+
+// Ragged input is rejected
+TEST(FeatureMatrixTest, InconsistentRowsThrow) {
+    std::vector<std::vector<double>> rows = {{1.0, 2.0}, {3.0}};
+    EXPECT_THROW(FeatureMatrix::fromRows(rows), std::runtime_error);
+}
@@ -0,0 +1,592 @@
+#include <gtest/gtest.h>
+#include "feature_selection/feature_selection.h"
+#include "feature_selection/nearest_neighbor.h"
+#include "feature_selection/feature_bitset.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace feature_selection;
+
+// Test fixture with a synthetic dataset where only features 2 and 5 matter
+class FeatureSelectionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const std::size_t instances = 120;
+        const std::size_t features = 8;
+        
+        std::mt19937 rng(170);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        
+        std::vector<std::vector<double>> rows(instances, std::vector<double>(features));
+        labels.resize(instances);
+        for (std::size_t i = 0; i < instances; ++i) {
+            Label label = (i % 2 == 0) ? 1 : 2;
+            labels[i] = label;
+            for (std::size_t j = 0; j < features; ++j) {
+                rows[i][j] = 3.0 * noise(rng);
+            }
+            double offset = (label == 1) ? -2.0 : 2.0;
+            rows[i][2] = offset + 0.3 * noise(rng);
+            rows[i][5] = offset + 0.3 * noise(rng);
+        }
+        data = FeatureMatrix::fromRows(rows);
+    }
+    
+    DataMatrix data;
+    LabelVector labels;
+};
+
+// Forward selection picks an informative feature first
+TEST_F(FeatureSelectionTest, ForwardSelection) {
+    SearchResult result = FeatureSelection::forwardSelection(data, labels, false);
+    
+    ASSERT_EQ(data.cols() + 1, result.allResults.size());
+    const FeatureSet& firstLevel = result.allResults[1].first;
+    ASSERT_EQ(1u, firstLevel.size());
+    EXPECT_TRUE(firstLevel.count(2) || firstLevel.count(5));
+    
+    EXPECT_GE(result.bestAccuracy, 0.95);
+    EXPECT_DOUBLE_EQ(
+        result.bestAccuracy,
+        NearestNeighbor::leaveOneOutCrossValidation(data, labels, result.bestFeatureSet)
+    );
+}
+
+// Backward elimination keeps the informative features in its best subset
+TEST_F(FeatureSelectionTest, BackwardElimination) {
+    SearchResult result = FeatureSelection::backwardElimination(data, labels, false);
+    
+    ASSERT_FALSE(result.allResults.empty());
+    EXPECT_EQ(data.cols(), result.allResults.front().first.size());
+    EXPECT_GE(result.bestAccuracy, 0.95);
+    EXPECT_DOUBLE_EQ(
+        result.bestAccuracy,
+        NearestNeighbor::leaveOneOutCrossValidation(data, labels, result.bestFeatureSet)
+    );
+}
+
+// The incremental distance cache reproduces the from-scratch search
+TEST_F(FeatureSelectionTest, ForwardSelectionWithoutCacheMatches) {
+    SearchOptions uncached;
+    uncached.distanceCacheBudget = 0;
+    
+    SearchResult cachedResult = FeatureSelection::forwardSelection(data, labels, false);
+    SearchResult uncachedResult = FeatureSelection::forwardSelection(data, labels, false, uncached);
+    
+    ASSERT_EQ(uncachedResult.allResults.size(), cachedResult.allResults.size());
+    for (std::size_t i = 0; i < cachedResult.allResults.size(); ++i) {
+        EXPECT_EQ(uncachedResult.allResults[i].first, cachedResult.allResults[i].first);
+        EXPECT_DOUBLE_EQ(uncachedResult.allResults[i].second, cachedResult.allResults[i].second);
+    }
+}
+
+// Decremental cache updates reproduce the from-scratch backward search
+TEST_F(FeatureSelectionTest, BackwardEliminationWithoutCacheMatches) {
+    SearchOptions uncached;
+    uncached.distanceCacheBudget = 0;
+    SearchOptions frequentRefresh;
+    frequentRefresh.cacheRefreshInterval = 1;
+    
+    SearchResult uncachedResult = FeatureSelection::backwardElimination(data, labels, false, uncached);
+    for (const auto& options : {SearchOptions(), frequentRefresh}) {
+        SearchResult cachedResult = FeatureSelection::backwardElimination(data, labels, false, options);
+        
+        ASSERT_EQ(uncachedResult.allResults.size(), cachedResult.allResults.size());
+        for (std::size_t i = 0; i < cachedResult.allResults.size(); ++i) {
+            EXPECT_EQ(uncachedResult.allResults[i].first, cachedResult.allResults[i].first);
+            EXPECT_DOUBLE_EQ(uncachedResult.allResults[i].second, cachedResult.allResults[i].second);
+        }
+    }
+}
+
+// Early-abandoning evaluation picks the same subsets and reports its pruning
+TEST_F(FeatureSelectionTest, PartialDistanceSearchMatches) {
+    SearchOptions pruned;
+    pruned.distanceCacheBudget = 0;
+    pruned.partialDistanceSearch = true;
+    
+    SearchResult reference = FeatureSelection::backwardElimination(data, labels, false);
+    SearchResult result = FeatureSelection::backwardElimination(data, labels, false, pruned);
+    
+    ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+    for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+        EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+        EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+    }
+    EXPECT_GT(result.pruning.candidates, 0u);
+    EXPECT_GT(result.pruning.abandoned, 0u);
+    EXPECT_LT(result.pruning.termsComputed, result.pruning.termsPossible);
+    EXPECT_EQ(0u, reference.pruning.candidates);
+}
+
+// Replicated data and pinned threads change where the work runs, not its result
+TEST_F(FeatureSelectionTest, NumaPlacementMatches) {
+    SearchOptions placed;
+    placed.distanceCacheBudget = 0;
+    placed.numaPlacement = NumaPlacement::Replicate;
+    placed.threadAffinity = ThreadAffinity::Spread;
+    
+    SearchResult reference = FeatureSelection::forwardSelection(data, labels, false);
+    SearchResult result = FeatureSelection::forwardSelection(data, labels, false, placed);
+    
+    ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+    for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+        EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+        EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+    }
+    EXPECT_EQ(NumaPlacement::Replicate, result.placement.placement);
+    EXPECT_EQ(ThreadAffinity::Spread, result.placement.affinity);
+    EXPECT_GE(result.placement.nodes, 1u);
+    EXPECT_EQ(NumaPlacement::FirstTouch, reference.placement.placement);
+}
+
+// A search resumed from a checkpoint part-way through reproduces the
+// uninterrupted search, with and without the distance cache
+TEST_F(FeatureSelectionTest, ResumeFromCheckpointMatches) {
+    const std::string path = ::testing::TempDir() + "resume_search.ckpt";
+    
+    for (std::size_t budget : {SearchOptions().distanceCacheBudget, std::size_t(0)}) {
+        for (bool forward : {true, false}) {
+            auto run = [&](const SearchOptions& options) {
+                return forward
+                    ? FeatureSelection::forwardSelection(data, labels, false, options)
+                    : FeatureSelection::backwardElimination(data, labels, false, options);
+            };
+            SearchOptions plain;
+            plain.distanceCacheBudget = budget;
+            SearchResult reference = run(plain);
+            
+            // Checkpoints every third level leave one after level 6 of 8
+            SearchOptions checkpointed = plain;
+            checkpointed.checkpointPath = path;
+            checkpointed.checkpointInterval = 3;
+            std::remove(path.c_str());
+            run(checkpointed);
+            
+            SearchOptions resumed = checkpointed;
+            resumed.resume = true;
+            resumed.checkpointInterval = 100;
+            SearchResult result = run(resumed);
+            
+            EXPECT_EQ(6u, result.resumedLevels);
+            EXPECT_EQ(0u, reference.resumedLevels);
+            ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+            for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+                EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+                EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+            }
+            EXPECT_EQ(reference.bestFeatureSet, result.bestFeatureSet);
+            EXPECT_DOUBLE_EQ(reference.bestAccuracy, result.bestAccuracy);
+            
+            // A checkpoint of the other direction is refused
+            SearchOptions wrongDirection = resumed;
+            EXPECT_THROW(
+                forward ? FeatureSelection::backwardElimination(data, labels, false, wrongDirection)
+                        : FeatureSelection::forwardSelection(data, labels, false, wrongDirection),
+                std::runtime_error
+            );
+        }
+    }
+    std::remove(path.c_str());
+    
+    // Resuming without a checkpoint file starts from scratch
+    SearchOptions fresh;
+    fresh.checkpointPath = path;
+    fresh.resume = true;
+    SearchResult result = FeatureSelection::forwardSelection(data, labels, false, fresh);
+    EXPECT_EQ(0u, result.resumedLevels);
+    EXPECT_EQ(data.cols() + 1, result.allResults.size());
+    std::remove(path.c_str());
+}
+
+// A search stopped after maxLevels levels and resumed from its checkpoint
+// ends like an uninterrupted one
+TEST_F(FeatureSelectionTest, MaxLevelsStopsAndResumes) {
+    const std::string path = ::testing::TempDir() + "max_levels.ckpt";
+    
+    for (bool forward : {true, false}) {
+        auto run = [&](const SearchOptions& options) {
+            return forward
+                ? FeatureSelection::forwardSelection(data, labels, false, options)
+                : FeatureSelection::backwardElimination(data, labels, false, options);
+        };
+        SearchResult reference = run(SearchOptions());
+        
+        SearchOptions limited;
+        limited.maxLevels = 2;
+        limited.checkpointPath = path;
+        std::remove(path.c_str());
+        SearchResult partial = run(limited);
+        ASSERT_EQ(3u, partial.allResults.size());
+        EXPECT_EQ(forward ? 2u : data.cols() - 2, partial.allResults.back().first.size());
+        
+        SearchOptions resumed = limited;
+        resumed.maxLevels = 0;
+        resumed.resume = true;
+        SearchResult result = run(resumed);
+        EXPECT_EQ(2u, result.resumedLevels);
+        ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+        for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+            EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+            EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+// One memo shared by both searches changes no result; the backward search
+// finds the empty set the forward search scored, and a repeated search is
+// answered entirely from the memo
+TEST_F(FeatureSelectionTest, SharedMemoMatches) {
+    EvaluationMemo memo(data, labels);
+    SearchOptions memoized;
+    memoized.memo = &memo;
+    SearchOptions uncachedMemoized = memoized;
+    uncachedMemoized.distanceCacheBudget = 0;
+    
+    SearchResult forwardReference = FeatureSelection::forwardSelection(data, labels, false);
+    SearchResult backwardReference = FeatureSelection::backwardElimination(data, labels, false);
+    SearchResult forward = FeatureSelection::forwardSelection(data, labels, false, memoized);
+    SearchResult backward = FeatureSelection::backwardElimination(data, labels, false, uncachedMemoized);
+    
+    for (const auto& [reference, result] : {std::make_pair(&forwardReference, &forward),
+                                            std::make_pair(&backwardReference, &backward)}) {
+        ASSERT_EQ(reference->allResults.size(), result->allResults.size());
+        for (std::size_t i = 0; i < reference->allResults.size(); ++i) {
+            EXPECT_EQ(reference->allResults[i].first, result->allResults[i].first);
+            EXPECT_DOUBLE_EQ(reference->allResults[i].second, result->allResults[i].second);
+        }
+    }
+    EXPECT_EQ(0u, forward.memo.hits);
+    EXPECT_EQ(forward.memo.lookups, forward.memo.inserts);
+    EXPECT_GT(backward.memo.hits, 0u);
+    EXPECT_EQ(0u, forwardReference.memo.lookups);
+    
+    SearchResult repeated = FeatureSelection::forwardSelection(data, labels, false, memoized);
+    EXPECT_GT(repeated.memo.lookups, 0u);
+    EXPECT_EQ(repeated.memo.lookups, repeated.memo.hits);
+    EXPECT_EQ(0u, repeated.memo.inserts);
+    EXPECT_EQ(forward.allResults, repeated.allResults);
+    
+    DataMatrix other = FeatureMatrix::fromRows({{1.0}, {2.0}});
+    EXPECT_THROW(
+        FeatureSelection::forwardSelection(other, {1, 2}, false, memoized), std::runtime_error
+    );
+}
+
+// A beam of width 1 is greedy forward selection; a wider beam traces one
+// subset per size and reports exact accuracies
+TEST_F(FeatureSelectionTest, BeamSearch) {
+    SearchOptions narrow;
+    narrow.beamWidth = 1;
+    SearchResult forward = FeatureSelection::forwardSelection(data, labels, false);
+    SearchResult greedy = FeatureSelection::beamSearch(data, labels, false, narrow);
+    ASSERT_EQ(forward.allResults.size(), greedy.allResults.size());
+    for (std::size_t i = 0; i < forward.allResults.size(); ++i) {
+        EXPECT_EQ(forward.allResults[i].first, greedy.allResults[i].first);
+        EXPECT_DOUBLE_EQ(forward.allResults[i].second, greedy.allResults[i].second);
+    }
+    
+    SearchOptions wide;
+    wide.beamWidth = 3;
+    SearchResult result = FeatureSelection::beamSearch(data, labels, false, wide);
+    ASSERT_EQ(data.cols() + 1, result.allResults.size());
+    for (std::size_t level = 0; level < result.allResults.size(); ++level) {
+        EXPECT_EQ(level, result.allResults[level].first.size());
+    }
+    EXPECT_GE(result.bestAccuracy, 0.95);
+    EXPECT_DOUBLE_EQ(
+        result.bestAccuracy,
+        NearestNeighbor::leaveOneOutCrossValidation(data, labels, result.bestFeatureSet)
+    );
+}
+
+// Floating searches move one feature per step, start like the greedy
+// searches and never report an accuracy they did not compute exactly
+TEST_F(FeatureSelectionTest, FloatingSelection) {
+    SearchResult forward = FeatureSelection::forwardSelection(data, labels, false);
+    SearchResult backward = FeatureSelection::backwardElimination(data, labels, false);
+    SearchResult sffs = FeatureSelection::floatingForwardSelection(data, labels, false);
+    SearchResult sbfs = FeatureSelection::floatingBackwardSelection(data, labels, false);
+    
+    for (const SearchResult* result : {&sffs, &sbfs}) {
+        ASSERT_GE(result->allResults.size(), 2u);
+        for (std::size_t i = 1; i < result->allResults.size(); ++i) {
+            const FeatureSet& before = result->allResults[i - 1].first;
+            const FeatureSet& after = result->allResults[i].first;
+            const std::size_t larger = std::max(before.size(), after.size());
+            const std::size_t smaller = std::min(before.size(), after.size());
+            EXPECT_EQ(larger, smaller + 1);
+        }
+        EXPECT_GE(result->bestAccuracy, 0.95);
+        EXPECT_DOUBLE_EQ(
+            result->bestAccuracy,
+            NearestNeighbor::leaveOneOutCrossValidation(data, labels, result->bestFeatureSet)
+        );
+    }
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(forward.allResults[i].first, sffs.allResults[i].first);
+        EXPECT_EQ(backward.allResults[i].first, sbfs.allResults[i].first);
+    }
+    EXPECT_EQ(data.cols(), sffs.allResults.back().first.size());
+    EXPECT_TRUE(sbfs.allResults.back().first.empty());
+}
+
+// The shared engine's scoring paths and the memo do not change the new searches
+TEST_F(FeatureSelectionTest, NewStrategiesEngineOptionsMatch) {
+    EvaluationMemo memo(data, labels);
+    SearchOptions engineOptions;
+    engineOptions.partialDistanceSearch = true;
+    engineOptions.memo = &memo;
+    engineOptions.beamWidth = 2;
+    SearchOptions plain;
+    plain.beamWidth = 2;
+    
+    using Strategy = SearchResult (*)(const DataMatrix&, const LabelVector&, bool, const SearchOptions&);
+    for (Strategy strategy : {Strategy(&FeatureSelection::beamSearch),
+                              Strategy(&FeatureSelection::floatingForwardSelection),
+                              Strategy(&FeatureSelection::floatingBackwardSelection)}) {
+        SearchResult reference = strategy(data, labels, false, plain);
+        SearchResult result = strategy(data, labels, false, engineOptions);
+        ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+        for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+            EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+            EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+        }
+        EXPECT_GT(result.pruning.candidates, 0u);
+        EXPECT_GT(result.memo.lookups, 0u);
+    }
+}
+
+// Stopping losing candidates early selects exactly the same subsets in
+// every strategy, and skips rows
+TEST_F(FeatureSelectionTest, EarlyTerminationMatches) {
+    SearchOptions plain;
+    plain.distanceCacheBudget = 0;
+    plain.beamWidth = 2;
+    SearchOptions stopping = plain;
+    stopping.earlyTermination = true;
+    
+    using Strategy = SearchResult (*)(const DataMatrix&, const LabelVector&, bool, const SearchOptions&);
+    for (Strategy strategy : {Strategy(&FeatureSelection::forwardSelection),
+                              Strategy(&FeatureSelection::backwardElimination),
+                              Strategy(&FeatureSelection::beamSearch),
+                              Strategy(&FeatureSelection::floatingForwardSelection)}) {
+        SearchResult reference = strategy(data, labels, false, plain);
+        SearchResult result = strategy(data, labels, false, stopping);
+        ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+        for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+            EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+            EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+        }
+        EXPECT_GT(result.termination.stopped, 0u);
+        EXPECT_LT(result.termination.rowsScored, result.termination.rowsPossible);
+        EXPECT_EQ(0u, reference.termination.candidates);
+    }
+}
+
+// With the default cache budget, early termination still applies to the
+// greedy searches: it takes the place of the distance cache
+TEST_F(FeatureSelectionTest, EarlyTerminationReplacesCache) {
+    SearchOptions stopping;
+    stopping.earlyTermination = true;
+    
+    using Strategy = SearchResult (*)(const DataMatrix&, const LabelVector&, bool, const SearchOptions&);
+    for (Strategy strategy : {Strategy(&FeatureSelection::forwardSelection),
+                              Strategy(&FeatureSelection::backwardElimination)}) {
+        SearchResult reference = strategy(data, labels, false, SearchOptions());
+        SearchResult result = strategy(data, labels, false, stopping);
+        ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+        for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+            EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+            EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+        }
+        EXPECT_GT(result.termination.candidates, 0u);
+        EXPECT_GT(result.termination.stopped, 0u);
+    }
+}
+
+// Re-scoring every screened candidate reproduces the exact search, and the
+// agreement counters cover every screened level
+TEST_F(FeatureSelectionTest, ScreeningWithFullRescoreMatches) {
+    SearchOptions screening;
+    screening.screeningRows = 60;
+    screening.screeningTopK = data.cols();
+    screening.screeningAudit = true;
+    
+    SearchResult reference = FeatureSelection::forwardSelection(data, labels, false);
+    SearchResult result = FeatureSelection::forwardSelection(data, labels, false, screening);
+    
+    ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+    for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+        EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+        EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+    }
+    
+    // The first forward level is scored exactly by the sorted sweep
+    EXPECT_EQ(data.cols() - 1, result.screening.levels);
+    EXPECT_EQ(result.screening.candidatesScreened, result.screening.candidatesRescored);
+    EXPECT_EQ(result.screening.levels, result.screening.auditedLevels);
+    EXPECT_EQ(result.screening.levels, result.screening.auditHits);
+    EXPECT_LE(result.screening.topAgreements, result.screening.levels);
+}
+
+// With a small top-k only a few candidates per level are scored exactly
+TEST_F(FeatureSelectionTest, ScreeningRescoresTopCandidates) {
+    SearchOptions screening;
+    screening.screeningRows = 60;
+    screening.screeningTopK = 2;
+    
+    SearchResult result = FeatureSelection::backwardElimination(data, labels, false, screening);
+    EXPECT_EQ(data.cols() - 1, result.screening.levels);
+    EXPECT_LE(result.screening.candidatesRescored, 2 * result.screening.levels);
+    EXPECT_LT(result.screening.candidatesRescored, result.screening.candidatesScreened);
+    EXPECT_EQ(0u, result.screening.auditedLevels);
+    
+    // Every recorded accuracy is exact, whatever was screened
+    for (const auto& [subset, accuracy] : result.allResults) {
+        EXPECT_DOUBLE_EQ(NearestNeighbor::leaveOneOutCrossValidation(data, labels, subset), accuracy)
+            << featureSetToString(subset);
+    }
+}
+
+// With every candidate a finalist halving only adds sampled rounds, so the
+// searches match the exact ones
+TEST_F(FeatureSelectionTest, HalvingWithAllFinalistsMatches) {
+    SearchOptions halving;
+    halving.halvingRows = 16;
+    halving.halvingFinalists = data.cols();
+    
+    for (bool forward : {true, false}) {
+        SearchResult reference = forward ? FeatureSelection::forwardSelection(data, labels, false)
+                                         : FeatureSelection::backwardElimination(data, labels, false);
+        SearchResult result = forward ? FeatureSelection::forwardSelection(data, labels, false, halving)
+                                      : FeatureSelection::backwardElimination(data, labels, false, halving);
+        ASSERT_EQ(reference.allResults.size(), result.allResults.size());
+        for (std::size_t i = 0; i < reference.allResults.size(); ++i) {
+            EXPECT_EQ(reference.allResults[i].first, result.allResults[i].first);
+            EXPECT_DOUBLE_EQ(reference.allResults[i].second, result.allResults[i].second);
+        }
+        EXPECT_EQ(data.cols() - 1, result.halving.levels.size());
+        EXPECT_TRUE(reference.halving.levels.empty());
+    }
+}
+
+// Halving down to two finalists records its schedule, saves distance work
+// and still finds the informative features
+TEST_F(FeatureSelectionTest, HalvingSchedule) {
+    SearchOptions halving;
+    halving.halvingRows = 16;
+    
+    SearchResult result = FeatureSelection::backwardElimination(data, labels, false, halving);
+    ASSERT_EQ(data.cols() - 1, result.halving.levels.size());
+    
+    // Eight candidates: 8@16, 4@32, then two exact finalists
+    const HalvingLevel& first = result.halving.levels.front();
+    ASSERT_EQ(2u, first.rounds.size());
+    EXPECT_EQ(16u, first.rounds[0].sampleRows);
+    EXPECT_EQ(8u, first.rounds[0].candidates);
+    EXPECT_EQ(32u, first.rounds[1].sampleRows);
+    EXPECT_EQ(4u, first.rounds[1].candidates);
+    EXPECT_EQ(2u, first.finalists);
+    EXPECT_GT(result.halving.savedFraction(), 0.5);
+    
+    for (const auto& [subset, accuracy] : result.allResults) {
+        EXPECT_DOUBLE_EQ(NearestNeighbor::leaveOneOutCrossValidation(data, labels, subset), accuracy)
+            << featureSetToString(subset);
+    }
+    EXPECT_TRUE(result.bestFeatureSet.count(2) && result.bestFeatureSet.count(5));
+    EXPECT_GE(result.bestAccuracy, 0.95);
+}
+
+// Reduced-precision scoring with validation records both accuracies per level
+TEST_F(FeatureSelectionTest, ReducedPrecisionValidation) {
+    SearchOptions compact;
+    compact.storagePrecision = StoragePrecision::Int16;
+    compact.validatePrecision = true;
+    
+    SearchResult result = FeatureSelection::forwardSelection(data, labels, false, compact);
+    const CompactMatrix storage(data, StoragePrecision::Int16);
+    ASSERT_EQ(result.allResults.size() - 1, result.precisionChecks.size());
+    for (std::size_t i = 0; i < result.precisionChecks.size(); ++i) {
+        const PrecisionCheck& check = result.precisionChecks[i];
+        EXPECT_EQ(result.allResults[i + 1].first, check.subset);
+        EXPECT_DOUBLE_EQ(storage.leaveOneOutCrossValidation(labels, check.subset), check.compactAccuracy);
+        EXPECT_DOUBLE_EQ(NearestNeighbor::leaveOneOutCrossValidation(data, labels, check.subset), check.referenceAccuracy);
+        
+        // The first level is chosen by the double sorted sweep, later ones on the compact copy
+        if (i > 0) {
+            EXPECT_DOUBLE_EQ(result.allResults[i + 1].second, check.compactAccuracy);
+        }
+    }
+    
+    // An informative feature still leads and the search still separates the classes
+    EXPECT_TRUE(result.allResults[1].first.count(2) || result.allResults[1].first.count(5));
+    EXPECT_GE(result.bestAccuracy, 0.95);
+    EXPECT_TRUE(FeatureSelection::forwardSelection(data, labels, false).precisionChecks.empty());
+}
+
+// Searching the compact storage alone scores every level on it
+TEST_F(FeatureSelectionTest, CompactOnlySearch) {
+    const CompactMatrix storage(data, StoragePrecision::Int8);
+    SearchOptions options;
+    options.earlyTermination = true;
+    
+    SearchResult forward = FeatureSelection::forwardSelection(storage, labels, false, options);
+    ASSERT_EQ(data.cols() + 1, forward.allResults.size());
+    for (const auto& [subset, accuracy] : forward.allResults) {
+        EXPECT_DOUBLE_EQ(storage.leaveOneOutCrossValidation(labels, subset), accuracy);
+    }
+    EXPECT_TRUE(forward.allResults[1].first.count(2) || forward.allResults[1].first.count(5));
+    EXPECT_GE(forward.bestAccuracy, 0.95);
+    EXPECT_GT(forward.termination.candidates, 0u);
+    
+    SearchResult backward = FeatureSelection::backwardElimination(storage, labels, false);
+    ASSERT_EQ(data.cols() + 1, backward.allResults.size());
+    EXPECT_EQ(data.cols(), backward.allResults.front().first.size());
+    EXPECT_TRUE(backward.allResults.back().first.empty());
+    
+    EXPECT_THROW(FeatureSelection::forwardSelection(storage, LabelVector(3, 1), false), std::invalid_argument);
+}
+
+// Bitset subsets round-trip through FeatureSet in ascending order
+TEST(FeatureBitsetTest, InsertEraseAndConvert) {
+    FeatureBitset bits(130, {129, 0, 64, 7, 500});
+    EXPECT_EQ(4u, bits.count());
+    EXPECT_TRUE(bits.contains(64));
+    EXPECT_FALSE(bits.contains(63));
+    
+    bits.erase(64);
+    bits.insert(65);
+    EXPECT_EQ(FeatureSet({0, 7, 65, 129}), bits.toSet());
+    
+    std::vector<FeatureIndex> list;
+    bits.toList(list);
+    EXPECT_EQ(std::vector<FeatureIndex>({0, 7, 65, 129}), list);
+    
+    EXPECT_TRUE(FeatureBitset(10).empty());
+    EXPECT_EQ(FeatureBitset(130, {0, 7, 65, 129}), bits);
+}
+
+// Ties between candidates go to the lowest feature index
+TEST(FeatureSelectionTieTest, TiesPickLowestFeature) {
+    // Features 0 and 1 are identical copies, so every level ties
+    DataMatrix data = FeatureMatrix::fromRows({
+        {0.0, 0.0}, {0.1, 0.1}, {1.0, 1.0}, {1.1, 1.1}
+    });
+    LabelVector labels = {1, 1, 2, 2};
+    
+    for (std::size_t budget : {std::size_t(0), std::size_t(1) << 20}) {
+        SearchOptions options;
+        options.distanceCacheBudget = budget;
+        SearchResult forward = FeatureSelection::forwardSelection(data, labels, false, options);
+        EXPECT_EQ(FeatureSet({0}), forward.allResults[1].first);
+        
+        SearchResult backward = FeatureSelection::backwardElimination(data, labels, false, options);
+        EXPECT_EQ(FeatureSet({1}), backward.allResults[1].first);
+    }
+}
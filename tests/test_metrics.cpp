@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "feature_selection/metrics.h"
+#include "feature_selection/data_loader.h"
+#include "feature_selection/feature_selection.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+MetricsSnapshot sampleSnapshot() {
+    MetricsSnapshot snapshot;
+    snapshot.enabled = true;
+    snapshot.counters[static_cast<std::size_t>(Counter::DistanceEvaluations)] = 1200;
+    snapshot.counters[static_cast<std::size_t>(Counter::BytesLoaded)] = 4000000;
+    snapshot.phaseNanoseconds[static_cast<std::size_t>(Phase::Load)] = 2000000000;
+    snapshot.phaseCalls[static_cast<std::size_t>(Phase::Load)] = 1;
+    snapshot.levels.push_back({"forward", 1, 8, 0.25});
+    return snapshot;
+}
+
+} // namespace
+
+// Throughput and both export formats are derived from the totals
+TEST(MetricsTest, Formats) {
+    MetricsSnapshot snapshot = sampleSnapshot();
+    EXPECT_DOUBLE_EQ(2.0, snapshot.loadMegabytesPerSecond());
+    EXPECT_DOUBLE_EQ(0.0, snapshot.parseMegabytesPerSecond());
+    
+    const std::string json = snapshot.toJson();
+    EXPECT_TRUE(contains(json, "\"distance_evaluations\": 1200"));
+    EXPECT_TRUE(contains(json, "\"load\": {\"seconds\": 2, \"calls\": 1}"));
+    EXPECT_TRUE(contains(json, "\"load_mb_per_second\": 2"));
+    EXPECT_TRUE(contains(json, "{\"search\": \"forward\", \"level\": 1, \"candidates\": 8, \"seconds\": 0.25}"));
+    EXPECT_TRUE(contains(MetricsSnapshot().toJson(), "\"levels\": []"));
+    
+    const std::string text = snapshot.toPrometheus();
+    EXPECT_TRUE(contains(text, "# TYPE feature_selection_distance_evaluations_total counter\n"));
+    EXPECT_TRUE(contains(text, "feature_selection_distance_evaluations_total 1200\n"));
+    EXPECT_TRUE(contains(text, "feature_selection_phase_seconds_total{phase=\"load\"} 2\n"));
+    EXPECT_TRUE(contains(text, "feature_selection_level_seconds{search=\"forward\",level=\"1\"} 0.25\n"));
+    EXPECT_TRUE(contains(text, "feature_selection_level_candidates{search=\"forward\",level=\"1\"} 8\n"));
+}
+
+// Counts from parallel threads add up, and reset clears them
+TEST(MetricsTest, CountsAcrossThreads) {
+    if (!Metrics::enabled()) {
+        GTEST_SKIP() << "Built without FEATURE_SELECTION_METRICS";
+    }
+    Metrics::reset();
+    
+    #pragma omp parallel for
+    for (int i = 0; i < 1000; ++i) {
+        Metrics::add(Counter::DistanceEvaluations, 3);
+    }
+    {
+        Metrics::ScopedTimer timer(Phase::Search);
+        Metrics::LevelTimer level("beam", 2, 5);
+    }
+    
+    MetricsSnapshot snapshot = Metrics::snapshot();
+    EXPECT_EQ(3000u, snapshot.counter(Counter::DistanceEvaluations));
+    EXPECT_EQ(1u, snapshot.phaseCalls[static_cast<std::size_t>(Phase::Search)]);
+    ASSERT_EQ(1u, snapshot.levels.size());
+    EXPECT_EQ("beam", snapshot.levels[0].search);
+    EXPECT_EQ(5u, snapshot.levels[0].candidates);
+    
+    Metrics::reset();
+    snapshot = Metrics::snapshot();
+    EXPECT_EQ(0u, snapshot.counter(Counter::DistanceEvaluations));
+    EXPECT_TRUE(snapshot.levels.empty());
+}
+
+// A load and a search record their throughput, work and per-level times
+TEST(MetricsTest, InstrumentedRun) {
+    if (!Metrics::enabled()) {
+        GTEST_SKIP() << "Built without FEATURE_SELECTION_METRICS";
+    }
+    const std::string textPath = ::testing::TempDir() + "fs_metrics.txt";
+    {
+        std::ofstream file(textPath);
+        for (int i = 0; i < 40; ++i) {
+            file << (i % 2 + 1) << " " << (i % 2) * 3.0 + (i % 5) * 0.1 << " " << (i % 7) << " " << (i % 3) << "\n";
+        }
+    }
+    Metrics::reset();
+    
+    auto [data, labels] = DataLoader::loadDataset(textPath);
+    SearchOptions options;
+    options.distanceCacheBudget = 0;
+    FeatureSelection::forwardSelection(data, labels, false, options);
+    
+    MetricsSnapshot snapshot = Metrics::snapshot();
+    EXPECT_EQ(snapshot.counter(Counter::BytesLoaded), snapshot.counter(Counter::BytesParsed));
+    EXPECT_GT(snapshot.counter(Counter::BytesParsed), 0u);
+    EXPECT_EQ(1u, snapshot.phaseCalls[static_cast<std::size_t>(Phase::Parse)]);
+    EXPECT_EQ(1u, snapshot.phaseCalls[static_cast<std::size_t>(Phase::Search)]);
+    
+    // The empty set plus 3 + 2 + 1 candidates over three levels
+    EXPECT_EQ(7u, snapshot.counter(Counter::LeaveOneOutCalls));
+    EXPECT_EQ(7u * 40u * 39u, snapshot.counter(Counter::DistanceEvaluations));
+    ASSERT_EQ(3u, snapshot.levels.size());
+    for (std::size_t l = 0; l < 3; ++l) {
+        EXPECT_EQ("forward", snapshot.levels[l].search);
+        EXPECT_EQ(l + 1, snapshot.levels[l].level);
+        EXPECT_EQ(3 - l, snapshot.levels[l].candidates);
+    }
+    
+    const std::string jsonPath = ::testing::TempDir() + "fs_metrics.json";
+    Metrics::write(jsonPath);
+    std::ifstream file(jsonPath);
+    std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_TRUE(contains(json, "\"leave_one_out_calls\": 7"));
+    
+    std::remove(textPath.c_str());
+    std::remove(jsonPath.c_str());
+    Metrics::reset();
+}
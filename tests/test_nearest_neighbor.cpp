@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "feature_selection/nearest_neighbor.h"
+#include <cmath>
+#include <vector>
+
+using namespace feature_selection;
+
+// Test fixture with a small hand-made dataset
+class NearestNeighborTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Feature 0 separates the classes, feature 1 is noise
+        data = FeatureMatrix::fromRows({
+            {0.0, 5.0},
+            {0.1, -3.0},
+            {0.2, 9.0},
+            {5.0, 4.0},
+            {5.1, -2.0},
+            {5.2, 8.0},
+        });
+        labels = {1, 1, 1, 2, 2, 2};
+    }
+    
+    DataMatrix data;
+    LabelVector labels;
+};
+
+// Distance over all features and over a subset
+TEST_F(NearestNeighborTest, CalculateDistance) {
+    DataPoint a = {0.0, 0.0, 0.0};
+    DataPoint b = {3.0, 4.0, 12.0};
+    
+    EXPECT_DOUBLE_EQ(13.0, NearestNeighbor::calculateDistance(a, b));
+    EXPECT_DOUBLE_EQ(5.0, NearestNeighbor::calculateDistance(a, b, {0, 1}));
+    EXPECT_DOUBLE_EQ(12.0, NearestNeighbor::calculateDistance(a, b, {2}));
+}
+
+// The query row itself is skipped and ties go to the lowest index
+TEST_F(NearestNeighborTest, FindNearestNeighbor) {
+    EXPECT_EQ(1u, NearestNeighbor::findNearestNeighbor(data, data[0], 0, {0}));
+    EXPECT_EQ(4u, NearestNeighbor::findNearestNeighbor(data, data[3], 3, {0}));
+    
+    DataMatrix ties = FeatureMatrix::fromRows({{1.0}, {0.0}, {2.0}, {0.0}});
+    EXPECT_EQ(1u, NearestNeighbor::findNearestNeighbor(ties, ties[0], 0));
+}
+
+// LOOCV accuracy with the informative and the noisy feature
+TEST_F(NearestNeighborTest, LeaveOneOutCrossValidation) {
+    EXPECT_DOUBLE_EQ(1.0, NearestNeighbor::leaveOneOutCrossValidation(data, labels, {0}));
+    EXPECT_LT(NearestNeighbor::leaveOneOutCrossValidation(data, labels, {1}), 1.0);
+    
+    LabelVector mismatched = {1, 2};
+    EXPECT_DOUBLE_EQ(0.0, NearestNeighbor::leaveOneOutCrossValidation(data, mismatched, {0}));
+}
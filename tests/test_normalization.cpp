@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "feature_selection/normalization.h"
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+// Column 0: 1..8, column 1: constant, column 2: large offset with an outlier
+DataMatrix sampleData() {
+    std::vector<std::vector<double>> rows;
+    for (int i = 0; i < 8; ++i) {
+        rows.push_back({1.0 + i, 5.0, 1e9 + i + (i == 7 ? 1000.0 : 0.0)});
+    }
+    return FeatureMatrix::fromRows(rows);
+}
+
+void expectViewsAgree(const DataMatrix& data) {
+    for (std::size_t i = 0; i < data.rows(); ++i) {
+        for (std::size_t j = 0; j < data.cols(); ++j) {
+            EXPECT_EQ(data.at(i, j), data.columnData(j)[i]);
+        }
+    }
+}
+
+} // namespace
+
+// The single-pass statistics match a two-pass reference, even far from zero
+TEST(NormalizationTest, ColumnStats) {
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(1e6, 3.0);
+    std::vector<std::vector<double>> rows(1000, std::vector<double>(3));
+    for (auto& row : rows) {
+        for (double& value : row) {
+            value = noise(rng);
+        }
+    }
+    DataMatrix data = FeatureMatrix::fromRows(rows);
+    
+    std::vector<ColumnStats> stats = Normalizer::columnStats(data);
+    ASSERT_EQ(3u, stats.size());
+    for (std::size_t j = 0; j < 3; ++j) {
+        double mean = 0.0;
+        double lo = rows[0][j];
+        double hi = rows[0][j];
+        for (const auto& row : rows) {
+            mean += row[j];
+            lo = std::min(lo, row[j]);
+            hi = std::max(hi, row[j]);
+        }
+        mean /= rows.size();
+        double variance = 0.0;
+        for (const auto& row : rows) {
+            variance += (row[j] - mean) * (row[j] - mean);
+        }
+        variance /= rows.size();
+        
+        EXPECT_NEAR(mean, stats[j].mean, 1e-7);
+        EXPECT_NEAR(std::sqrt(variance), stats[j].stddev, 1e-9);
+        EXPECT_EQ(lo, stats[j].min);
+        EXPECT_EQ(hi, stats[j].max);
+    }
+}
+
+// Each method maps its center to 0 and its scale to 1; constant columns become 0
+TEST(NormalizationTest, Methods) {
+    {
+        DataMatrix data = sampleData();
+        NormalizationParams params = Normalizer::normalize(data, NormalizationMethod::MinMax);
+        EXPECT_EQ(NormalizationMethod::MinMax, params.method);
+        EXPECT_DOUBLE_EQ(0.0, data.at(0, 0));
+        EXPECT_DOUBLE_EQ(1.0, data.at(7, 0));
+        EXPECT_DOUBLE_EQ(1.0, data.at(7, 2));
+        EXPECT_DOUBLE_EQ(1.0, params.scales[1]);
+        EXPECT_DOUBLE_EQ(0.0, data.at(3, 1));
+        expectViewsAgree(data);
+    }
+    {
+        DataMatrix data = sampleData();
+        NormalizationParams params = Normalizer::normalize(data, NormalizationMethod::ZScore);
+        EXPECT_DOUBLE_EQ(4.5, params.centers[0]);
+        EXPECT_DOUBLE_EQ(std::sqrt(5.25), params.scales[0]);
+        std::vector<ColumnStats> stats = Normalizer::columnStats(data);
+        EXPECT_NEAR(0.0, stats[0].mean, 1e-12);
+        EXPECT_NEAR(1.0, stats[0].stddev, 1e-12);
+        EXPECT_NEAR(1.0, stats[2].stddev, 1e-9);
+        expectViewsAgree(data);
+    }
+    {
+        // The outlier does not move the median or the interquartile range
+        DataMatrix data = sampleData();
+        NormalizationParams params = Normalizer::normalize(data, NormalizationMethod::Robust);
+        EXPECT_DOUBLE_EQ(4.5, params.centers[0]);
+        EXPECT_DOUBLE_EQ(3.5, params.scales[0]);
+        EXPECT_DOUBLE_EQ(1e9 + 3.5, params.centers[2]);
+        EXPECT_DOUBLE_EQ(3.5, params.scales[2]);
+        EXPECT_DOUBLE_EQ(-1.0, data.at(0, 0));
+        expectViewsAgree(data);
+    }
+    {
+        DataMatrix data = sampleData();
+        NormalizationParams params = Normalizer::normalize(data, NormalizationMethod::None);
+        EXPECT_TRUE(params.empty());
+        EXPECT_EQ(1e9, data.at(0, 2));
+    }
+}
+
+// Parameters fitted on one matrix apply to another of the same width only
+TEST(NormalizationTest, ApplyAndParse) {
+    DataMatrix data = sampleData();
+    NormalizationParams params = Normalizer::fit(data, NormalizationMethod::MinMax);
+    EXPECT_EQ(1.0, data.at(0, 0));
+    
+    DataMatrix copy = sampleData();
+    Normalizer::apply(copy, params);
+    EXPECT_DOUBLE_EQ(0.0, copy.at(0, 0));
+    
+    DataMatrix narrow = FeatureMatrix::fromRows({{1.0}, {2.0}});
+    EXPECT_THROW(Normalizer::apply(narrow, params), std::invalid_argument);
+    
+    for (NormalizationMethod method : {NormalizationMethod::None, NormalizationMethod::ZScore,
+                                       NormalizationMethod::MinMax, NormalizationMethod::Robust}) {
+        EXPECT_EQ(method, Normalizer::parseMethod(Normalizer::methodName(method)));
+    }
+    EXPECT_THROW(Normalizer::parseMethod("l2"), std::invalid_argument);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "feature_selection/numa_topology.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+using namespace feature_selection;
+
+// Kernel cpulists with ranges, singletons and whitespace
+TEST(NumaTopologyTest, ParseCpuList) {
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 8, 10, 11}), NumaTopology::parseCpuList("0-3,8,10-11\n"));
+    EXPECT_EQ(std::vector<int>({5}), NumaTopology::parseCpuList("5"));
+    EXPECT_TRUE(NumaTopology::parseCpuList("").empty());
+    EXPECT_THROW(NumaTopology::parseCpuList("3-1"), std::runtime_error);
+    EXPECT_THROW(NumaTopology::parseCpuList("a-b"), std::runtime_error);
+}
+
+// Compact fills a node before the next; spread alternates between nodes
+TEST(NumaTopologyTest, ThreadToCpuMapping) {
+    NumaTopology topology = NumaTopology::fromCpuLists({"0-1", "", "4-5"});
+    ASSERT_EQ(2u, topology.nodeCount());
+    EXPECT_EQ(2u, topology.nodes()[1].id);
+    EXPECT_EQ(1u, topology.nodeOfCpu(5));
+    EXPECT_EQ(0u, topology.nodeOfCpu(99));
+
+    std::vector<int> compact, spread;
+    for (std::size_t t = 0; t < 5; ++t) {
+        compact.push_back(topology.cpuForThread(ThreadAffinity::Compact, t));
+        spread.push_back(topology.cpuForThread(ThreadAffinity::Spread, t));
+    }
+    EXPECT_EQ(std::vector<int>({0, 1, 4, 5, 0}), compact);
+    EXPECT_EQ(std::vector<int>({0, 4, 1, 5, 0}), spread);
+    EXPECT_EQ(-1, topology.cpuForThread(ThreadAffinity::None, 0));
+}
+
+// This machine always has at least one node with a CPU
+TEST(NumaTopologyTest, DetectAndReport) {
+    const NumaTopology& topology = NumaTopology::detect();
+    EXPECT_EQ(&topology, &NumaTopology::detect());
+    ASSERT_GE(topology.nodeCount(), 1u);
+    EXPECT_FALSE(topology.nodes()[0].cpus.empty());
+    EXPECT_LT(topology.currentNode(), topology.nodeCount());
+
+    PlacementReport report = topology.pinThreads(ThreadAffinity::None);
+    EXPECT_TRUE(report.threadCpus.empty());
+    EXPECT_EQ("first-touch on " + std::to_string(topology.nodeCount()) +
+              (topology.nodeCount() == 1 ? " node" : " nodes") + ", threads unpinned", report.toString());
+
+    PlacementReport manual;
+    manual.placement = NumaPlacement::Replicate;
+    manual.affinity = ThreadAffinity::Spread;
+    manual.nodes = 2;
+    manual.replicas = 2;
+    manual.threadCpus = {0, 4, 1, 5};
+    manual.threadsPerNode = {2, 2};
+    EXPECT_EQ("replicate on 2 nodes (2 replicas), spread 4 threads (2+2)", manual.toString());
+}
+
+// Pinning lasts only as long as the guard
+TEST(NumaTopologyTest, AffinityGuardRestoresMask) {
+#if defined(__linux__)
+    cpu_set_t before;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(before), &before));
+    int allowed = 0;
+    while (!CPU_ISSET(allowed, &before)) {
+        ++allowed;
+    }
+    NumaTopology single = NumaTopology::fromCpuLists({std::to_string(allowed)});
+    {
+        ThreadAffinityGuard guard(ThreadAffinity::Compact);
+        PlacementReport report = single.pinThreads(ThreadAffinity::Compact);
+        EXPECT_EQ(allowed, report.threadCpus[0]);
+    }
+    cpu_set_t after;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(after), &after));
+    EXPECT_TRUE(CPU_EQUAL(&before, &after));
+#else
+    GTEST_SKIP() << "Thread affinity is Linux-only";
+#endif
+}
+
+// Every replica holds the same values; a single node shares the original
+TEST(NumaTopologyTest, Replicas) {
+    DataMatrix data = FeatureMatrix::fromRows({{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}});
+
+    NumaTopology single = NumaTopology::fromCpuLists({"0"});
+    NumaReplicas shared(data, single);
+    EXPECT_EQ(0u, shared.replicaCount());
+    EXPECT_EQ(&data, &shared.local());
+
+    // Two nodes on the same CPU so the copies are made on any machine
+    NumaTopology doubled = NumaTopology::fromCpuLists({"0", "0"});
+    NumaReplicas copies(data, doubled);
+    ASSERT_EQ(2u, copies.replicaCount());
+    for (std::size_t n = 0; n < 2; ++n) {
+        const DataMatrix& replica = copies.replica(n);
+        EXPECT_NE(&data, &replica);
+        for (std::size_t i = 0; i < data.rows(); ++i) {
+            for (std::size_t j = 0; j < data.cols(); ++j) {
+                EXPECT_EQ(data.at(i, j), replica.at(i, j));
+                EXPECT_EQ(data.columnData(j)[i], replica.columnData(j)[i]);
+            }
+        }
+    }
+    EXPECT_EQ(&copies.replica(0), &copies.local());
+}
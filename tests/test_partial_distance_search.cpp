@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "feature_selection/partial_distance_search.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+// Test fixture with random features of very different spreads
+class PartialDistanceSearchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(17);
+        std::normal_distribution<double> value(0.0, 1.0);
+        std::vector<std::vector<double>> rows(300, std::vector<double>(20));
+        for (auto& row : rows) {
+            for (std::size_t j = 0; j < row.size(); ++j) {
+                row[j] = value(rng) * static_cast<double>(j % 5 + 1);
+            }
+            labels.push_back(row[4] > 0.0 ? 1 : 2);
+        }
+        // Exact duplicates: ties must go to the lowest index
+        rows[250] = rows[40];
+        rows[299] = rows[40];
+        data = FeatureMatrix::fromRows(rows);
+    }
+    
+    DataMatrix data;
+    LabelVector labels;
+};
+
+// Variances are per column and ordering is descending with index tie-break
+TEST_F(PartialDistanceSearchTest, OrderByVariance) {
+    DataMatrix small = FeatureMatrix::fromRows({
+        {1.0, 0.0, 5.0},
+        {3.0, 0.0, 5.0},
+        {5.0, 4.0, 5.0},
+    });
+    PartialDistanceSearch search(small);
+    ASSERT_EQ(3u, search.variances().size());
+    EXPECT_DOUBLE_EQ(8.0 / 3.0, search.variances()[0]);
+    EXPECT_DOUBLE_EQ(32.0 / 9.0, search.variances()[1]);
+    EXPECT_DOUBLE_EQ(0.0, search.variances()[2]);
+    
+    std::vector<FeatureIndex> features = {0, 1, 2};
+    std::vector<FeatureIndex> ordered;
+    search.orderByVariance(features.data(), features.size(), ordered);
+    EXPECT_EQ(std::vector<FeatureIndex>({1, 0, 2}), ordered);
+}
+
+// Pruned neighbors match the full search, including duplicate-row ties
+TEST_F(PartialDistanceSearchTest, MatchesFindNearestNeighbor) {
+    PartialDistanceSearch search(data);
+    for (const FeatureSet& subset : {FeatureSet({4}), FeatureSet({0, 4, 9}), FeatureSet({1, 2, 3, 5, 7, 11, 13, 17, 19})}) {
+        std::vector<FeatureIndex> features(subset.begin(), subset.end());
+        std::vector<FeatureIndex> ordered;
+        search.orderByVariance(features.data(), features.size(), ordered);
+        for (std::size_t i = 0; i < data.rows(); ++i) {
+            EXPECT_EQ(
+                NearestNeighbor::findNearestNeighbor(data, data[i], i, subset),
+                search.findNearest(data.rowData(i), i, ordered.data(), ordered.size())
+            ) << "row " << i << " subset " << featureSetToString(subset);
+        }
+    }
+    
+    std::vector<FeatureIndex> all(20);
+    for (FeatureIndex f = 0; f < all.size(); ++f) {
+        all[f] = f;
+    }
+    EXPECT_EQ(250u, search.findNearest(data.rowData(40), 40, all.data(), all.size()));
+    EXPECT_EQ(40u, search.findNearest(data.rowData(299), 299, all.data(), all.size()));
+}
+
+// Leave-one-out counts agree and the counters describe the pruning
+TEST_F(PartialDistanceSearchTest, LeaveOneOutAndStats) {
+    PartialDistanceSearch search(data);
+    std::vector<FeatureIndex> features;
+    for (FeatureIndex f = 0; f < data.cols(); ++f) {
+        features.push_back(f);
+    }
+    
+    PruningStats stats;
+    std::size_t correct = search.leaveOneOutCorrect(labels, features.data(), features.size(), &stats);
+    EXPECT_DOUBLE_EQ(
+        NearestNeighbor::leaveOneOutCrossValidation(data, labels),
+        static_cast<double>(correct) / static_cast<double>(data.rows())
+    );
+    
+    const std::uint64_t n = data.rows();
+    EXPECT_EQ(n * (n - 1), stats.candidates);
+    EXPECT_EQ(stats.candidates * features.size(), stats.termsPossible);
+    EXPECT_GT(stats.abandoned, stats.candidates / 2);
+    EXPECT_LT(stats.workFraction(), 1.0);
+    EXPECT_GT(stats.abandonRate(), 0.5);
+}
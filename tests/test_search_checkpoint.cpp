@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "feature_selection/search_checkpoint.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+DataMatrix smallData() {
+    return FeatureMatrix::fromRows({
+        {1.0, 0.5, 3.0}, {1.5, 0.0, 2.0}, {4.0, 2.5, 0.5}, {4.5, 3.0, 1.0}, {2.0, 1.0, 2.5}
+    });
+}
+
+const LabelVector kLabels = {1, 1, 2, 2, 1};
+
+SearchCheckpoint sampleCheckpoint(const DataMatrix& data) {
+    SearchCheckpoint checkpoint;
+    checkpoint.direction = SearchDirection::Backward;
+    checkpoint.rows = data.rows();
+    checkpoint.cols = data.cols();
+    checkpoint.datasetHash = SearchCheckpoint::hashDataset(data, kLabels);
+    checkpoint.levelsCompleted = 1;
+    checkpoint.current = {0, 2};
+    checkpoint.bestFeatureSet = {0, 2};
+    checkpoint.bestAccuracy = 0.8;
+    checkpoint.allResults = {{{0, 1, 2}, 0.6}, {{0, 2}, 0.8}};
+    return checkpoint;
+}
+
+std::string tempPath(const std::string& name) {
+    return ::testing::TempDir() + name;
+}
+
+} // namespace
+
+// The search state survives a write and read unchanged
+TEST(SearchCheckpointTest, RoundTrip) {
+    DataMatrix data = smallData();
+    SearchCheckpoint written = sampleCheckpoint(data);
+    const std::string path = tempPath("round_trip.ckpt");
+    written.write(path);
+
+    SearchCheckpoint read = SearchCheckpoint::read(path);
+    EXPECT_EQ(SearchDirection::Backward, read.direction);
+    EXPECT_EQ(data.rows(), read.rows);
+    EXPECT_EQ(data.cols(), read.cols);
+    EXPECT_EQ(written.datasetHash, read.datasetHash);
+    EXPECT_EQ(1u, read.levelsCompleted);
+    EXPECT_EQ(written.current, read.current);
+    EXPECT_EQ(written.bestFeatureSet, read.bestFeatureSet);
+    EXPECT_EQ(written.bestAccuracy, read.bestAccuracy);
+    EXPECT_EQ(written.allResults, read.allResults);
+    EXPECT_FALSE(read.hasCache);
+
+    DistanceCache cache(data, kLabels);
+    EXPECT_FALSE(read.restoreCache(cache));
+    std::remove(path.c_str());
+}
+
+// A restored cache holds the same distances and keeps updating exactly
+TEST(SearchCheckpointTest, CacheRoundTrip) {
+    DataMatrix data = smallData();
+    DistanceCache original(data, kLabels);
+    original.reset({0, 1, 2});
+    original.commitRemoval(1);
+
+    const std::string path = tempPath("cache.ckpt");
+    sampleCheckpoint(data).write(path, &original);
+
+    SearchCheckpoint read = SearchCheckpoint::read(path);
+    ASSERT_TRUE(read.hasCache);
+    DistanceCache restored(data, kLabels);
+    ASSERT_TRUE(read.restoreCache(restored));
+    EXPECT_EQ(original.features(), restored.features());
+    EXPECT_EQ(original.distances(), restored.distances());
+    EXPECT_EQ(original.removalsSinceRefresh(), restored.removalsSinceRefresh());
+    EXPECT_EQ(original.evaluateRemovals({0, 2}), restored.evaluateRemovals({0, 2}));
+    EXPECT_EQ(original.evaluateAdditions({1}), restored.evaluateAdditions({1}));
+    std::remove(path.c_str());
+}
+
+// Flipped bytes, truncation and missing files are rejected
+TEST(SearchCheckpointTest, RejectsDamagedFiles) {
+    DataMatrix data = smallData();
+    DistanceCache cache(data, kLabels);
+    cache.reset({0, 2});
+    const std::string path = tempPath("damaged.ckpt");
+    sampleCheckpoint(data).write(path, &cache);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    auto rewrite = [&](const std::vector<char>& contents) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    };
+
+    const std::size_t header = sizeof(SearchCheckpoint::Header);
+    for (std::size_t offset : {std::size_t(0), std::size_t(40), header + 8, bytes.size() - 1}) {
+        std::vector<char> corrupted = bytes;
+        corrupted[offset] ^= 0x5a;
+        rewrite(corrupted);
+        EXPECT_THROW(SearchCheckpoint::read(path), std::runtime_error) << "offset " << offset;
+    }
+
+    rewrite(std::vector<char>(bytes.begin(), bytes.end() - 8));
+    EXPECT_THROW(SearchCheckpoint::read(path), std::runtime_error);
+
+    std::remove(path.c_str());
+    EXPECT_THROW(SearchCheckpoint::read(path), std::runtime_error);
+}
+
+// Any change to a value or a label changes the dataset hash
+TEST(SearchCheckpointTest, DatasetHash) {
+    DataMatrix data = smallData();
+    const std::uint64_t hash = SearchCheckpoint::hashDataset(data, kLabels);
+    EXPECT_EQ(hash, SearchCheckpoint::hashDataset(smallData(), kLabels));
+
+    DataMatrix changed = FeatureMatrix::fromRows({
+        {1.0, 0.5, 3.0}, {1.5, 0.0, 2.0}, {4.0, 2.5, 0.5}, {4.5, 3.0, 1.0}, {2.0, 1.0, 2.25}
+    });
+    EXPECT_NE(hash, SearchCheckpoint::hashDataset(changed, kLabels));
+    EXPECT_NE(hash, SearchCheckpoint::hashDataset(data, {1, 1, 2, 2, 2}));
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "feature_selection/sorted_sweep.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+// Row-at-a-time reference neighbors over one feature
+std::vector<std::size_t> bruteForce(const DataMatrix& data, FeatureIndex feature) {
+    std::vector<std::size_t> nearest(data.rows());
+    for (std::size_t i = 0; i < data.rows(); ++i) {
+        nearest[i] = NearestNeighbor::findNearestNeighbor(data, data[i], i, {feature});
+    }
+    return nearest;
+}
+
+} // namespace
+
+// Hand-checked neighbors, including equal gaps on both sides
+TEST(SortedSweepTest, SmallColumn) {
+    std::vector<double> column = {5.0, 1.0, 3.0, 3.0, 7.0, 9.0};
+    std::vector<std::size_t> nearest;
+    SortedSweep::findAllNearest(column.data(), column.size(), nearest);
+    
+    // Row 0 (5.0) is 2 away from rows 2, 3 (3.0) and row 4 (7.0): lowest is 2
+    EXPECT_EQ(std::vector<std::size_t>({2, 2, 3, 2, 0, 4}), nearest);
+}
+
+// Degenerate sizes behave like the brute-force search
+TEST(SortedSweepTest, DegenerateSizes) {
+    std::vector<std::size_t> nearest;
+    std::vector<double> one = {4.0};
+    SortedSweep::findAllNearest(one.data(), 1, nearest);
+    EXPECT_EQ(std::vector<std::size_t>({0}), nearest);
+    
+    std::vector<double> same = {2.0, 2.0, 2.0};
+    SortedSweep::findAllNearest(same.data(), 3, nearest);
+    EXPECT_EQ(std::vector<std::size_t>({1, 0, 0}), nearest);
+}
+
+// Random continuous and heavily tied columns match findNearestNeighbor
+TEST(SortedSweepTest, MatchesFindNearestNeighbor) {
+    std::mt19937 rng(4);
+    std::normal_distribution<double> value(0.0, 1.0);
+    std::vector<std::vector<double>> rows(400, std::vector<double>(3));
+    for (auto& row : rows) {
+        row[0] = value(rng);
+        row[1] = std::round(value(rng) * 2.0);
+        row[2] = std::round(value(rng) * 8.0) / 4.0;
+    }
+    DataMatrix data = FeatureMatrix::fromRows(rows);
+    
+    for (FeatureIndex f = 0; f < data.cols(); ++f) {
+        std::vector<std::size_t> nearest;
+        SortedSweep::findAllNearest(data.columnData(f), data.rows(), nearest);
+        EXPECT_EQ(bruteForce(data, f), nearest) << "feature " << f;
+    }
+}
+
+// Batch evaluation agrees with single-feature LOOCV
+TEST(SortedSweepTest, EvaluateFeatures) {
+    std::mt19937 rng(8);
+    std::normal_distribution<double> value(0.0, 1.0);
+    std::vector<std::vector<double>> rows(300, std::vector<double>(5));
+    LabelVector labels;
+    for (auto& row : rows) {
+        for (auto& v : row) {
+            v = std::round(value(rng) * 3.0);
+        }
+        labels.push_back(row[1] > 0.0 ? 1 : 2);
+    }
+    DataMatrix data = FeatureMatrix::fromRows(rows);
+    
+    std::vector<FeatureIndex> features = {4, 0, 1, 3};
+    auto correct = SortedSweep::evaluateFeatures(data, labels, features);
+    ASSERT_EQ(features.size(), correct.size());
+    for (std::size_t c = 0; c < features.size(); ++c) {
+        std::size_t expected = 0;
+        auto nearest = bruteForce(data, features[c]);
+        for (std::size_t i = 0; i < data.rows(); ++i) {
+            expected += labels[i] == labels[nearest[i]] ? 1 : 0;
+        }
+        EXPECT_EQ(expected, correct[c]) << "feature " << features[c];
+        EXPECT_EQ(expected, SortedSweep::countCorrect(data.columnData(features[c]), labels));
+        
+        // Row blocks over one sweep's neighbors add up to the same count
+        std::vector<std::size_t> swept;
+        SortedSweep::findAllNearest(data.columnData(features[c]), data.rows(), swept);
+        EXPECT_EQ(expected, SortedSweep::countCorrect(swept, labels, 0, 100) +
+                            SortedSweep::countCorrect(swept, labels, 100, data.rows()));
+    }
+}
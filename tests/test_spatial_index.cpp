@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "feature_selection/spatial_index.h"
+#include "feature_selection/nearest_neighbor.h"
+#include "feature_selection/tiled_nearest_neighbor.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+// Random matrix; with `levels` > 0 values are rounded to that many integer
+// steps so that many rows tie exactly
+DataMatrix randomMatrix(std::size_t rows, std::size_t cols, unsigned seed, int levels = 0) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> value(0.0, 1.0);
+    std::vector<std::vector<double>> data(rows, std::vector<double>(cols));
+    for (auto& row : data) {
+        for (auto& v : row) {
+            v = value(rng);
+            if (levels > 0) {
+                v = std::round(v * levels / 3.0);
+            }
+        }
+    }
+    return FeatureMatrix::fromRows(data);
+}
+
+void expectMatchesBruteForce(const DataMatrix& data, const std::vector<FeatureIndex>& features) {
+    std::vector<std::size_t> expected;
+    TiledNearestNeighbor::findAllNearest(
+        TiledNearestNeighbor::columns(data), data.rows(), features.data(), features.size(), expected
+    );
+    
+    for (NeighborStrategy strategy : {NeighborStrategy::KDTree, NeighborStrategy::BallTree}) {
+        auto index = SpatialIndex::build(strategy, data, features.data(), features.size());
+        ASSERT_TRUE(index);
+        EXPECT_EQ(data.rows(), index->rows());
+        EXPECT_EQ(features.size(), index->dimensions());
+        
+        std::vector<std::size_t> nearest;
+        index->findAllNearest(nearest);
+        EXPECT_EQ(expected, nearest) << SpatialIndex::strategyName(strategy) << " k=" << features.size();
+    }
+}
+
+} // namespace
+
+// Trees return exactly the brute-force neighbors for continuous data
+TEST(SpatialIndexTest, MatchesBruteForce) {
+    DataMatrix data = randomMatrix(1500, 6, 3);
+    expectMatchesBruteForce(data, {2});
+    expectMatchesBruteForce(data, {0, 5});
+    expectMatchesBruteForce(data, {1, 3, 4});
+    expectMatchesBruteForce(data, {0, 1, 2, 3, 4});
+}
+
+// Heavily tied discrete data still resolves ties to the lowest index
+TEST(SpatialIndexTest, TiesGoToLowestIndex) {
+    DataMatrix data = randomMatrix(1200, 3, 9, 4);
+    expectMatchesBruteForce(data, {0});
+    expectMatchesBruteForce(data, {0, 2});
+    expectMatchesBruteForce(data, {0, 1, 2});
+}
+
+// Tiny inputs: a single row has no neighbor and falls back to row 0
+TEST(SpatialIndexTest, DegenerateSizes) {
+    DataMatrix one = randomMatrix(1, 2, 1);
+    std::vector<FeatureIndex> features = {0, 1};
+    KDTree kd(one, features.data(), features.size());
+    BallTree ball(one, features.data(), features.size());
+    EXPECT_EQ(0u, kd.nearest(one.rowData(0), 0));
+    EXPECT_EQ(0u, ball.nearest(one.rowData(0), 0));
+    
+    DataMatrix two = randomMatrix(2, 2, 1);
+    KDTree kdTwo(two, features.data(), features.size());
+    EXPECT_EQ(1u, kdTwo.nearest(two.rowData(0), 0));
+    EXPECT_EQ(0u, kdTwo.nearest(two.rowData(1), 1));
+}
+
+// The cost model keeps brute force for small or wide problems
+TEST(SpatialIndexTest, ChooseStrategy) {
+    EXPECT_EQ(NeighborStrategy::BruteForce, SpatialIndex::chooseStrategy(100, 2));
+    EXPECT_EQ(NeighborStrategy::BruteForce, SpatialIndex::chooseStrategy(100000, 0));
+    EXPECT_EQ(NeighborStrategy::BruteForce, SpatialIndex::chooseStrategy(100000, 40));
+    EXPECT_EQ(NeighborStrategy::BruteForce, SpatialIndex::chooseStrategy(2000, 14));
+    EXPECT_EQ(NeighborStrategy::KDTree, SpatialIndex::chooseStrategy(100000, 1));
+    EXPECT_EQ(NeighborStrategy::KDTree, SpatialIndex::chooseStrategy(100000, 3));
+    EXPECT_EQ(NeighborStrategy::BallTree, SpatialIndex::chooseStrategy(100000, 10));
+}
+
+// Leave-one-out picks a tree automatically and gives the brute-force answer
+TEST(SpatialIndexTest, LeaveOneOutUsesIndex) {
+    const std::size_t rows = 3000;
+    DataMatrix data = randomMatrix(rows, 4, 21);
+    LabelVector labels(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        labels[i] = data.at(i, 0) + data.at(i, 2) > 0.0 ? 1 : 2;
+    }
+    ASSERT_NE(NeighborStrategy::BruteForce, SpatialIndex::chooseStrategy(rows, 2));
+    
+    std::vector<FeatureIndex> features = {0, 2};
+    std::size_t expected = TiledNearestNeighbor::countCorrect(
+        TiledNearestNeighbor::columns(data), labels, features.data(), features.size()
+    );
+    EXPECT_EQ(expected, NearestNeighbor::leaveOneOutCorrect(data, labels, features.data(), features.size()));
+    EXPECT_DOUBLE_EQ(
+        static_cast<double>(expected) / rows,
+        NearestNeighbor::leaveOneOutCrossValidation(data, labels, {0, 2})
+    );
+}
+
+// Row blocks of one index add up to the whole count
+TEST(SpatialIndexTest, RowRangesAddUp) {
+    const std::size_t rows = 1000;
+    DataMatrix data = randomMatrix(rows, 3, 34, 4);
+    LabelVector labels(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        labels[i] = data.at(i, 1) > 0.0 ? 1 : 2;
+    }
+    
+    std::vector<FeatureIndex> features = {0, 1, 2};
+    for (NeighborStrategy strategy : {NeighborStrategy::KDTree, NeighborStrategy::BallTree}) {
+        auto index = SpatialIndex::build(strategy, data, features.data(), features.size());
+        std::size_t blocks = 0;
+        for (std::size_t begin = 0; begin < rows; begin += 192) {
+            blocks += index->countCorrect(labels, begin, std::min(rows, begin + 192));
+        }
+        EXPECT_EQ(index->countCorrect(labels), blocks) << SpatialIndex::strategyName(strategy);
+        EXPECT_EQ(0u, index->countCorrect(labels, 10, 10));
+    }
+}
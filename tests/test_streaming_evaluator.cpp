@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "feature_selection/streaming_evaluator.h"
+#include "feature_selection/feature_selection.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+// Test fixture with a random dataset written to a binary file
+class StreamingEvaluatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(7);
+        std::normal_distribution<double> value(0.0, 1.0);
+        std::vector<std::vector<double>> rows(700, std::vector<double>(11));
+        for (auto& row : rows) {
+            for (auto& v : row) {
+                v = value(rng);
+            }
+            labels.push_back(row[3] - row[8] > 0.0 ? 1 : 2);
+        }
+        // Duplicate rows make exact ties that must resolve to the lowest index
+        rows[500] = rows[20];
+        rows[650] = rows[20];
+        labels[650] = labels[20] == 1 ? 2 : 1;
+        data = FeatureMatrix::fromRows(rows);
+        
+        path = ::testing::TempDir() + "fs_streaming.fsbin";
+        BinaryDataset::write(path, data, labels);
+    }
+    
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+    
+    DataMatrix data;
+    LabelVector labels;
+    std::string path;
+};
+
+// Streaming over many small blocks gives exactly the in-memory accuracy
+TEST_F(StreamingEvaluatorTest, MatchesInMemoryLeaveOneOut) {
+    BinaryDataset dataset(path);
+    
+    // A budget this small forces the minimum block size and many passes
+    StreamingEvaluator evaluator(dataset, 1024);
+    EXPECT_EQ(64u, evaluator.blockRows(3));
+    EXPECT_EQ(labels, evaluator.labels());
+    
+    for (const FeatureSet& subset : {FeatureSet(), FeatureSet({3}), FeatureSet({3, 8}), FeatureSet({0, 1, 2, 5, 9, 10})}) {
+        EXPECT_DOUBLE_EQ(
+            NearestNeighbor::leaveOneOutCrossValidation(data, labels, subset),
+            evaluator.leaveOneOutCrossValidation(subset)
+        ) << featureSetToString(subset);
+    }
+    
+    // A budget large enough for a single block gives the same answer
+    StreamingEvaluator singleBlock(dataset);
+    EXPECT_EQ(data.rows(), singleBlock.blockRows(2));
+    EXPECT_DOUBLE_EQ(
+        NearestNeighbor::leaveOneOutCrossValidation(data, labels, {3, 8}),
+        singleBlock.leaveOneOutCrossValidation({3, 8})
+    );
+}
+
+// Row ranges add up to the whole count, whatever the block size
+TEST_F(StreamingEvaluatorTest, RowRangesAddUp) {
+    BinaryDataset dataset(path);
+    StreamingEvaluator evaluator(dataset, 4096);
+    const std::vector<FeatureIndex> features = {0, 3, 8};
+    
+    const std::size_t whole = evaluator.leaveOneOutCorrect(features.data(), features.size());
+    std::size_t ranges = 0;
+    for (std::size_t begin = 0; begin < data.rows(); begin += 97) {
+        ranges += evaluator.leaveOneOutCorrect(features.data(), features.size(), begin, begin + 97);
+    }
+    EXPECT_EQ(whole, ranges);
+}
+
+// Streamed searches follow the same trace as the in-memory ones
+TEST_F(StreamingEvaluatorTest, StreamedSearchesMatchInMemory) {
+    BinaryDataset dataset(path);
+    StreamingEvaluator evaluator(dataset, 8192);
+    SearchOptions options;
+    options.maxLevels = 4;
+    
+    for (bool earlyTermination : {false, true}) {
+        options.earlyTermination = earlyTermination;
+        SearchResult streamed = FeatureSelection::forwardSelection(evaluator, false, options);
+        SearchResult loaded = FeatureSelection::forwardSelection(data, labels, false, options);
+        ASSERT_EQ(loaded.allResults.size(), streamed.allResults.size());
+        for (std::size_t i = 0; i < loaded.allResults.size(); ++i) {
+            EXPECT_EQ(loaded.allResults[i].first, streamed.allResults[i].first);
+            EXPECT_DOUBLE_EQ(loaded.allResults[i].second, streamed.allResults[i].second);
+        }
+        EXPECT_EQ(loaded.bestFeatureSet, streamed.bestFeatureSet);
+    }
+    
+    options = SearchOptions();
+    SearchResult streamed = FeatureSelection::backwardElimination(evaluator, false, options);
+    SearchResult loaded = FeatureSelection::backwardElimination(data, labels, false, options);
+    ASSERT_EQ(loaded.allResults.size(), streamed.allResults.size());
+    for (std::size_t i = 0; i < loaded.allResults.size(); ++i) {
+        EXPECT_EQ(loaded.allResults[i].first, streamed.allResults[i].first);
+        EXPECT_DOUBLE_EQ(loaded.allResults[i].second, streamed.allResults[i].second);
+    }
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "feature_selection/successive_halving.h"
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+DataMatrix gridData(std::size_t rows) {
+    std::vector<std::vector<double>> values(rows, std::vector<double>(3));
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            values[i][j] = static_cast<double>((i * 13 + j * 5) % 17);
+        }
+    }
+    return FeatureMatrix::fromRows(values);
+}
+
+LabelVector alternatingLabels(std::size_t rows) {
+    LabelVector labels(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        labels[i] = (i % 2 == 0) ? 1 : 2;
+    }
+    return labels;
+}
+
+} // namespace
+
+// Samples double every round and stop short of the full dataset
+TEST(SuccessiveHalvingTest, RoundSizes) {
+    DataMatrix data = gridData(100);
+    LabelVector labels = alternatingLabels(100);
+    
+    SuccessiveHalving halving(data, labels, 12, 0.5, 2, 3);
+    ASSERT_EQ(4u, halving.roundCount());
+    const std::size_t expected[] = {12, 24, 48, 96};
+    for (std::size_t r = 0; r < halving.roundCount(); ++r) {
+        EXPECT_EQ(expected[r], halving.round(r).sampleRows());
+        EXPECT_EQ(expected[r], halving.round(r).sample().rows());
+        EXPECT_EQ(expected[r], halving.round(r).labels().size());
+    }
+    
+    EXPECT_EQ(0u, SuccessiveHalving(data, labels, 100, 0.5, 2, 3).roundCount());
+    EXPECT_EQ(1u, SuccessiveHalving(data, labels, 50, 0.5, 2, 3).roundCount());
+}
+
+// Survivors round up and never fall below the finalists
+TEST(SuccessiveHalvingTest, Survivors) {
+    DataMatrix data = gridData(40);
+    LabelVector labels = alternatingLabels(40);
+    
+    SuccessiveHalving halving(data, labels, 10, 0.5, 3, 1);
+    EXPECT_EQ(3u, halving.finalists());
+    EXPECT_EQ(10u, halving.survivors(20));
+    EXPECT_EQ(6u, halving.survivors(11));
+    EXPECT_EQ(3u, halving.survivors(5));
+    EXPECT_EQ(2u, halving.survivors(2));
+    
+    EXPECT_EQ(1u, SuccessiveHalving(data, labels, 10, 0.25, 0, 1).finalists());
+    EXPECT_EQ(0u, SuccessiveHalving::distanceComputations(1));
+    EXPECT_EQ(90u, SuccessiveHalving::distanceComputations(10));
+}
+
+// Halving counts against every candidate scored on every row
+TEST(SuccessiveHalvingTest, SavedFraction) {
+    HalvingStats stats;
+    EXPECT_DOUBLE_EQ(0.0, stats.savedFraction());
+    stats.distanceComputations = 25;
+    stats.distanceComputationsFull = 100;
+    EXPECT_DOUBLE_EQ(0.75, stats.savedFraction());
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "feature_selection/tiled_nearest_neighbor.h"
+#include "feature_selection/nearest_neighbor.h"
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+namespace {
+
+// Random matrix with a few exact duplicate rows to create ties
+DataMatrix randomMatrix(std::size_t rows, std::size_t cols, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> value(0.0, 1.0);
+    std::vector<std::vector<double>> data(rows, std::vector<double>(cols));
+    for (auto& row : data) {
+        for (auto& v : row) {
+            v = value(rng);
+        }
+    }
+    if (rows > 10) {
+        data[rows - 1] = data[3];
+        data[rows / 2] = data[3];
+    }
+    return FeatureMatrix::fromRows(data);
+}
+
+} // namespace
+
+// Tile sizes shrink as the feature count grows
+TEST(TiledNearestNeighborTest, ReferenceTileRows) {
+    for (std::size_t k : {1u, 8u, 100u, 1000u, 100000u}) {
+        std::size_t rows = TiledNearestNeighbor::referenceTileRows(k);
+        EXPECT_GE(rows, 64u);
+        EXPECT_LE(rows, 2048u);
+        EXPECT_EQ(0u, rows % FeatureMatrix::kPadding);
+    }
+    EXPECT_GE(TiledNearestNeighbor::referenceTileRows(1), TiledNearestNeighbor::referenceTileRows(1000));
+}
+
+// Every row's neighbor matches the row-at-a-time search, ties included,
+// for sizes that do and do not fill whole query and reference tiles
+TEST(TiledNearestNeighborTest, MatchesFindNearestNeighbor) {
+    for (std::size_t rows : {2u, 63u, 64u, 65u, 300u, 1100u}) {
+        DataMatrix data = randomMatrix(rows, 6, static_cast<unsigned>(rows));
+        for (const FeatureSet& subset : {FeatureSet({0, 1, 2, 3, 4, 5}), FeatureSet({4}), FeatureSet({1, 3})}) {
+            std::vector<FeatureIndex> features(subset.begin(), subset.end());
+            std::vector<std::size_t> nearest;
+            TiledNearestNeighbor::findAllNearest(
+                TiledNearestNeighbor::columns(data), rows, features.data(), features.size(), nearest
+            );
+            ASSERT_EQ(rows, nearest.size());
+            for (std::size_t i = 0; i < rows; ++i) {
+                EXPECT_EQ(NearestNeighbor::findNearestNeighbor(data, data[i], i, subset), nearest[i])
+                    << "rows " << rows << " row " << i << " subset " << featureSetToString(subset);
+            }
+        }
+    }
+}
+
+// Duplicate rows resolve to the lowest other index
+TEST(TiledNearestNeighborTest, TiesGoToLowestIndex) {
+    DataMatrix data = randomMatrix(200, 3, 11);
+    std::vector<std::size_t> nearest;
+    TiledNearestNeighbor::findAllNearest(TiledNearestNeighbor::columns(data), 200, nullptr, 3, nearest);
+    EXPECT_EQ(100u, nearest[3]);
+    EXPECT_EQ(3u, nearest[100]);
+    EXPECT_EQ(3u, nearest[199]);
+}
+
+// Splitting the reference range across calls gives the same running minima
+TEST(TiledNearestNeighborTest, UpdateNearestAcrossReferenceBlocks) {
+    const std::size_t rows = 2100;
+    DataMatrix data = randomMatrix(rows, 2, 5);
+    auto source = TiledNearestNeighbor::columns(data);
+    
+    std::vector<std::size_t> whole;
+    TiledNearestNeighbor::findAllNearest(source, rows, nullptr, 2, whole);
+    
+    std::vector<double> bestDistance(rows, std::numeric_limits<double>::max());
+    std::vector<std::size_t> bestIndex(rows, 0);
+    for (std::size_t r0 = 0; r0 < rows; r0 += 777) {
+        std::size_t r1 = std::min(rows, r0 + 777);
+        TiledNearestNeighbor::updateNearest(source, nullptr, 2, 0, rows, r0, r1, bestDistance.data(), bestIndex.data());
+    }
+    EXPECT_EQ(whole, bestIndex);
+}
+
+// Counting agrees with the neighbor list and with the public LOOCV
+TEST(TiledNearestNeighborTest, CountCorrect) {
+    const std::size_t rows = 400;
+    DataMatrix data = randomMatrix(rows, 4, 3);
+    LabelVector labels(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+        labels[i] = data.at(i, 1) > 0.0 ? 1 : 2;
+    }
+    
+    std::vector<FeatureIndex> features = {1, 2};
+    auto source = TiledNearestNeighbor::columns(data);
+    std::vector<std::size_t> nearest;
+    TiledNearestNeighbor::findAllNearest(source, rows, features.data(), features.size(), nearest);
+    
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < rows; ++i) {
+        expected += labels[i] == labels[nearest[i]] ? 1 : 0;
+    }
+    EXPECT_EQ(expected, TiledNearestNeighbor::countCorrect(source, labels, features.data(), features.size()));
+    EXPECT_DOUBLE_EQ(
+        static_cast<double>(expected) / rows,
+        NearestNeighbor::leaveOneOutCrossValidation(data, labels, {1, 2})
+    );
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "feature_selection/work_scheduler.h"
+#include "feature_selection/compact_matrix.h"
+#include "feature_selection/partial_distance_search.h"
+#include "feature_selection/tiled_nearest_neighbor.h"
+#include <random>
+#include <vector>
+
+using namespace feature_selection;
+
+// Few tasks are split into kMinBlockRows multiples; many tasks are not split
+TEST(WorkSchedulerTest, BlockRows) {
+    // 3 tasks on 8 threads want 32 units: 11 blocks of 1000 rows -> 91 -> 128
+    EXPECT_EQ(128u, WorkScheduler::blockRows(3, 1000, 8));
+    EXPECT_EQ(8u, WorkScheduler::blockCount(1000, 128));
+
+    // Enough tasks already
+    EXPECT_EQ(1000u, WorkScheduler::blockRows(32, 1000, 8));
+    EXPECT_EQ(1000u, WorkScheduler::blockRows(3000, 1000, 8));
+
+    // Never below one minimum block, even for tiny datasets
+    EXPECT_EQ(WorkScheduler::kMinBlockRows, WorkScheduler::blockRows(1, 10, 64));
+    EXPECT_EQ(1u, WorkScheduler::blockCount(10, WorkScheduler::kMinBlockRows));
+
+    // Degenerate inputs
+    EXPECT_EQ(1u, WorkScheduler::blockRows(0, 0, 8));
+    EXPECT_EQ(0u, WorkScheduler::blockCount(0, 1));
+}
+
+// Every (task, row) pair is visited exactly once
+TEST(WorkSchedulerTest, RunCoversEveryUnitOnce) {
+    const std::size_t tasks = 5;
+    const std::size_t rows = 1000;
+    for (std::size_t blockRows : {std::size_t(64), std::size_t(300), rows}) {
+        std::vector<int> visits(tasks * rows, 0);
+        WorkScheduler::run(tasks, rows, blockRows, [&](std::size_t task, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                #pragma omp atomic
+                visits[task * rows + i]++;
+            }
+        });
+        for (int count : visits) {
+            ASSERT_EQ(1, count);
+        }
+    }
+}
+
+// Row-range counts add up to the whole-dataset count for every engine
+TEST(WorkSchedulerTest, RangeCountsSumToFullCount) {
+    std::mt19937 rng(9);
+    std::normal_distribution<double> value(0.0, 1.0);
+    std::vector<std::vector<double>> rows(700, std::vector<double>(6));
+    LabelVector labels;
+    for (auto& row : rows) {
+        for (double& x : row) {
+            x = value(rng);
+        }
+        labels.push_back(row[0] + row[3] > 0.0 ? 1 : 2);
+    }
+    rows[600] = rows[12];
+    DataMatrix data = FeatureMatrix::fromRows(rows);
+    CompactMatrix compact(data, StoragePrecision::Int16);
+    PartialDistanceSearch pruned(data);
+
+    const std::vector<FeatureIndex> features = {0, 2, 3, 5};
+    auto source = TiledNearestNeighbor::columns(data);
+    const std::size_t blockRows = WorkScheduler::blockRows(1, data.size(), 4);
+
+    std::size_t tiled = 0, packed = 0, abandoned = 0;
+    for (std::size_t begin = 0; begin < data.size(); begin += blockRows) {
+        std::size_t end = std::min(data.size(), begin + blockRows);
+        tiled += TiledNearestNeighbor::countCorrect(source, labels, features.data(), features.size(), begin, end);
+        packed += compact.leaveOneOutCorrect(labels, features.data(), features.size(), begin, end);
+        abandoned += pruned.leaveOneOutCorrect(labels, features.data(), features.size(), begin, end);
+    }
+
+    EXPECT_EQ(TiledNearestNeighbor::countCorrect(source, labels, features.data(), features.size()), tiled);
+    EXPECT_EQ(compact.leaveOneOutCorrect(labels, features.data(), features.size()), packed);
+    EXPECT_EQ(pruned.leaveOneOutCorrect(labels, features.data(), features.size()), abandoned);
+}